@@ -0,0 +1,438 @@
+/**
+ * \file   bench_Repository.cc
+ * \date   Created on October 14, 2026
+ * \brief  Benchmarks for the hot paths of the Repository class.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/*
+ * Usage: libgit4cpp_bench [--files=N] [--depth=N] [--fanout=N] [--history=N]
+ *                         [--repetitions=N] [--modified=PERCENT] [--dir=PATH]
+ *                         [--filter=SUBSTRING] [--format=json|csv]
+ *
+ * A synthetic repository with the requested number of files spread over a directory tree
+ * of the given depth and fan-out is generated in PATH, together with a history of the
+ * requested length. PATH must be empty, nonexistent, or a repository generated by an
+ * earlier run, which is then replaced. Each benchmarked operation is then run several
+ * times and the timings are printed to stdout, either as a single JSON document or as
+ * CSV with a header line. Progress information goes to stderr.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <git2.h>
+#include <gul14/cat.h>
+
+#include "libgit4cpp/Repository.h"
+
+using gul14::cat;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Config
+{
+    std::size_t files = 1000;
+    std::size_t depth = 3;
+    std::size_t fanout = 8;
+    std::size_t history = 20;
+    std::size_t repetitions = 5;
+    std::size_t modified_percent = 10;
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "libgit4cpp_bench";
+    std::string filter;
+    std::string format = "json";
+};
+
+struct Result
+{
+    std::string name;
+    std::size_t items;            // Number of items (files, commits) processed per run
+    std::vector<double> times_us; // Duration of each run in microseconds
+};
+
+std::size_t parse_number(const std::string& arg, const std::string& value)
+{
+    std::size_t pos = 0;
+    const auto number = std::stoul(value, &pos);
+    if (pos != value.size())
+        throw std::invalid_argument(cat("Invalid number in argument ", arg));
+    return number;
+}
+
+Config parse_args(int argc, char* argv[])
+{
+    Config cfg;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const auto eq = arg.find('=');
+        const auto key = arg.substr(0, eq);
+        const auto value = eq == std::string::npos ? std::string{ } : arg.substr(eq + 1);
+
+        if (key == "--files")
+            cfg.files = parse_number(arg, value);
+        else if (key == "--depth")
+            cfg.depth = parse_number(arg, value);
+        else if (key == "--fanout")
+            cfg.fanout = std::max<std::size_t>(1, parse_number(arg, value));
+        else if (key == "--history")
+            cfg.history = parse_number(arg, value);
+        else if (key == "--repetitions")
+            cfg.repetitions = std::max<std::size_t>(1, parse_number(arg, value));
+        else if (key == "--modified")
+            cfg.modified_percent = std::min<std::size_t>(100, parse_number(arg, value));
+        else if (key == "--dir")
+            cfg.dir = value;
+        else if (key == "--filter")
+            cfg.filter = value;
+        else if (key == "--format" && (value == "json" || value == "csv"))
+            cfg.format = value;
+        else
+            throw std::invalid_argument(cat("Unknown argument ", arg));
+    }
+
+    if (cfg.files == 0)
+        throw std::invalid_argument("At least one file is required");
+
+    return cfg;
+}
+
+// Return the relative path of the file with the given number. Files are distributed
+// round-robin over a directory tree with the configured depth and fan-out.
+std::string file_path(const Config& cfg, std::size_t idx)
+{
+    std::string path;
+    std::size_t rest = idx;
+    for (std::size_t level = 0; level != cfg.depth; ++level)
+    {
+        path += cat("dir", rest % cfg.fanout, '/');
+        rest /= cfg.fanout;
+    }
+    return cat(path, "file", idx, ".txt");
+}
+
+std::string file_content(std::size_t idx, std::size_t version)
+{
+    return cat("File ", idx, ", version ", version, "\n",
+        std::string(64 + idx % 256, static_cast<char>('a' + idx % 26)), "\n");
+}
+
+// Return the indices of the files that are modified by one step of the benchmark.
+std::vector<std::size_t> modified_files(const Config& cfg, std::size_t step)
+{
+    const auto nr = std::max<std::size_t>(1, cfg.files * cfg.modified_percent / 100);
+    std::vector<std::size_t> indices;
+    indices.reserve(nr);
+    for (std::size_t i = 0; i != nr; ++i)
+        indices.push_back((step * 7919 + i * (cfg.files / nr)) % cfg.files);
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+    return indices;
+}
+
+void write_file(const std::filesystem::path& path, const std::string& content)
+{
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream f{ path, std::ios::binary | std::ios::trunc };
+    f << content;
+    if (not f)
+        throw std::runtime_error(cat("Cannot write ", path.string()));
+}
+
+void modify_work_tree(const Config& cfg, std::size_t step)
+{
+    for (auto idx : modified_files(cfg, step))
+        write_file(cfg.dir / file_path(cfg, idx), file_content(idx, step));
+}
+
+git::TreeChanges tree_changes(const Config& cfg, std::size_t step)
+{
+    git::TreeChanges changes;
+    for (auto idx : modified_files(cfg, step))
+        changes.emplace(file_path(cfg, idx), file_content(idx, step));
+    return changes;
+}
+
+// Name of the file that marks a repository generated by the benchmark. It lives in the
+// .git directory so that it does not show up in the status of the work tree.
+const char* const marker_file = "libgit4cpp_bench";
+
+// Delete the directory of a previous benchmark run. A directory that is neither empty nor
+// marked as generated by the benchmark is never touched, so that a mistyped --dir cannot
+// wipe unrelated data.
+void remove_old_repository(const std::filesystem::path& dir)
+{
+    std::error_code ec;
+    if (not std::filesystem::exists(dir, ec) || std::filesystem::is_empty(dir, ec))
+        return;
+
+    if (not std::filesystem::is_regular_file(dir / ".git" / marker_file, ec))
+    {
+        throw std::runtime_error(cat("Refusing to delete ", dir.string(),
+            ": It is not empty and was not created by this benchmark"));
+    }
+
+    std::filesystem::remove_all(dir);
+}
+
+void generate_repository(const Config& cfg)
+{
+    std::cerr << "Generating repository with " << cfg.files << " files and "
+        << cfg.history << " commits in " << cfg.dir << "\n";
+
+    remove_old_repository(cfg.dir);
+
+    git::Repository repo{ cfg.dir };
+    write_file(cfg.dir / ".git" / marker_file, "Generated by libgit4cpp_bench\n");
+
+    for (std::size_t i = 0; i != cfg.files; ++i)
+        write_file(cfg.dir / file_path(cfg, i), file_content(i, 0));
+
+    repo.add();
+    repo.commit("Add generated files");
+
+    // Version numbers of the history start after those used by the benchmarks below
+    for (std::size_t i = 0; i != cfg.history; ++i)
+        repo.commit_files(tree_changes(cfg, 1'000'000 + i), cat("History commit ", i));
+
+    repo.reset(0);
+}
+
+class Runner
+{
+public:
+    explicit Runner(const Config& cfg) : cfg_{ cfg } { }
+
+    // Run op() the configured number of times and record the durations. setup() is run
+    // before each repetition and not included in the timing.
+    void run(const std::string& name, std::size_t items, const std::function<void()>& op,
+        const std::function<void()>& setup = { })
+    {
+        if (not cfg_.filter.empty() && name.find(cfg_.filter) == std::string::npos)
+            return;
+
+        std::cerr << "Running " << name << "\n";
+
+        Result result{ name, items, { } };
+        result.times_us.reserve(cfg_.repetitions);
+
+        for (std::size_t i = 0; i != cfg_.repetitions; ++i)
+        {
+            if (setup)
+                setup();
+
+            const auto start = Clock::now();
+            op();
+            const auto stop = Clock::now();
+
+            result.times_us.push_back(
+                std::chrono::duration<double, std::micro>(stop - start).count());
+        }
+
+        results_.push_back(std::move(result));
+    }
+
+    const std::vector<Result>& results() const noexcept { return results_; }
+
+private:
+    const Config& cfg_;
+    std::vector<Result> results_;
+};
+
+struct Stats
+{
+    double min, median, mean, max, items_per_s;
+};
+
+Stats get_stats(const Result& result)
+{
+    auto times = result.times_us;
+    std::sort(times.begin(), times.end());
+
+    Stats s;
+    s.min = times.front();
+    s.max = times.back();
+    s.median = times.size() % 2 ? times[times.size() / 2]
+        : (times[times.size() / 2 - 1] + times[times.size() / 2]) / 2.0;
+    s.mean = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+    s.items_per_s = s.median > 0.0 ? result.items * 1e6 / s.median : 0.0;
+    return s;
+}
+
+std::string libgit2_version()
+{
+    int major = 0, minor = 0, rev = 0;
+    git_libgit2_version(&major, &minor, &rev);
+    return cat(major, '.', minor, '.', rev);
+}
+
+void print_json(const Config& cfg, const std::vector<Result>& results)
+{
+    std::cout << "{\n"
+        << "  \"libgit2_version\": \"" << libgit2_version() << "\",\n"
+        << "  \"config\": { \"files\": " << cfg.files << ", \"depth\": " << cfg.depth
+        << ", \"fanout\": " << cfg.fanout << ", \"history\": " << cfg.history
+        << ", \"repetitions\": " << cfg.repetitions << ", \"modified_percent\": "
+        << cfg.modified_percent << " },\n"
+        << "  \"results\": [";
+
+    for (std::size_t i = 0; i != results.size(); ++i)
+    {
+        const auto& r = results[i];
+        const auto s = get_stats(r);
+        std::cout << (i ? "," : "") << "\n    { \"name\": \"" << r.name
+            << "\", \"items\": " << r.items
+            << ", \"min_us\": " << s.min << ", \"median_us\": " << s.median
+            << ", \"mean_us\": " << s.mean << ", \"max_us\": " << s.max
+            << ", \"items_per_s\": " << s.items_per_s << " }";
+    }
+
+    std::cout << "\n  ]\n}\n";
+}
+
+void print_csv(const Config& cfg, const std::vector<Result>& results)
+{
+    std::cout << "name,items,files,depth,history,repetitions,"
+        "min_us,median_us,mean_us,max_us,items_per_s,libgit2_version\n";
+
+    for (const auto& r : results)
+    {
+        const auto s = get_stats(r);
+        std::cout << r.name << ',' << r.items << ',' << cfg.files << ',' << cfg.depth << ','
+            << cfg.history << ',' << cfg.repetitions << ',' << s.min << ',' << s.median
+            << ',' << s.mean << ',' << s.max << ',' << s.items_per_s << ','
+            << libgit2_version() << '\n';
+    }
+}
+
+void run_benchmarks(const Config& cfg, Runner& runner)
+{
+    git::Repository repo{ cfg.dir };
+
+    git::StatusOptions changes_only;
+    changes_only.include_unmodified = false;
+    changes_only.include_ignored = false;
+
+    const auto nr_modified = modified_files(cfg, 0).size();
+    std::size_t step = 1;
+
+    // Status of a clean work tree
+    runner.run("status_full_clean", cfg.files, [&]() { repo.status(); });
+    runner.run("status_changes_clean", cfg.files, [&]() { repo.status(changes_only); });
+    runner.run("status_list_clean", cfg.files, [&]() { repo.status_list(changes_only); });
+    runner.run("is_dirty_clean", cfg.files, [&]() { repo.is_dirty(); });
+
+    // Status of a work tree with modified files
+    modify_work_tree(cfg, step++);
+    runner.run("status_changes_modified", cfg.files, [&]() { repo.status(changes_only); });
+    runner.run("is_dirty_modified", cfg.files, [&]() { repo.is_dirty(); });
+    repo.reset(0);
+
+    // Staging and committing
+    runner.run("add_modified", nr_modified, [&]() { repo.add(); },
+        [&]() { modify_work_tree(cfg, step++); });
+
+    runner.run("commit", 1, [&]() { repo.commit(cat("Benchmark commit ", step)); },
+        [&]() { modify_work_tree(cfg, step++); repo.add(); });
+
+    git::TreeChanges changes;
+    runner.run("commit_files", nr_modified,
+        [&]() { repo.commit_files(changes, cat("Benchmark commit ", step)); },
+        [&]() { changes = tree_changes(cfg, step++); });
+
+    repo.reset(0);
+
+    // Switching between two branches that differ in the modified files
+    repo.new_branch("bench-other");
+    repo.commit_files(tree_changes(cfg, step++), "Diverge from bench-other");
+    repo.reset(0);
+    const auto main_branch = repo.get_current_branch_name();
+    bool on_main = true;
+    runner.run("switch_branch", nr_modified, [&]() {
+        repo.switch_branch(on_main ? "bench-other" : main_branch);
+        on_main = not on_main;
+    });
+    repo.switch_branch(main_branch);
+
+    // History
+    std::size_t nr_commits = 0;
+    for (const auto& commit : repo.log())
+    {
+        (void)commit;
+        ++nr_commits;
+    }
+    runner.run("log_full", nr_commits, [&]() {
+        for (const auto& commit : repo.log())
+            (void)commit.summary();
+    });
+
+    git::LogOptions path_filter;
+    path_filter.paths = { file_path(cfg, 0) };
+    runner.run("log_path_filter", nr_commits, [&]() {
+        for (const auto& commit : repo.log(path_filter))
+            (void)commit;
+    });
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        const Config cfg = parse_args(argc, argv);
+
+        generate_repository(cfg);
+
+        Runner runner{ cfg };
+        run_benchmarks(cfg, runner);
+
+        if (cfg.format == "csv")
+            print_csv(cfg, runner.results());
+        else
+            print_json(cfg, runner.results());
+    }
+    catch (const std::invalid_argument& e)
+    {
+        std::cerr << e.what() << "\n"
+            "Usage: " << argv[0] << " [--files=N] [--depth=N] [--fanout=N] [--history=N]\n"
+            "       [--repetitions=N] [--modified=PERCENT] [--dir=PATH]\n"
+            "       [--filter=SUBSTRING] [--format=json|csv]\n";
+        return 2;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
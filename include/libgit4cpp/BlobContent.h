@@ -0,0 +1,112 @@
+/**
+ * \file   BlobContent.h
+ * \date   Created on October 14, 2026
+ * \brief  Declaration of the BlobContent class.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef LIBGIT4CPP_BLOBCONTENT_H_
+#define LIBGIT4CPP_BLOBCONTENT_H_
+
+#include <cstddef>
+
+#include <git2.h>
+#include <gul14/string_view.h>
+
+#include "libgit4cpp/types.h"
+
+namespace git {
+
+/// Options for Repository::read_blob() and Repository::stream_blob().
+struct BlobReadOptions
+{
+    /**
+     * Apply the filters configured for the path (e.g. line ending conversion via
+     * .gitattributes), as a checkout would. Binary blobs are never filtered. Filtering
+     * produces a copy of the content.
+     */
+    bool apply_filters{ false };
+    /// Maximum size of the chunks passed to the consumer of Repository::stream_blob().
+    std::size_t chunk_size{ 64 * 1024 };
+};
+
+/**
+ * The content of a blob, kept alive by this object.
+ *
+ * Without filters, data() is a view directly onto the blob data held by libgit2, so no
+ * copy is made. The view stays valid as long as the BlobContent object (or the object
+ * it has been moved into) exists. The Repository must outlive the BlobContent object.
+ *
+ * \code
+ * BlobContent blob = repo.read_blob("HEAD", "src/main.cc");
+ * send_to_client(blob.data());
+ * \endcode
+ */
+class BlobContent
+{
+public:
+    /// Construct an empty object without a blob.
+    BlobContent() noexcept = default;
+
+    /**
+     * Take ownership of a blob and, optionally, of the buffer with a filtered copy of
+     * its content. The buffer is left empty.
+     */
+    explicit BlobContent(LibGitBlob blob, git_buf* filtered = nullptr) noexcept;
+
+    BlobContent(BlobContent&& other) noexcept;
+    BlobContent& operator=(BlobContent&& other) noexcept;
+
+    BlobContent(const BlobContent&) = delete;
+    BlobContent& operator=(const BlobContent&) = delete;
+
+    ~BlobContent();
+
+    /// Return a view of the (possibly filtered) content.
+    gul14::string_view data() const noexcept;
+
+    /// Return the size of the (possibly filtered) content in bytes.
+    std::size_t size() const noexcept { return data().size(); }
+
+    /// Determine if the content is empty.
+    bool empty() const noexcept { return size() == 0; }
+
+    /// Return the ID of the blob (must not be called on an empty object).
+    const git_oid& id() const noexcept { return *git_blob_id(blob_.get()); }
+
+    /// Determine if the blob looks like binary data (libgit2 heuristic).
+    bool is_binary() const noexcept;
+
+    /// Determine if data() is a filtered copy instead of the raw blob data.
+    bool is_filtered() const noexcept { return is_filtered_; }
+
+    /// Return a non-owning pointer to the libgit2 blob (null for an empty object).
+    git_blob* get() const noexcept { return blob_.get(); }
+
+private:
+    LibGitBlob blob_;
+    git_buf filtered_{ };
+    bool is_filtered_{ false };
+};
+
+} // namespace git
+
+#endif
+
+// vi:ts=4:sw=4:sts=4:et
@@ -0,0 +1,65 @@
+/**
+ * \file   BranchTracking.h
+ * \date   Created on October 14, 2026
+ * \brief  Declaration of the results of Repository::ahead_behind().
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef LIBGIT4CPP_BRANCHTRACKING_H_
+#define LIBGIT4CPP_BRANCHTRACKING_H_
+
+#include <cstddef>
+#include <string>
+
+#include <git2.h>
+
+namespace git {
+
+/// Number of commits by which two branches have diverged.
+struct AheadBehind
+{
+    std::size_t ahead{ 0 };  ///< Commits on the local side that are not upstream
+    std::size_t behind{ 0 }; ///< Commits upstream that are not on the local side
+
+    /// Determine if both sides point to the same history.
+    bool up_to_date() const noexcept { return ahead == 0 && behind == 0; }
+};
+
+/// Relation of a local branch to its upstream branch.
+struct BranchTracking
+{
+    std::string branch;   ///< Full name of the local branch (e.g. "refs/heads/main")
+    /**
+     * Full name of the upstream branch (e.g. "refs/remotes/origin/main"), or an empty
+     * string if no upstream is configured or the upstream reference does not exist.
+     */
+    std::string upstream;
+    git_oid local_id;     ///< Commit the local branch points to
+    git_oid upstream_id;  ///< Commit the upstream branch points to (zero if none)
+    AheadBehind counts;   ///< Divergence (all zero if there is no upstream)
+
+    /// Determine if an upstream branch is configured and exists.
+    bool has_upstream() const noexcept { return not upstream.empty(); }
+};
+
+} // namespace git
+
+#endif
+
+// vi:ts=4:sw=4:sts=4:et
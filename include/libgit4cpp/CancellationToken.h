@@ -0,0 +1,71 @@
+/**
+ * \file   CancellationToken.h
+ * \date   Created on October 14, 2026
+ * \brief  Declaration of the CancellationToken class.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef LIBGIT4CPP_CANCELLATIONTOKEN_H_
+#define LIBGIT4CPP_CANCELLATIONTOKEN_H_
+
+#include <atomic>
+#include <memory>
+
+namespace git {
+
+/**
+ * A thread-safe flag for cancelling asynchronous network operations.
+ *
+ * All copies of a token share the same state: a copy is handed to an operation like
+ * Repository::push_async(), and calling cancel() on any copy asks the operation to stop.
+ * The operation checks the token whenever libgit2 reports progress or asks for
+ * credentials and then fails with an Error carrying the code GIT_EUSER.
+ *
+ * \code
+ * CancellationToken token;
+ * auto result = repo.push_async("origin", { "HEAD:refs/heads/main" }, token);
+ * if (result.wait_for(std::chrono::seconds{ 10 }) == std::future_status::timeout)
+ *     token.cancel();
+ * result.get(); // throws if the push was cancelled
+ * \endcode
+ */
+class CancellationToken
+{
+public:
+    /// Create a new token that is not cancelled.
+    CancellationToken()
+        : cancelled_{ std::make_shared<std::atomic<bool>>(false) }
+    { }
+
+    /// Request cancellation of all operations using this token (or a copy of it).
+    void cancel() noexcept { cancelled_->store(true); }
+
+    /// Determine if cancellation has been requested.
+    bool is_cancelled() const noexcept { return cancelled_->load(); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> cancelled_;
+};
+
+} // namespace git
+
+#endif
+
+// vi:ts=4:sw=4:sts=4:et
@@ -0,0 +1,100 @@
+/**
+ * \file   CheckoutOptions.h
+ * \date   Created on October 14, 2026
+ * \brief  Options for checking out files and switching branches.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef LIBGIT4CPP_CHECKOUTOPTIONS_H_
+#define LIBGIT4CPP_CHECKOUTOPTIONS_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <gul14/string_view.h>
+
+namespace git {
+
+/// How a checkout treats the files in the work tree.
+enum class CheckoutMode
+{
+    /**
+     * Only write the files that differ between HEAD and the target commit. Local
+     * modifications of other files are kept. If a file that needs to be written has
+     * local modifications, the checkout fails without changing anything.
+     */
+    safe,
+    /**
+     * Write all selected files, overwriting local modifications. This is the behavior
+     * of "git checkout --force".
+     */
+    force
+};
+
+/// Events reported to a CheckoutNotifyCallback.
+enum class CheckoutNotification
+{
+    conflict,  ///< The file has local modifications that prevent the checkout
+    dirty,     ///< The file has local modifications but does not need to be written
+    updated,   ///< The file is written or removed by the checkout
+    untracked, ///< An untracked file is in the way of the checkout
+    ignored    ///< An ignored file is in the way of the checkout
+};
+
+/**
+ * Callback for checkout notifications. It is called before the work tree is modified.
+ * Return true to continue or false to cancel the checkout.
+ */
+using CheckoutNotifyCallback =
+    std::function<bool(CheckoutNotification notification, gul14::string_view path)>;
+
+/**
+ * Options for Repository::checkout() and Repository::switch_branch().
+ *
+ * \code
+ * CheckoutOptions opt;
+ * opt.on_notify = [](CheckoutNotification n, gul14::string_view path) {
+ *     if (n == CheckoutNotification::updated)
+ *         std::cout << "Updating " << path << "\n";
+ *     return true;
+ * };
+ * repo.switch_branch("feature", opt);
+ * \endcode
+ */
+struct CheckoutOptions
+{
+    /// How to treat the files in the work tree.
+    CheckoutMode mode{ CheckoutMode::safe };
+    /**
+     * Restrict the checkout to files matching one of these patterns (see
+     * Repository::add() for the glob syntax). An empty list means all files.
+     */
+    std::vector<std::string> paths;
+    /// Treat the paths as literal paths instead of glob patterns.
+    bool disable_pathspec_match{ false };
+    /// Called for files that are updated or in conflict (may be empty).
+    CheckoutNotifyCallback on_notify;
+};
+
+} // namespace git
+
+#endif
+
+// vi:ts=4:sw=4:sts=4:et
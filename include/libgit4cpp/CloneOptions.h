@@ -0,0 +1,100 @@
+/**
+ * \file   CloneOptions.h
+ * \date   Created on October 14, 2026
+ * \brief  Options for cloning a repository.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef LIBGIT4CPP_CLONEOPTIONS_H_
+#define LIBGIT4CPP_CLONEOPTIONS_H_
+
+#include <string>
+
+#include "libgit4cpp/FetchOptions.h"
+
+namespace git {
+
+/// How a repository on the local filesystem is cloned.
+enum class CloneLocal
+{
+    /**
+     * Copy or hardlink the objects of repositories given by a plain path, use the git
+     * transport for URLs (including file:// URLs). This is what git does.
+     */
+    automatic,
+    /**
+     * Bypass the git transport for all local repositories (also for file:// URLs) and
+     * hardlink the object files where possible. This is the fastest way to clone a
+     * repository on the same filesystem.
+     */
+    hardlink,
+    /// Like hardlink, but always copy the object files.
+    copy,
+    /// Always use the git transport, even for plain paths.
+    transport
+};
+
+/**
+ * Options for Repository::clone().
+ *
+ * The defaults behave like a plain "git clone". For throwaway checkouts that only need
+ * the tip of one branch, a shallow single-branch clone is much cheaper:
+ *
+ * \code
+ * CloneOptions opt;
+ * opt.depth = 1;
+ * opt.branch = "main";
+ * opt.single_branch = true;
+ * auto repo = Repository::clone("https://example.com/project.git", "project", opt);
+ * \endcode
+ */
+struct CloneOptions
+{
+    /// Called periodically while objects are received and indexed (may be empty).
+    TransferProgressCallback on_progress;
+    /**
+     * Limit the history to this number of commits from the tip of each cloned branch
+     * (a shallow clone). Zero clones the full history. Shallow clones require libgit2
+     * 1.7 or newer and are only possible through the git transport, so the depth is
+     * ignored if the objects are copied or hardlinked from a local repository.
+     */
+    int depth{ 0 };
+    /**
+     * Branch to check out (e.g. "main"). If empty, the default branch of the remote is
+     * checked out.
+     */
+    std::string branch;
+    /**
+     * Only fetch the branch given by \c branch (or the default branch of the remote)
+     * and configure the remote "origin" to fetch only this branch in future.
+     */
+    bool single_branch{ false };
+    /// Create a bare repository without a work tree.
+    bool bare{ false };
+    /// Check out the files into the work tree (ignored for bare repositories).
+    bool checkout{ true };
+    /// How to clone a repository on the local filesystem.
+    CloneLocal local{ CloneLocal::automatic };
+};
+
+} // namespace git
+
+#endif
+
+// vi:ts=4:sw=4:sts=4:et
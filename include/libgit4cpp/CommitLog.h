@@ -0,0 +1,250 @@
+/**
+ * \file   CommitLog.h
+ * \date   Created on October 14, 2026
+ * \brief  Declaration of the CommitLog and CommitRecord classes.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef LIBGIT4CPP_COMMITLOG_H_
+#define LIBGIT4CPP_COMMITLOG_H_
+
+#include <cstddef>
+#include <ctime>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <git2.h>
+#include <gul14/optional.h>
+#include <gul14/string_view.h>
+
+#include "libgit4cpp/types.h"
+
+namespace git {
+
+/// Order in which Repository::log() returns commits.
+enum class LogSort
+{
+    none,             ///< The default order of libgit2 (cheapest)
+    time,             ///< By commit time, newest first
+    topological,      ///< Parents are never shown before all of their children
+    topological_time  ///< Topological, ties broken by commit time
+};
+
+/// Options for Repository::log().
+struct LogOptions
+{
+    /**
+     * Revision to start from: a reference, a commit ID or any other expression
+     * understood by \c git \c rev-parse (e.g. "HEAD", "main", "v1.0^"), or a range in
+     * the form "A..B" (commits reachable from B, but not from A).
+     */
+    std::string revision = "HEAD";
+    /// Order of the commits.
+    LogSort sort = LogSort::time;
+    /// Return the commits in reverse order (oldest first).
+    bool reverse = false;
+    /// Only follow the first parent of merge commits.
+    bool first_parent_only = false;
+    /**
+     * Only return commits that change at least one of these files or directories
+     * (paths relative to the repository root, e.g. "src/main.cc" or "doc"). A merge
+     * commit is only returned if it differs from all of its parents, or from its first
+     * parent if first_parent_only is set. An empty list disables filtering.
+     */
+    std::vector<std::string> paths;
+    /// Maximum number of commits returned by CommitLog::next_page().
+    std::size_t page_size = 100;
+};
+
+/**
+ * A lightweight view on a single commit in the history.
+ *
+ * A CommitRecord holds a reference-counted handle to the libgit2 commit object, so
+ * copying it is cheap. All string accessors return views into the commit object that
+ * stay valid as long as the record (or a copy of it) is alive.
+ */
+class CommitRecord
+{
+public:
+    /**
+     * Construct a record by taking ownership of a commit.
+     * \exception Error is thrown if the pointer is null.
+     */
+    explicit CommitRecord(LibGitCommit&& commit);
+
+    CommitRecord(const CommitRecord& other);
+    CommitRecord(CommitRecord&&) noexcept = default;
+    CommitRecord& operator=(const CommitRecord& other);
+    CommitRecord& operator=(CommitRecord&&) noexcept = default;
+
+    /// Return the ID of the commit.
+    const git_oid& id() const noexcept;
+
+    /// Return the ID of the commit as a 40-character hex string.
+    std::string id_string() const;
+
+    /// Return the name of the author.
+    gul14::string_view author_name() const noexcept;
+
+    /// Return the e-mail address of the author.
+    gul14::string_view author_email() const noexcept;
+
+    /// Return the commit time in seconds since the Unix epoch.
+    std::time_t time() const noexcept;
+
+    /// Return the timezone offset of the commit time in minutes.
+    int time_offset() const noexcept;
+
+    /// Return the short summary of the commit message (its first paragraph).
+    gul14::string_view summary() const;
+
+    /// Return the full commit message.
+    gul14::string_view message() const noexcept;
+
+    /// Return the number of parents.
+    unsigned int parent_count() const noexcept;
+
+    /// Return a non-owning pointer to the underlying git commit object.
+    git_commit* get() const noexcept { return commit_.get(); }
+
+private:
+    LibGitCommit commit_;
+};
+
+/**
+ * A lazily evaluated walk through the commit history, created by Repository::log().
+ *
+ * Commits are only looked up when they are requested via next() or next_page(), so the
+ * cost of listing the latest N commits is proportional to N (plus the cost of sorting,
+ * which for LogSort::topological and LogSort::time may require a walk of the full
+ * history on the first call).
+ *
+ * \code
+ * auto log = repo.log();
+ * while (auto commit = log.next())
+ *     std::cout << commit->id_string() << " " << commit->summary() << "\n";
+ *
+ * // or page by page:
+ * LogOptions opt;
+ * opt.page_size = 20;
+ * auto paged = repo.log(opt);
+ * auto first_page = paged.next_page();
+ * auto second_page = paged.next_page();
+ * \endcode
+ *
+ * The Repository that created the log must outlive it.
+ */
+class CommitLog
+{
+public:
+    class iterator;
+
+    /**
+     * Create a commit log for the given repository.
+     * \exception Error is thrown if the start revision cannot be resolved.
+     */
+    CommitLog(git_repository* repo, const LogOptions& options);
+
+    /// Return the next commit, or an empty optional at the end of the history.
+    gul14::optional<CommitRecord> next();
+
+    /**
+     * Return the next page of commits (at most LogOptions::page_size of them).
+     * An empty vector signals the end of the history.
+     */
+    std::vector<CommitRecord> next_page();
+
+    /// Return an input iterator over the remaining commits.
+    iterator begin();
+
+    /// Return an iterator marking the end of the history.
+    iterator end();
+
+private:
+    git_repository* repo_;
+    LibGitRevwalk walk_;
+    std::vector<std::string> paths_;
+    bool first_parent_only_;
+    std::size_t page_size_;
+
+    bool touches_paths(git_commit* commit) const;
+};
+
+/// Input iterator over the commits of a CommitLog.
+class CommitLog::iterator
+{
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = CommitRecord;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const CommitRecord*;
+    using reference = const CommitRecord&;
+
+    iterator() = default;
+
+    reference operator*() const { return *current_; }
+    pointer operator->() const { return &*current_; }
+
+    iterator& operator++()
+    {
+        current_ = log_->next();
+        if (not current_)
+            log_ = nullptr;
+        return *this;
+    }
+
+    friend bool operator==(const iterator& a, const iterator& b) noexcept
+    {
+        return a.log_ == b.log_;
+    }
+
+    friend bool operator!=(const iterator& a, const iterator& b) noexcept
+    {
+        return not (a == b);
+    }
+
+private:
+    friend class CommitLog;
+
+    CommitLog* log_{ nullptr };
+    gul14::optional<CommitRecord> current_;
+
+    explicit iterator(CommitLog* log)
+        : log_{ log }
+    {
+        ++(*this);
+    }
+};
+
+inline CommitLog::iterator CommitLog::begin()
+{
+    return iterator{ this };
+}
+
+inline CommitLog::iterator CommitLog::end()
+{
+    return iterator{ };
+}
+
+} // namespace git
+
+#endif
+
+// vi:ts=4:sw=4:sts=4:et
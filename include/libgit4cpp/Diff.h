@@ -0,0 +1,168 @@
+/**
+ * \file   Diff.h
+ * \date   Created on October 14, 2026
+ * \brief  Declaration of the options and results of Repository::diff() and friends.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef LIBGIT4CPP_DIFF_H_
+#define LIBGIT4CPP_DIFF_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <git2.h>
+#include <gul14/string_view.h>
+
+#include "libgit4cpp/StatusList.h"
+
+namespace git {
+
+/// How much detail a diff computes.
+enum class DiffMode
+{
+    /**
+     * Only determine which files have changed and how (like "git diff --name-status").
+     * Blob contents are never loaded, so this is cheap even for large changes.
+     */
+    name_status,
+    /**
+     * Additionally compare the contents of the changed files line by line. The hunks
+     * and lines are streamed through the callbacks in DiffOptions, and the number of
+     * added and deleted lines is counted.
+     */
+    patch
+};
+
+/// A file that differs between the two sides of a diff.
+struct DiffDelta
+{
+    std::string old_path;  ///< Path on the old side
+    std::string new_path;  ///< Path on the new side (differs from old_path for renames)
+    FileChange change{ FileChange::unchanged }; ///< How the file has changed
+    git_oid old_id;        ///< Blob ID on the old side (zero if the file was added)
+    git_oid new_id;        ///< Blob ID on the new side (zero if deleted or not yet hashed)
+    bool binary{ false };  ///< File is binary (only determined in DiffMode::patch)
+    std::size_t additions{ 0 }; ///< Number of added lines (DiffMode::patch only)
+    std::size_t deletions{ 0 }; ///< Number of deleted lines (DiffMode::patch only)
+
+    friend std::ostream& operator<<(std::ostream& stream, const DiffDelta& delta);
+};
+
+/// A hunk of a patch, as passed to DiffHunkCallback and DiffLineCallback.
+struct DiffHunk
+{
+    gul14::string_view header; ///< Hunk header, e.g. "@@ -1,3 +1,4 @@"
+    int old_start{ 0 };        ///< First line of the hunk on the old side
+    int old_lines{ 0 };        ///< Number of lines on the old side
+    int new_start{ 0 };        ///< First line of the hunk on the new side
+    int new_lines{ 0 };        ///< Number of lines on the new side
+};
+
+/// A line of a patch, as passed to DiffLineCallback.
+struct DiffLine
+{
+    /// '+' for added, '-' for deleted, ' ' for context lines (see git_diff_line_t).
+    char origin{ ' ' };
+    /// Content of the line including the line ending (not null-terminated).
+    gul14::string_view content;
+    int old_lineno{ -1 };      ///< Line number on the old side (-1 for added lines)
+    int new_lineno{ -1 };      ///< Line number on the new side (-1 for deleted lines)
+};
+
+/**
+ * Callback for the hunks of a patch. The string views are only valid during the call.
+ * Return true to continue or false to stop the diff.
+ */
+using DiffHunkCallback = std::function<bool(const DiffDelta&, const DiffHunk&)>;
+
+/**
+ * Callback for the lines of a patch. The string views are only valid during the call.
+ * Return true to continue or false to stop the diff.
+ */
+using DiffLineCallback =
+    std::function<bool(const DiffDelta&, const DiffHunk&, const DiffLine&)>;
+
+/**
+ * Options for Repository::diff(), Repository::diff_index(), and
+ * Repository::diff_workdir().
+ *
+ * \code
+ * DiffOptions opt;
+ * opt.mode = DiffMode::patch;
+ * opt.on_line = [](const DiffDelta& delta, const DiffHunk&, const DiffLine& line) {
+ *     std::cout << line.origin << line.content;
+ *     return true;
+ * };
+ * auto result = repo.diff("HEAD~1", "HEAD", opt);
+ * \endcode
+ */
+struct DiffOptions
+{
+    /// How much detail to compute.
+    DiffMode mode{ DiffMode::name_status };
+    /**
+     * Restrict the diff to files matching one of these patterns (see Repository::add()
+     * for the glob syntax). An empty list means all files.
+     */
+    std::vector<std::string> paths;
+    /// Treat the paths as literal paths instead of glob patterns.
+    bool disable_pathspec_match{ false };
+    /**
+     * Pair added and deleted files into renames. In DiffMode::name_status, only files
+     * with identical contents are detected as renamed, so that no blobs are loaded.
+     */
+    bool detect_renames{ false };
+    /// Report untracked files as added (diff_workdir() only).
+    bool include_untracked{ false };
+    /// Number of unchanged lines around each hunk (DiffMode::patch only).
+    std::uint32_t context_lines{ 3 };
+    /// Called for each hunk (DiffMode::patch only, may be empty).
+    DiffHunkCallback on_hunk;
+    /// Called for each line of each hunk (DiffMode::patch only, may be empty).
+    DiffLineCallback on_line;
+};
+
+/// Summary of a diff.
+struct DiffStats
+{
+    std::size_t files_changed{ 0 }; ///< Number of changed files
+    std::size_t insertions{ 0 };    ///< Number of added lines (DiffMode::patch only)
+    std::size_t deletions{ 0 };     ///< Number of deleted lines (DiffMode::patch only)
+};
+
+/**
+ * Result of a diff. If a callback stopped the diff, the result only contains the files
+ * visited until then.
+ */
+struct DiffResult
+{
+    std::vector<DiffDelta> deltas; ///< The changed files in the order of their paths
+    DiffStats stats;               ///< Summary of all deltas
+};
+
+} // namespace git
+
+#endif
+
+// vi:ts=4:sw=4:sts=4:et
@@ -0,0 +1,117 @@
+/**
+ * \file   FetchOptions.h
+ * \date   Created on October 14, 2026
+ * \brief  Options and results of Repository::fetch().
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef LIBGIT4CPP_FETCHOPTIONS_H_
+#define LIBGIT4CPP_FETCHOPTIONS_H_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <git2.h>
+
+#include "libgit4cpp/RemoteReferenceList.h"
+
+namespace git {
+
+/// Progress of a transfer from a remote, as reported during fetch and clone.
+struct TransferProgress
+{
+    unsigned int total_objects{ 0 };    ///< Number of objects in the pack
+    unsigned int indexed_objects{ 0 };  ///< Number of objects indexed so far
+    unsigned int received_objects{ 0 }; ///< Number of objects received so far
+    unsigned int local_objects{ 0 };    ///< Number of objects taken from the local repo
+    unsigned int total_deltas{ 0 };     ///< Number of deltas in the pack
+    unsigned int indexed_deltas{ 0 };   ///< Number of deltas resolved so far
+    std::size_t received_bytes{ 0 };    ///< Number of bytes received so far
+};
+
+/**
+ * Callback for transfer progress. Return true to continue or false to cancel the
+ * operation.
+ */
+using TransferProgressCallback = std::function<bool(const TransferProgress&)>;
+
+/// Which tags are downloaded by a fetch.
+enum class FetchTags
+{
+    automatic, ///< Tags that point into the downloaded history (the git default)
+    none,      ///< No tags
+    all        ///< All tags of the remote
+};
+
+/// Options for Repository::fetch().
+struct FetchOptions
+{
+    /// Called periodically while objects are received and indexed (may be empty).
+    TransferProgressCallback on_progress;
+    /**
+     * Limit the history to this number of commits from the tip of each fetched branch
+     * (a shallow fetch). Zero fetches the full history. Requires libgit2 1.7 or newer.
+     */
+    int depth{ 0 };
+    /// Remove remote-tracking references that no longer exist on the remote.
+    bool prune{ false };
+    /// Which tags to download.
+    FetchTags tags{ FetchTags::automatic };
+    /// Write the fetched references to FETCH_HEAD.
+    bool update_fetchhead{ true };
+    /**
+     * If set, only the references that differ between this (earlier) result of
+     * Remote::list_references() and the current state of the remote are fetched. If
+     * nothing has changed, no objects are requested at all. The pointed-to list must
+     * stay alive during the call.
+     */
+    const RemoteReferenceList* only_changed_since{ nullptr };
+};
+
+/// A reference that was created or moved by a fetch.
+struct RefUpdate
+{
+    std::string name; ///< Full name of the local reference (e.g. "refs/remotes/origin/main")
+    git_oid old_id;   ///< Previous target (zero if the reference was created)
+    git_oid new_id;   ///< New target
+};
+
+/// Result of Repository::fetch().
+struct FetchResult
+{
+    /// Local references that have been created or updated.
+    std::vector<RefUpdate> updated_refs;
+    /// Transfer statistics of the download.
+    TransferProgress stats;
+    /**
+     * The references on the remote at the time of the fetch. Pass this as
+     * FetchOptions::only_changed_since to the next fetch to download only what changed.
+     */
+    RemoteReferenceList remote_references;
+    /// True if only_changed_since was given and no requested reference had changed.
+    bool up_to_date{ false };
+};
+
+} // namespace git
+
+#endif
+
+// vi:ts=4:sw=4:sts=4:et
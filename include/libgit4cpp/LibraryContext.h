@@ -0,0 +1,145 @@
+/**
+ * \file   LibraryContext.h
+ * \date   Created on October 14, 2026
+ * \brief  Declaration of the LibraryContext class.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef LIBGIT4CPP_LIBRARYCONTEXT_H_
+#define LIBGIT4CPP_LIBRARYCONTEXT_H_
+
+#include <cstddef>
+
+#include <gul14/optional.h>
+
+namespace git {
+
+/**
+ * Process-wide tuning knobs of libgit2.
+ *
+ * Every member that is left empty keeps the current libgit2 setting. All settings are
+ * global, i.e. they affect every repository in the process.
+ */
+struct LibraryOptions
+{
+    /// Enable or disable the object cache.
+    gul14::optional<bool> enable_caching;
+    /// Maximum memory in bytes used by the object cache (libgit2 default: 256 MiB).
+    gul14::optional<std::size_t> cache_max_size;
+    /// Size in bytes of a single memory-mapped window into a pack file.
+    gul14::optional<std::size_t> mwindow_size;
+    /// Maximum total memory in bytes that may be memory-mapped from pack files.
+    gul14::optional<std::size_t> mwindow_mapped_limit;
+    /**
+     * Maximum number of pack files that may be memory-mapped at the same time
+     * (0 = unlimited). Requires libgit2 1.1 or newer.
+     */
+    gul14::optional<std::size_t> mwindow_file_limit;
+    /**
+     * Verify that all objects referenced by newly created objects exist. Switching this
+     * off saves an object database lookup per referenced object when committing.
+     */
+    gul14::optional<bool> strict_object_creation;
+    /// Verify the hash of every object read from the object database.
+    gul14::optional<bool> strict_hash_verification;
+};
+
+/// Memory usage of the libgit2 object cache.
+struct CacheUsage
+{
+    std::size_t current_bytes; ///< Memory currently used by cached objects
+    std::size_t max_bytes;     ///< Maximum memory the cache may use
+};
+
+/**
+ * RAII guard for the global state of libgit2.
+ *
+ * Constructing a LibraryContext initializes libgit2 (if it is not initialized yet), and
+ * destroying the last one shuts it down again, releasing thread-local storage, caches
+ * and SSL state. Every Repository holds a LibraryContext. Programs that create and
+ * destroy many short-lived Repository objects should therefore keep one additional
+ * LibraryContext alive for their whole runtime, so that the global state is built only
+ * once:
+ *
+ * \code
+ * int main()
+ * {
+ *     LibraryOptions opt;
+ *     opt.cache_max_size = 1024 * 1024 * 1024;
+ *     opt.strict_object_creation = false;
+ *     git::LibraryContext libgit2{ opt };
+ *
+ *     for (const auto& path : paths)
+ *     {
+ *         Repository repo{ path }; // reuses the global state
+ *         ...
+ *     }
+ * }
+ * \endcode
+ *
+ * LibraryContext objects may be copied; each copy holds its own reference on the
+ * global state.
+ */
+class LibraryContext
+{
+public:
+    /**
+     * Initialize libgit2 without changing its settings.
+     * \exception Error is thrown if libgit2 cannot be initialized.
+     */
+    LibraryContext();
+
+    /**
+     * Initialize libgit2 and apply the given settings.
+     * \exception Error is thrown if libgit2 cannot be initialized or if a setting cannot
+     *            be applied.
+     */
+    explicit LibraryContext(const LibraryOptions& options);
+
+    LibraryContext(const LibraryContext&);
+    LibraryContext& operator=(const LibraryContext&) noexcept { return *this; }
+
+    /**
+     * Take another reference on the global state. This cannot fail because the
+     * moved-from context keeps its own reference until it is destroyed.
+     */
+    LibraryContext(LibraryContext&&) noexcept;
+    LibraryContext& operator=(LibraryContext&&) noexcept { return *this; }
+
+    /// Release the reference on the global state, shutting down libgit2 if it is the last.
+    ~LibraryContext();
+
+    /**
+     * Apply settings to the running library.
+     * \exception Error is thrown if a setting cannot be applied.
+     */
+    void configure(const LibraryOptions& options) const;
+
+    /**
+     * Return the memory usage of the object cache.
+     * \exception Error is thrown if the usage cannot be queried.
+     */
+    CacheUsage cache_usage() const;
+};
+
+} // namespace git
+
+#endif
+
+// vi:ts=4:sw=4:sts=4:et
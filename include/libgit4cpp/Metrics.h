@@ -0,0 +1,165 @@
+/**
+ * \file   Metrics.h
+ * \date   Created on October 14, 2026
+ * \brief  Declaration of the Metrics interface and the MetricsCollector class.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef LIBGIT4CPP_METRICS_H_
+#define LIBGIT4CPP_METRICS_H_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <gul14/string_view.h>
+
+namespace git {
+
+/**
+ * Interface for a sink that receives timings and counters from libgit4cpp.
+ *
+ * Once a sink has been installed with set_metrics(), the library reports:
+ * - the duration of each call to libgit2 made through the wrapper functions (named
+ *   after the libgit2 function, e.g. "git_status_list_new"),
+ * - the duration of the Repository and Remote member functions (e.g.
+ *   "Repository::status_list", "Remote::list_references"). Overloads share one name.
+ *   Trivial accessors (e.g. Repository::get_path(), Remote::get_name()), the
+ *   connection bookkeeping of Remote, and functions that only forward to an instrumented
+ *   one (e.g. Repository::stream_blob(), Repository::push_async()) are not timed
+ *   separately,
+ * - counters for the data transferred over the network (e.g.
+ *   "Repository::fetch.received_bytes", "Repository::push.sent_bytes").
+ *
+ * Comparing the duration of a member function with that of the libgit2 calls it makes
+ * shows whether time goes into libgit2 or into the wrapper itself.
+ *
+ * The functions may be called concurrently from several threads. They must not throw.
+ *
+ * \see MetricsCollector for a ready-made implementation
+ */
+class Metrics
+{
+public:
+    virtual ~Metrics() = default;
+
+    /**
+     * Record the duration of an operation. This is also called if the operation has
+     * failed with an exception.
+     * \param operation  Name of the operation (a string literal)
+     * \param duration   Wall-clock time the operation took
+     */
+    virtual void record_latency(const char* operation,
+        std::chrono::nanoseconds duration) noexcept = 0;
+
+    /**
+     * Add a value to a counter.
+     * \param counter  Name of the counter (a string literal)
+     * \param value    Value to be added
+     */
+    virtual void add_to_counter(const char* counter, std::uint64_t value) noexcept = 0;
+};
+
+/**
+ * Install a global metrics sink, or remove it by passing a null pointer.
+ *
+ * Without a sink (the default), the instrumentation costs a single atomic load per
+ * instrumented call; in particular, no clock is read. The sink must stay alive until it
+ * has been removed and all library calls that might still be using it have returned.
+ */
+void set_metrics(Metrics* sink) noexcept;
+
+/// Return the installed metrics sink, or null if there is none.
+Metrics* get_metrics() noexcept;
+
+/**
+ * A histogram of operation durations with logarithmic buckets.
+ *
+ * Bucket 0 counts durations below 1 µs, bucket i (for i > 0) durations from 2^(i-1) µs
+ * up to below 2^i µs. The last bucket also counts all longer durations.
+ */
+struct LatencyHistogram
+{
+    /// Number of buckets (the last one starts at about 4 s).
+    static constexpr std::size_t num_buckets = 24;
+
+    std::uint64_t count{ 0 };             ///< Number of recorded durations
+    std::chrono::nanoseconds total{ 0 };  ///< Sum of all recorded durations
+    std::chrono::nanoseconds max{ 0 };    ///< Longest recorded duration
+    std::array<std::uint64_t, num_buckets> buckets{ }; ///< Counts per bucket
+
+    /// Add a duration to the histogram.
+    void add(std::chrono::nanoseconds duration) noexcept;
+
+    /// Return the mean duration (zero if nothing has been recorded).
+    std::chrono::nanoseconds mean() const noexcept;
+};
+
+/**
+ * A thread-safe Metrics sink that keeps counters and latency histograms in memory.
+ *
+ * \code
+ * git::MetricsCollector metrics;
+ * git::set_metrics(&metrics);
+ * repo.status_list();
+ * git::set_metrics(nullptr);
+ *
+ * for (const auto& entry : metrics.get_histograms())
+ *     std::cout << entry.first << ": " << entry.second.mean().count() << " ns\n";
+ * \endcode
+ */
+class MetricsCollector : public Metrics
+{
+public:
+    void record_latency(const char* operation,
+        std::chrono::nanoseconds duration) noexcept override;
+
+    void add_to_counter(const char* counter, std::uint64_t value) noexcept override;
+
+    /// Return the value of a counter (zero if it has never been increased).
+    std::uint64_t get_counter(gul14::string_view counter) const;
+
+    /// Return the histogram of an operation (empty if it has never been recorded).
+    LatencyHistogram get_histogram(gul14::string_view operation) const;
+
+    /// Return a copy of all counters.
+    std::map<std::string, std::uint64_t> get_counters() const;
+
+    /// Return a copy of all histograms.
+    std::map<std::string, LatencyHistogram> get_histograms() const;
+
+    /// Remove all counters and histograms.
+    void reset();
+
+private:
+    mutable std::mutex mutex_;
+    std::map<std::string, std::uint64_t, std::less<>> counters_;
+    std::map<std::string, LatencyHistogram, std::less<>> histograms_;
+};
+
+} // namespace git
+
+#endif
+
+// vi:ts=4:sw=4:sts=4:et
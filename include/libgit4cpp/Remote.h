@@ -25,22 +25,60 @@
 #ifndef LIBGIT4CPP_REMOTE_H_
 #define LIBGIT4CPP_REMOTE_H_
 
+#include <chrono>
+#include <future>
 #include <string>
+#include <vector>
 
 #include <git2.h>
 #include <gul14/optional.h>
 #include <gul14/SmallVector.h>
+#include <gul14/string_view.h>
 
+#include "libgit4cpp/CancellationToken.h"
+#include "libgit4cpp/LibraryContext.h"
+#include "libgit4cpp/RemoteReferenceList.h"
 #include "libgit4cpp/types.h"
 
 namespace git {
 
+/// Direction of a connection to a remote.
+enum class RemoteDirection
+{
+    fetch, ///< For listing references and fetching
+    push   ///< For pushing
+};
+
 /**
  * An abstraction of a git remote repository (such as "origin").
  *
  * A remote has a name and a URL which can be accessed via get_name() and get_url(),
  * respectively. In addition, a non-owning pointer to the underlying git_remote object
  * can be retrieved via get().
+ *
+ * By default, every network operation (list_references(), Repository::push(), ...)
+ * opens its own connection and closes it when it is done. To run several operations
+ * over the same connection and pay the TLS/SSH handshake only once, open a connection
+ * explicitly with connect():
+ *
+ * \code
+ * remote.set_idle_timeout(std::chrono::seconds{ 30 });
+ * remote.connect(RemoteDirection::push);
+ * repo.push(remote, "refs/heads/main:refs/heads/main");
+ * repo.push(remote, "refs/heads/dev:refs/heads/dev");
+ * remote.disconnect();
+ * \endcode
+ *
+ * While connected, operations reuse the connection as long as it is alive, matches the
+ * required direction and has not been idle for longer than the idle timeout; otherwise
+ * it is transparently reopened. Note that a git server advertises its references only
+ * once per connection: list_references() on an open connection returns the state from
+ * the moment the connection was opened. Call connect() again to refresh it.
+ *
+ * Over HTTP(S) and local transports, one connection can serve any number of transfers.
+ * SSH and git:// servers end their session after a push or fetch, so for these the
+ * connection is reopened before the next transfer (listing references is still served
+ * from the open connection).
  */
 class Remote
 {
@@ -53,6 +91,18 @@ public:
      */
     Remote(LibGitRemote&& remote_ptr);
 
+    /**
+     * Move constructor. An open connection is handed over to the new object. The
+     * moved-from object may only be destroyed or assigned to.
+     */
+    Remote(Remote&&) noexcept = default;
+
+    /// Move assignment (any connection of this object is closed).
+    Remote& operator=(Remote&&) noexcept = default;
+
+    Remote(const Remote&) = delete;
+    Remote& operator=(const Remote&) = delete;
+
     /// Return a non-owning pointer to the underlying git remote object.
     git_remote* get() const { return remote_.get(); }
 
@@ -63,17 +113,124 @@ public:
     std::string get_url() const;
 
     /**
-     * Retrieve a list of references available on this remote repository
-     * ("git ls-remote").
+     * Retrieve the references available on this remote repository ("git ls-remote").
      *
-     * \note
-     * The API for this function is preliminary. It would be more useful to return not
-     * just the names of the references, but also additional details like the commit IDs.
+     * The result contains the name, the object ID, the peeled object ID (for annotated
+     * tags) and the symbolic target (e.g. of HEAD) of each reference. Only a single
+     * round trip to the server is needed; if the remote is already connected, the
+     * existing connection is reused.
+     *
+     * \code
+     * auto branches = remote.list_references("refs/heads/");
+     * if (auto main = branches.find("refs/heads/main"))
+     *     std::cout << git_oid_tostr_s(&main->id) << "\n";
+     * \endcode
+     *
+     * \param prefix  Only return references whose names start with this prefix (e.g.
+     *                "refs/heads/" or "refs/tags/"). By default, all are returned.
+     * \exception Error is thrown if the remote cannot be contacted.
+     */
+    RemoteReferenceList list_references(gul14::string_view prefix = "");
+
+    /**
+     * Retrieve the references available on this remote repository asynchronously.
+     *
+     * The listing runs on a separate thread with its own connection to the URL of this
+     * remote, so the Remote object may be used or destroyed while the operation is in
+     * progress. An explicit connection opened with connect() is not used.
+     *
+     * \param prefix  Only return references whose names start with this prefix
+     * \param token   Token for cancelling the operation; the future then throws an Error
+     *                with code GIT_EUSER. Cancellation takes effect the next time
+     *                libgit2 invokes a callback, e.g. while asking for credentials.
+     * \returns a future for the list of references. It throws an Error if the remote
+     *          cannot be contacted.
+     */
+    std::future<RemoteReferenceList> list_references_async(gul14::string_view prefix = "",
+        CancellationToken token = CancellationToken{ }) const;
+
+    /**
+     * Open a connection to the remote that is kept open for subsequent operations.
+     * If the remote is already connected, the connection is closed and reopened, which
+     * also refreshes the list of references advertised by the server.
+     * \exception Error is thrown if the connection cannot be established.
      */
-    std::vector<std::string> list_references();
+    void connect(RemoteDirection direction = RemoteDirection::fetch);
+
+    /// Close the connection to the remote (if any).
+    void disconnect() noexcept;
+
+    /// Determine if a connection opened with connect() is currently established.
+    bool is_connected() const noexcept;
+
+    /**
+     * Set the maximum time a connection may stay unused before it is considered stale.
+     * A stale connection is reopened by the next operation or closed by
+     * disconnect_if_idle(). A timeout of zero (the default) disables the check.
+     */
+    void set_idle_timeout(std::chrono::milliseconds timeout) noexcept
+    {
+        idle_timeout_ = timeout;
+    }
+
+    /// Return the idle timeout (zero if disabled).
+    std::chrono::milliseconds get_idle_timeout() const noexcept { return idle_timeout_; }
+
+    /**
+     * Close the connection if it has been unused for longer than the idle timeout.
+     * \returns true if a connection was closed.
+     */
+    bool disconnect_if_idle() noexcept;
 
 private:
-    LibGitRemote remote_{ nullptr, git_remote_free };
+    friend class Repository;
+
+    LibGitRemote remote_;
+
+    /// True if a connection has been opened explicitly with connect().
+    bool keep_connection_{ false };
+
+    std::chrono::milliseconds idle_timeout_{ 0 };
+
+    /// Direction of the current connection.
+    mutable RemoteDirection direction_{ RemoteDirection::fetch };
+
+    /// Time at which the current connection was last used.
+    mutable std::chrono::steady_clock::time_point last_used_{ };
+
+    /// True if a push or fetch has been run over the current connection.
+    mutable bool transfer_done_{ false };
+
+    /**
+     * Make sure that the remote is connected for an operation in the given direction.
+     * If accept_any_direction is true, an open connection in the other direction is
+     * reused as well. If transfer is true, the operation transfers objects (push or
+     * fetch), which requires a fresh session on stateful transports.
+     * \returns true if the connection has been opened for this operation only and must be
+     *          closed with release_connection() afterwards.
+     * \exception Error is thrown if the connection cannot be established.
+     */
+    bool acquire_connection(RemoteDirection direction, const git_remote_callbacks& callbacks,
+        bool accept_any_direction = false, bool transfer = false) const;
+
+    /**
+     * Finish an operation started with acquire_connection(). The transfer flag must match
+     * the one given to acquire_connection().
+     */
+    void release_connection(bool temporary, bool transfer = false) const noexcept;
+
+    /// Return true if the server ends its session after each push or fetch (SSH, git://).
+    bool has_stateful_transport() const;
+
+    /// Return true if the connection has been idle for longer than the idle timeout.
+    bool is_idle() const noexcept;
+
+    void open_connection(RemoteDirection direction,
+        const git_remote_callbacks& callbacks) const;
+
+    /// List references, aborting if the token (which may be null) is cancelled.
+    RemoteReferenceList list_references_impl(gul14::string_view prefix,
+        const CancellationToken* token);
 };
 
 } // namespace git
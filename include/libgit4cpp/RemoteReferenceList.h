@@ -0,0 +1,185 @@
+/**
+ * \file   RemoteReferenceList.h
+ * \date   Created on October 14, 2026
+ * \brief  Declaration of the RemoteReferenceList class.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef LIBGIT4CPP_REMOTEREFERENCELIST_H_
+#define LIBGIT4CPP_REMOTEREFERENCELIST_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <git2.h>
+#include <gul14/optional.h>
+#include <gul14/string_view.h>
+
+namespace git {
+
+/**
+ * Lightweight, non-owning description of a reference on a remote repository.
+ *
+ * The string views point into the RemoteReferenceList the reference was taken from.
+ * They stay valid as long as the list is alive and unmodified.
+ */
+struct RemoteReference
+{
+    /// Full name of the reference (e.g. "refs/heads/main" or "HEAD").
+    gul14::string_view name;
+    /// Object the reference points to.
+    git_oid id{ };
+    /// For annotated tags, the commit the tag points to ("ref^{}"); otherwise empty.
+    gul14::optional<git_oid> peeled_id;
+    /// For symbolic references, the name of the target (e.g. "refs/heads/main" for
+    /// HEAD); otherwise empty. Not all transports report symbolic references.
+    gul14::string_view symref_target;
+
+    /// Return the ID of the commit the reference finally points to.
+    const git_oid& target_id() const noexcept { return peeled_id ? *peeled_id : id; }
+};
+
+/**
+ * The references available on a remote repository, as returned by
+ * Remote::list_references() ("git ls-remote").
+ *
+ * All names are stored in a single string buffer owned by the list. The peeled entries
+ * of annotated tags ("refs/tags/v1.0^{}") that are sent by the server as separate
+ * references are folded into the peeled_id of the corresponding tag.
+ */
+class RemoteReferenceList
+{
+public:
+    class const_iterator;
+    using value_type = RemoteReference;
+    using size_type = std::size_t;
+
+    /// Construct an empty list.
+    RemoteReferenceList() = default;
+
+    /**
+     * Construct a list from the heads reported by git_remote_ls(), keeping only the
+     * references whose names start with the given prefix.
+     * \exception Error is thrown if the total length of all names exceeds 4 GiB.
+     */
+    RemoteReferenceList(const git_remote_head** heads, std::size_t nr_heads,
+        gul14::string_view prefix = "");
+
+    /// Return the number of references.
+    size_type size() const noexcept { return entries_.size(); }
+
+    /// Determine if the list is empty.
+    bool empty() const noexcept { return entries_.empty(); }
+
+    /// Return the reference with the given index (no bounds check).
+    RemoteReference operator[](size_type idx) const noexcept;
+
+    /// Return an iterator to the first reference.
+    const_iterator begin() const noexcept;
+
+    /// Return an iterator past the last reference.
+    const_iterator end() const noexcept;
+
+    /// Return the reference with the given full name, or an empty optional.
+    gul14::optional<RemoteReference> find(gul14::string_view name) const noexcept;
+
+    /// Return the names of all references as a vector of strings.
+    std::vector<std::string> names() const;
+
+private:
+    struct Entry
+    {
+        std::uint32_t name_offset;
+        std::uint32_t name_size;
+        std::uint32_t symref_offset;
+        std::uint32_t symref_size;
+        git_oid id;
+        git_oid peeled_id;
+        bool has_peeled_id;
+    };
+
+    std::string pool_;
+    std::vector<Entry> entries_;
+
+    std::uint32_t store(gul14::string_view str);
+    gul14::string_view name_of(const Entry& e) const noexcept;
+};
+
+/// Forward iterator over the references of a RemoteReferenceList.
+class RemoteReferenceList::const_iterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = RemoteReference;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = RemoteReference;
+
+    const_iterator() = default;
+
+    RemoteReference operator*() const noexcept { return (*list_)[idx_]; }
+
+    const_iterator& operator++() noexcept { ++idx_; return *this; }
+
+    const_iterator operator++(int) noexcept
+    {
+        const_iterator copy{ *this };
+        ++idx_;
+        return copy;
+    }
+
+    friend bool operator==(const const_iterator& a, const const_iterator& b) noexcept
+    {
+        return a.idx_ == b.idx_ && a.list_ == b.list_;
+    }
+
+    friend bool operator!=(const const_iterator& a, const const_iterator& b) noexcept
+    {
+        return not (a == b);
+    }
+
+private:
+    friend class RemoteReferenceList;
+
+    const RemoteReferenceList* list_{ nullptr };
+    size_type idx_{ 0 };
+
+    const_iterator(const RemoteReferenceList* list, size_type idx) noexcept
+        : list_{ list }, idx_{ idx }
+    { }
+};
+
+inline RemoteReferenceList::const_iterator RemoteReferenceList::begin() const noexcept
+{
+    return const_iterator{ this, 0 };
+}
+
+inline RemoteReferenceList::const_iterator RemoteReferenceList::end() const noexcept
+{
+    return const_iterator{ this, entries_.size() };
+}
+
+} // namespace git
+
+#endif
+
+// vi:ts=4:sw=4:sts=4:et
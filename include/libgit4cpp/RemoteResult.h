@@ -0,0 +1,60 @@
+/**
+ * \file   RemoteResult.h
+ * \date   Created on October 14, 2026
+ * \brief  Result of a network operation on one of several remotes.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef LIBGIT4CPP_REMOTERESULT_H_
+#define LIBGIT4CPP_REMOTERESULT_H_
+
+#include <chrono>
+#include <string>
+#include <system_error>
+
+#include "libgit4cpp/FetchOptions.h"
+
+namespace git {
+
+/**
+ * The outcome of a push or fetch on a single remote, as reported by
+ * Repository::push_to_remotes() and Repository::fetch_from_remotes().
+ */
+struct RemoteResult
+{
+    /// Name of the remote (e.g. "origin").
+    std::string remote_name;
+    /// True if the operation succeeded.
+    bool ok{ false };
+    /// Error code if the operation failed.
+    std::error_code error;
+    /// Error message if the operation failed.
+    std::string error_message;
+    /// Wall-clock time spent on this remote (including connecting).
+    std::chrono::steady_clock::duration duration{ };
+    /// Details of a successful fetch (empty for pushes).
+    FetchResult fetch;
+};
+
+} // namespace git
+
+#endif
+
+// vi:ts=4:sw=4:sts=4:et
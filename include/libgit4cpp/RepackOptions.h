@@ -0,0 +1,94 @@
+/**
+ * \file   RepackOptions.h
+ * \date   Created on October 14, 2026
+ * \brief  Declaration of the options and results of Repository::repack().
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef LIBGIT4CPP_REPACKOPTIONS_H_
+#define LIBGIT4CPP_REPACKOPTIONS_H_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace git {
+
+/// Phase of Repository::repack() reported to a RepackProgressCallback.
+enum class RepackStage
+{
+    adding_objects, ///< Objects are added to the pack builder
+    deltification,  ///< Deltas between similar objects are computed
+    indexing        ///< The pack file is written and indexed
+};
+
+/**
+ * A function that is called periodically during Repository::repack() with the current
+ * stage and the number of objects processed so far in this stage. It may be called
+ * from worker threads of libgit2. If it returns false, the operation is cancelled and
+ * no loose objects are removed.
+ */
+using RepackProgressCallback =
+    std::function<bool(RepackStage stage, std::size_t current, std::size_t total)>;
+
+/**
+ * Options for Repository::repack().
+ *
+ * \code
+ * // Run nightly in a service that commits a lot
+ * RepackOptions opt;
+ * opt.write_multi_pack_index = true;
+ * auto result = repo.repack(opt);
+ * std::cout << "Packed " << result.objects_packed << " objects\n";
+ * \endcode
+ */
+struct RepackOptions
+{
+    /// Delete the loose objects after they have been written to the new pack.
+    bool prune_loose{ true };
+    /**
+     * Write a multi-pack-index covering all pack files, so that object lookups do not
+     * need to search each pack index in turn (requires libgit2 1.1 or newer).
+     */
+    bool write_multi_pack_index{ false };
+    /// Number of threads used for delta compression (zero: one per CPU core).
+    unsigned int threads{ 0 };
+    /// Called periodically to report the progress (may be empty).
+    RepackProgressCallback on_progress;
+};
+
+/// Result of Repository::repack().
+struct RepackResult
+{
+    /// Number of loose objects written to the new pack.
+    std::size_t objects_packed{ 0 };
+    /// Number of loose object files that have been deleted.
+    std::size_t loose_objects_removed{ 0 };
+    /**
+     * File name of the new pack without directory (e.g. "pack-1a2b...3c.pack"), or an
+     * empty string if there were no loose objects to pack.
+     */
+    std::string pack_name;
+};
+
+} // namespace git
+
+#endif
+
+// vi:ts=4:sw=4:sts=4:et
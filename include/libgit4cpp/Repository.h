@@ -25,45 +25,76 @@
 #ifndef LIBGIT4CPP_REPOSITORY_H_
 #define LIBGIT4CPP_REPOSITORY_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include <git2.h>
-#include <gul14/escape.h>
+#include <gul14/optional.h>
 
+#include "libgit4cpp/BlobContent.h"
+#include "libgit4cpp/BranchTracking.h"
+#include "libgit4cpp/CancellationToken.h"
+#include "libgit4cpp/CheckoutOptions.h"
+#include "libgit4cpp/CloneOptions.h"
+#include "libgit4cpp/CommitLog.h"
+#include "libgit4cpp/Diff.h"
+#include "libgit4cpp/FetchOptions.h"
+#include "libgit4cpp/LibraryContext.h"
 #include "libgit4cpp/Remote.h"
+#include "libgit4cpp/RemoteResult.h"
+#include "libgit4cpp/RepackOptions.h"
+#include "libgit4cpp/Result.h"
+#include "libgit4cpp/StatusList.h"
+#include "libgit4cpp/TreeEntry.h"
 #include "libgit4cpp/types.h"
 
 namespace git {
 
+enum class BranchType {all = 0, local =1, remote=2};
+
 /**
- * Struct to express the git status for one file
+ * Options for Repository::open_existing().
+ *
+ * The defaults open exactly the repository at the given path: a work tree containing a
+ * .git directory or file, or a bare repository directory.
  */
-struct FileStatus
+struct OpenOptions
 {
-    std::string path_name; /// Relative path to file. If the path changed this value will have the shape "OLD_NAME -> NEW_NAME".
-    std::string handling;  /// Handling status of file [unchanged, unstaged, staged, untracked, ignored]
-    std::string changes;   /// Change status of file [new file, deleted, renamed, typechanged, modified, unchanged, ignored, untracked]
-
-    friend std::ostream& operator<<(std::ostream& stream, FileStatus const& state) {
-        stream << "FileStatus{ \"" << gul14::escape(state.path_name) << "\": " << state.handling << "; " << state.changes << " }";
-        return stream;
-    }
+    /// Search the parent directories for a repository (like git does).
+    bool search_parents = false;
+    /// Continue the search across filesystem boundaries (only with search_parents).
+    bool cross_filesystem = false;
+    /// Open the repository as bare, ignoring any work tree.
+    bool bare = false;
+    /// Do not append ".git" to the path when looking for the repository.
+    bool no_dotgit = false;
 };
 
-using RepoState = std::vector<FileStatus>; /// State of all files in the repo
+/**
+ * A set of file changes to be committed without using the work tree or the index.
+ *
+ * The keys are paths relative to the repository root with forward slashes as
+ * separators (e.g. "dir/file.txt"). A value holds the new content of the file; an empty
+ * optional removes the file.
+ *
+ * \see Repository::commit_files()
+ */
+using TreeChanges = std::map<std::string, gul14::optional<std::string>>;
 
-inline std::ostream& operator<<(std::ostream& stream, const RepoState& repostate)
+/// One commit of a batch created by Repository::commit_batch().
+struct BatchCommit
 {
-    stream << "RepoState {\n";
-    for (auto& e : repostate)
-        stream << e << '\n';
-    stream << "}";
-    return stream;
-}
-
-enum class BranchType {all = 0, local =1, remote=2};
+    TreeChanges changes;  ///< Files to add, overwrite, or remove
+    std::string message;  ///< Message for the commit
+};
 
 
 /**
@@ -79,6 +110,8 @@ enum class BranchType {all = 0, local =1, remote=2};
 class Repository
 {
 public:
+    class IndexTransaction;
+    class ReferenceTransaction;
 
     /**
      * Constructor which specifies the root dir of the git repository.
@@ -86,6 +119,41 @@ public:
      */
     explicit Repository(const std::filesystem::path& file_path);
 
+    /**
+     * Open an existing repository without side effects.
+     *
+     * In contrast to the constructor, this never initializes a repository or creates a
+     * commit, and the commit signature is only read from the configuration when it is
+     * first needed. This makes it the cheapest way to open many repositories for
+     * reading.
+     *
+     * \param path     Path to the repository (the work tree or a bare repository)
+     * \param options  Flags controlling how the repository is found
+     * \returns a Repository object whose get_path() is the root of the work tree that
+     *          has been found (or the repository directory if it is bare).
+     * \exception Error is thrown if no repository is found (code GIT_ENOTFOUND) or if it
+     *            cannot be opened.
+     */
+    static Repository open_existing(const std::filesystem::path& path,
+        const OpenOptions& options = OpenOptions{ });
+
+    /**
+     * Clone a repository and return a Repository object for the clone.
+     *
+     * In contrast to the constructor, no initial commit is created. If a single branch
+     * is requested without naming it, the remote is asked for its default branch first.
+     *
+     * \param url      Address of the repository to clone (URL or local path)
+     * \param path     Directory to clone into (must not exist or be empty)
+     * \param options  Options for depth, branch selection, checkout, and local clones
+     *
+     * \exception Error is thrown if the clone fails, if a shallow clone is requested with
+     *            a libgit2 version older than 1.7, or (with code GIT_EUSER) if the
+     *            progress callback cancelled the clone.
+     */
+    static Repository clone(const std::string& url, const std::filesystem::path& path,
+        const CloneOptions& options = CloneOptions{ });
+
     /**
      * Reset all knowledge this object knows about the repository and load the knowledge again.
      */
@@ -153,18 +221,114 @@ public:
      */
    std::vector <int> add_files(const std::vector<std::filesystem::path>& filepaths);
 
+    /**
+     * Stage specific files, hashing and writing their contents on several threads.
+     *
+     * This function behaves like add_files(const std::vector<std::filesystem::path>&),
+     * but the blobs of regular files and symbolic links are written to the object
+     * database by a pool of worker threads. Afterwards, the resulting entries are
+     * inserted into the index in a single pass. Each worker opens its own handle to the
+     * repository. Files that cannot be handled this way (e.g. deleted files or
+     * submodules) are staged serially as usual, and if the index contains conflicts, no
+     * parallelization takes place at all.
+     *
+     * \param filepaths  List of files. Either relative to repository root or absolute.
+     * \param nr_threads Number of worker threads. 0 selects the number of hardware
+     *                   threads, 1 stages all files on the calling thread.
+     * \return list of indices. An index from the filepaths vector is returned if
+     *          the staging of the file failed. Returns an empty vector if all
+     *          files were staged successfully.
+     */
+    std::vector<int> add_files(const std::vector<std::filesystem::path>& filepaths,
+        unsigned int nr_threads);
+
     /**
      * Return the commit message of the HEAD commit.
      * \return message of last commit (=HEAD)
      */
     std::string get_last_commit_message();
 
+    /**
+     * Walk the commit history.
+     *
+     * The returned CommitLog is evaluated lazily: commits are only looked up when they
+     * are requested, so browsing the first page of a long history is cheap.
+     *
+     * \code
+     * LogOptions opt;
+     * opt.paths = { "src" };
+     * opt.page_size = 10;
+     * for (const auto& commit : repo.log(opt).next_page())
+     *     std::cout << commit.summary() << "\n";
+     * \endcode
+     *
+     * \param options  Start revision, sort order, path filter and page size
+     * \returns a CommitLog that must not outlive this repository.
+     * \exception Error is thrown if the start revision cannot be resolved.
+     */
+    CommitLog log(const LogOptions& options = LogOptions{ });
+
     /**
      * Commit staged changes to the master branch of the git repository.
      * \param commit_message Customized message for the commit
      */
     void commit(const std::string& commit_message);
 
+    /**
+     * Commit files from memory without touching the work tree or the index.
+     *
+     * The blobs are written directly into the object database and the new tree is
+     * built from the tree of the current HEAD commit (or from an empty tree if HEAD is
+     * unborn) via tree builders. Only the directories that contain changed files are
+     * rewritten. HEAD is then advanced to the new commit.
+     *
+     * This also works on bare repositories. In a repository with a work tree, the index
+     * and the work tree are left unchanged, i.e. they subsequently appear to revert the
+     * committed changes until they are updated, e.g. with reset(0).
+     *
+     * \code
+     * repo.commit_files({ { "config/settings.json", "{ }" },
+     *                     { "obsolete.txt", gul14::nullopt } }, "Update settings");
+     * \endcode
+     *
+     * \param files           Files to add, overwrite, or remove
+     * \param commit_message  Message for the commit
+     * \return the ID of the new commit.
+     * \exception Error is thrown if a path is invalid or the commit cannot be created.
+     */
+    git_oid commit_files(const TreeChanges& files, const std::string& commit_message);
+
+    /**
+     * Create a linear chain of commits from memory in one pass.
+     *
+     * This is much faster than calling commit_files() or add_files() and commit() for
+     * each record: each tree is built from the previous one via tree builders, HEAD is
+     * resolved once at the start and updated once at the end, and the index is written
+     * at most once.
+     *
+     * The first commit uses the current HEAD commit as its parent (none if HEAD is
+     * unborn), and each further commit the previous one. If HEAD has been moved by
+     * someone else in the meantime, HEAD is not updated and an exception is thrown.
+     *
+     * \code
+     * std::vector<BatchCommit> events;
+     * for (const auto& event : audit_log)
+     *     events.push_back({ { { event.file, event.content } }, event.description });
+     * repo.commit_batch(events);
+     * \endcode
+     *
+     * \param records       Changes and messages of the commits, oldest first
+     * \param update_index  If true, update the index entries of all changed paths to
+     *                      match the last commit, so that they do not appear to be
+     *                      reverted (other staged changes are kept). Ignored for bare
+     *                      repositories. The work tree is never touched.
+     * \return the IDs of the new commits, in the same order as the records.
+     * \exception Error is thrown if a path is invalid, if a commit cannot be created, or
+     *            if HEAD has moved. In these cases, HEAD and the index remain unchanged.
+     */
+    std::vector<git_oid> commit_batch(const std::vector<BatchCommit>& records,
+        bool update_index = true);
+
     /**
      * Hard reset of repository.
      * \param nr_of_commits number of commits to jump back
@@ -191,6 +355,26 @@ public:
      */
     gul14::optional<Remote> get_remote(const std::string& remote_name) const;
 
+    /**
+     * Look up a git remote by name without throwing.
+     * \returns the Remote, or the libgit2 error code (e.g. GIT_ENOTFOUND if there is no
+     *          such remote, GIT_EINVALIDSPEC if the name is invalid).
+     * \see Result
+     */
+    Result<Remote> try_get_remote(const std::string& remote_name) const;
+
+    /**
+     * Resolve a revision (e.g. "HEAD~2", "refs/heads/main", "v1.0") to the ID of the
+     * object it points to without throwing.
+     *
+     * This is the cheap way to probe for references that may not exist, e.g. in a loop.
+     *
+     * \returns the object ID, or the libgit2 error code (e.g. GIT_ENOTFOUND,
+     *          GIT_EAMBIGUOUS, GIT_EINVALIDSPEC).
+     * \see Result
+     */
+    Result<git_oid> try_resolve(const std::string& revision) const;
+
     /**
      * Return a list of all configured remote repositories.
      * \exception Error is thrown if the list cannot be retrieved.
@@ -212,29 +396,144 @@ public:
      * "HEAD:refs/heads/main" pushes HEAD (whatever is currently checked out in the local
      * working directory) to the remote branch "main".
      *
+     * If the remote has been connected with Remote::connect(), the connection is reused
+     * (and reopened in push direction if necessary); otherwise a connection is opened for
+     * this push only.
+     *
      * \param remote   The git remote to push to (e.g. obtained by get_remote())
      * \param refspec  The refspec to push (e.g. "HEAD" or "refs/heads/main")
      */
     void push(const Remote& remote, const std::string& refspec = "HEAD:refs/heads/main");
 
-#if 0
     /**
-     * Pull changes from the remote repository.
-     * \param addr Address of the git repository host
+     * Download objects and references from the specified remote ("git fetch").
+     *
+     * If the remote has been connected with Remote::connect(), the connection is reused;
+     * otherwise a connection is opened for this fetch only.
+     *
+     * \code
+     * FetchOptions opt;
+     * opt.prune = true;
+     * opt.on_progress = [](const TransferProgress& p) {
+     *     std::cout << p.received_objects << "/" << p.total_objects << "\r";
+     *     return true; // continue
+     * };
+     * auto result = repo.fetch(remote, { }, opt);
+     *
+     * // Later: only download what changed since then
+     * opt.only_changed_since = &result.remote_references;
+     * auto next = repo.fetch(remote, { }, opt);
+     * if (next.up_to_date)
+     *     std::cout << "Nothing to do\n";
+     * \endcode
+     *
+     * \param remote    The git remote to fetch from (e.g. obtained by get_remote())
+     * \param refspecs  The refspecs to fetch (e.g. "+refs/heads/main:refs/heads/backup").
+     *                  If empty, the fetch refspecs configured for the remote are used.
+     * \param options   Progress callback, depth, pruning, tag handling and incremental
+     *                  negotiation (see FetchOptions)
+     * \returns the updated references, transfer statistics and the current references on
+     *          the remote.
+     * \exception Error is thrown if the fetch fails or is cancelled by the progress
+     *            callback (with error code GIT_EUSER).
      */
-    void pull();
+    FetchResult fetch(const Remote& remote, const std::vector<std::string>& refspecs = { },
+        const FetchOptions& options = FetchOptions{ });
 
     /**
-     * Clone a repository.
-     * \param addr Address of the git repository host
+     * Push to a remote asynchronously.
+     *
+     * The push runs on a separate thread with its own handle of the repository, so the
+     * remote is identified by name. The Repository object may be used while the push is
+     * in progress.
+     *
+     * \code
+     * CancellationToken token;
+     * auto done = repo.push_async("origin", { "HEAD:refs/heads/main" }, token);
+     * // ... later, e.g. on shutdown:
+     * token.cancel();
+     * \endcode
+     *
+     * \param remote_name  Name of the remote (e.g. "origin")
+     * \param refspecs     The refspecs to push
+     * \param token        Token for cancelling the push. Cancellation takes effect the
+     *                     next time libgit2 reports progress or asks for credentials.
+     * \returns a future that becomes ready when the push is complete. get() throws an
+     *          Error if the push failed, or an Error with code GIT_EUSER if it was
+     *          cancelled.
+     */
+    std::future<void> push_async(const std::string& remote_name,
+        const std::vector<std::string>& refspecs = { "HEAD:refs/heads/main" },
+        CancellationToken token = CancellationToken{ });
+
+    /**
+     * Fetch from a remote asynchronously.
+     *
+     * This works like push_async(), with the fetch behaving like fetch(). Returning false
+     * from the progress callback in the options cancels the fetch just like the token.
+     * The callbacks are invoked on the worker thread.
+     *
+     * \param remote_name  Name of the remote (e.g. "origin")
+     * \param refspecs     The refspecs to fetch (empty: the configured refspecs)
+     * \param options      Fetch options (copied; only_changed_since must stay alive until
+     *                     the fetch is complete)
+     * \param token        Token for cancelling the fetch
+     * \returns a future for the result of the fetch.
+     */
+    std::future<FetchResult> fetch_async(const std::string& remote_name,
+        const std::vector<std::string>& refspecs = { },
+        const FetchOptions& options = FetchOptions{ },
+        CancellationToken token = CancellationToken{ });
+
+    /**
+     * Push the same refspecs to several remotes concurrently.
+     *
+     * The remotes are processed on a pool of worker threads. Each worker opens its own
+     * handle of the repository, so this object is not used by the workers and the
+     * remotes are looked up by name. Errors are not thrown, but reported per remote.
+     *
+     * \code
+     * auto results = repo.push_to_remotes({ "mirror1", "mirror2", "backup" },
+     *                                     { "refs/heads/main:refs/heads/main" }, 4);
+     * for (const auto& r : results)
+     * {
+     *     if (not r.ok)
+     *         std::cerr << r.remote_name << ": " << r.error_message << "\n";
+     * }
+     * \endcode
+     *
+     * \param remote_names  Names of the remotes to push to
+     * \param refspecs      The refspecs to push to each remote
+     * \param nr_threads    Maximum number of worker threads (0 = number of CPU cores)
+     * \returns one result per remote, in the same order as remote_names.
+     */
+    std::vector<RemoteResult> push_to_remotes(const std::vector<std::string>& remote_names,
+        const std::vector<std::string>& refspecs, unsigned int nr_threads = 0);
+
+    /**
+     * Fetch from several remotes concurrently.
+     *
+     * This works like push_to_remotes(), with each fetch behaving like fetch(). To avoid
+     * lock contention between the workers, FETCH_HEAD is never written. The progress
+     * callback in the options may be called from several threads at the same time.
+     *
+     * \param remote_names  Names of the remotes to fetch from
+     * \param refspecs      The refspecs to fetch (empty: the configured refspecs)
+     * \param options       Options applied to every fetch
+     * \param nr_threads    Maximum number of worker threads (0 = number of CPU cores)
+     * \returns one result per remote, in the same order as remote_names.
      */
-    void clone_repo(const std::string& url, const std::filesystem::path& repo_path);
+    std::vector<RemoteResult> fetch_from_remotes(
+        const std::vector<std::string>& remote_names,
+        const std::vector<std::string>& refspecs = { },
+        const FetchOptions& options = FetchOptions{ }, unsigned int nr_threads = 0);
 
+#if 0
     /**
-     * Check if remote and local branch are in same state.
-     * \param branch_name
+     * Pull changes from the remote repository.
+     * \param addr Address of the git repository host
      */
-    bool branch_up_to_date(const std::string& branch_name);
+    void pull();
 
 #endif
 
@@ -267,6 +566,36 @@ public:
      */
     std::vector<std::string> list_branches(BranchType type_flag = BranchType::all);
 
+    /**
+     * Count the commits by which two branches have diverged.
+     *
+     * \code
+     * auto counts = repo.ahead_behind("main");
+     * if (not counts.up_to_date())
+     *     std::cout << counts.ahead << " ahead, " << counts.behind << " behind\n";
+     * \endcode
+     *
+     * \param local     Revision of the local side (e.g. a branch name or "HEAD")
+     * \param upstream  Revision of the upstream side (e.g. "origin/main"). If empty, the
+     *                  configured upstream branch of the local branch is used.
+     * \exception Error is thrown if a revision cannot be resolved, or if no upstream is
+     *            given and the local branch has none.
+     */
+    AheadBehind ahead_behind(const std::string& local, const std::string& upstream = "");
+
+    /**
+     * Determine the relation of every local branch to its upstream branch.
+     *
+     * This is a single pass over the local branches. The commit graph is only walked for
+     * distinct pairs of local and upstream commits, and not at all for branches that are
+     * up to date, so that many branches pointing to the same commits cost little more
+     * than one.
+     *
+     * \returns one entry per local branch, in the order of list_branches().
+     * \exception Error is thrown if the branches cannot be listed or compared.
+     */
+    std::vector<BranchTracking> ahead_behind_all();
+
     /**
      * Check out selected files from branch.
      * The path parameter takes a list of files, directories. It supports pattern matching
@@ -279,12 +608,63 @@ public:
         const std::vector<std::string>& paths = {"*"});
 
     /**
-     * Switch branches by setting HEAD to an existing branch.
-     * \attention If the branch doesn't exist yet, no error will be thrown.
-     *            The HEAD will then be attached to an unborn branch.
+     * Check out files from a branch without moving HEAD.
+     *
+     * In CheckoutMode::safe, the files that differ between HEAD and the tip of the branch
+     * are determined first, and only these are written to the work tree and the index.
+     * Files with local modifications that would be overwritten cause an Error with code
+     * GIT_ECONFLICT; they are reported to the notify callback beforehand.
+     *
+     * \param branch_name  The branch to check out
+     * \param options      Checkout mode, paths, and notify callback
+     * \exception Error is thrown if the checkout fails or is cancelled by the callback
+     *            (code GIT_EUSER).
+     */
+    void checkout(const std::string& branch_name, const CheckoutOptions& options);
+
+    /**
+     * Switch branches by updating the work tree and setting HEAD to an existing branch.
+     *
+     * The work tree and the index are updated in a single checkout of the branch, using
+     * HEAD as a baseline: in CheckoutMode::safe (the default), only the files that differ
+     * between the two branches are written, and local modifications of other files are
+     * carried over to the new branch. HEAD is only moved if the checkout succeeds.
+     *
      * \param branch_name ID, shorthand or full reference name of branch
-    */
-   void switch_branch(const std::string& branch_name);
+     * \param options     Checkout mode, paths, and notify callback. Use
+     *                    CheckoutMode::force to discard all local modifications.
+     * \exception Error is thrown if the branch does not exist, or if the checkout fails
+     *            (code GIT_ECONFLICT if local modifications are in the way).
+     */
+    void switch_branch(const std::string& branch_name,
+        const CheckoutOptions& options = CheckoutOptions{ });
+
+    /**
+     * Pack all loose references into the packed-refs file.
+     *
+     * Afterwards, functions like list_branches() read a single file instead of one file
+     * per reference. This is useful after creating many references, e.g. with a
+     * ReferenceTransaction.
+     *
+     * \exception Error is thrown if the references cannot be packed.
+     */
+    void pack_refs();
+
+    /**
+     * Consolidate all loose objects of the object database into a new pack file.
+     *
+     * Every commit creates a handful of loose objects, each in its own file. In a
+     * repository that commits a lot, object lookups and status() become slower over
+     * time. This function does in-process what "git repack -d" would do: it writes all
+     * loose objects into a single pack file with an index, and then deletes them.
+     * Existing pack files are left as they are; optionally, a multi-pack-index is
+     * written to speed up lookups across all of them.
+     *
+     * \exception Error is thrown if the pack cannot be written, if a multi-pack-index is
+     *            requested but not supported by libgit2, or if the progress callback
+     *            cancels the operation (code GIT_EUSER).
+     */
+    RepackResult repack(const RepackOptions& options = RepackOptions{ });
 
     /**
      * Remove all entries from the index under a given directory.
@@ -325,23 +705,280 @@ public:
      * -- file name
      * -- change status (has the file changed)
      * -- handling status (what git will do with it)
+     * \param options  Select which files are reported (by default all of them)
      * \return vector of file status for each file.
+     * \see status_list() for a more compact representation
+     */
+    RepoState status(const StatusOptions& options = StatusOptions{ });
+
+    /**
+     * Return the current git status in a compact form.
+     *
+     * This function reports the same files as status(), but the status of each file is
+     * expressed by enums and all path names are stored in a single string pool. This
+     * avoids several heap allocations per file and is therefore the preferred choice
+     * for large work trees.
+     *
+     * \param options  Select which files are reported (by default all of them)
+     * \exception Error is thrown if the status cannot be determined.
+     */
+    StatusList status_list(const StatusOptions& options = StatusOptions{ });
+
+    /**
+     * Call a function for the git status of each file, without storing the full list.
+     *
+     * The entries are translated one by one from the libgit2 status list and handed to
+     * the visitor as they are reached. No RepoState or StatusList is built, so the
+     * memory consumption of the wrapper stays constant regardless of the number of
+     * files.
+     *
+     * \code
+     * std::size_t nr_staged = 0;
+     * repo.for_each_status([&nr_staged](const FileStatusView& entry) {
+     *         if (entry.handling == FileHandling::staged)
+     *             ++nr_staged;
+     *         return true; // continue
+     *     });
+     * \endcode
+     *
+     * \param visitor  Function to be called for each file. The string views in its
+     *                 argument are only valid during the call. If the visitor returns
+     *                 false, the enumeration stops.
+     * \param options  Select which files are reported (by default all of them)
+     * \return the number of entries passed to the visitor.
+     * \exception Error is thrown if the status cannot be determined. Exceptions thrown by
+     *            the visitor are propagated to the caller.
      */
-    RepoState status();
+    std::size_t for_each_status(const std::function<bool(const FileStatusView&)>& visitor,
+        const StatusOptions& options = StatusOptions{ });
+
+    /**
+     * Determine if the index or the work tree contain any changes with respect to HEAD.
+     *
+     * The function stops examining files as soon as the first change is found, so it is
+     * much cheaper than checking if status_list() returns any changed files. Ignored
+     * and unmodified files are never considered, regardless of the corresponding
+     * fields in \c options. Untracked files count as a change if
+     * \c options.include_untracked is set.
+     *
+     * \param options  Restrict the check to certain files (e.g. via pathspecs)
+     * \exception Error is thrown if the repository state cannot be examined.
+     */
+    bool is_dirty(const StatusOptions& options = StatusOptions{ });
+
+    /**
+     * Read the content of a file as of a given revision.
+     *
+     * Without filters, no copy of the content is made: the returned object keeps the
+     * libgit2 blob alive and provides a view onto its data.
+     *
+     * \param revision  Revision to read from (e.g. "HEAD", "main~3", a commit ID)
+     * \param path      Path of the file relative to the repository root, with forward
+     *                  slashes (e.g. "dir/file.txt")
+     * \param options   Whether to apply the configured filters
+     * \exception Error is thrown if the revision cannot be resolved, or if the path does
+     *            not exist (code GIT_ENOTFOUND) or is not a file.
+     */
+    BlobContent read_blob(const std::string& revision, const std::string& path,
+        const BlobReadOptions& options = BlobReadOptions{ });
+
+    /**
+     * Read the content of a file as of a given revision without throwing.
+     *
+     * This works like read_blob(), but on failure only the libgit2 error code is
+     * returned: GIT_ENOTFOUND if the revision or the path does not exist or if the path
+     * is not a file, or the code of any other libgit2 error.
+     *
+     * \see Result
+     */
+    Result<BlobContent> try_read_blob(const std::string& revision,
+        const std::string& path, const BlobReadOptions& options = BlobReadOptions{ });
+
+    /**
+     * Pass the content of a file as of a given revision to a consumer in chunks.
+     *
+     * This works like read_blob(), but hands the content to the consumer in pieces of at
+     * most \c options.chunk_size bytes, e.g. for writing it to a socket. The chunks are
+     * views onto the blob data and are only valid during the call. libgit2 always
+     * inflates a blob completely, so this saves copies, not memory.
+     *
+     * \param revision  Revision to read from
+     * \param path      Path of the file relative to the repository root
+     * \param consumer  Called for each chunk; return false to stop
+     * \param options   Whether to apply the configured filters, and the chunk size
+     * \returns the number of bytes passed to the consumer.
+     * \exception Error is thrown under the same conditions as for read_blob().
+     */
+    std::size_t stream_blob(const std::string& revision, const std::string& path,
+        const std::function<bool(gul14::string_view chunk)>& consumer,
+        const BlobReadOptions& options = BlobReadOptions{ });
+
+    /**
+     * List the contents of a directory as of a given revision.
+     *
+     * Recently used trees are kept in a small cache, so that browsing several
+     * directories of the same revision does not parse the same trees again.
+     *
+     * \code
+     * for (const TreeEntry& entry : repo.list_tree("HEAD", "src"))
+     *     std::cout << entry.path << (entry.is_directory() ? "/\n" : "\n");
+     * \endcode
+     *
+     * \param revision   Revision to read from (e.g. "HEAD", "v1.0", a commit ID)
+     * \param dir        Directory relative to the repository root (empty for the root)
+     * \param recursive  If true, also list the contents of all subdirectories
+     *                   (each directory is listed before its contents)
+     * \returns the entries in git's tree order, with paths relative to the repository
+     *          root.
+     * \exception Error is thrown if the revision cannot be resolved, or if the directory
+     *            does not exist (code GIT_ENOTFOUND) or is not a directory.
+     */
+    std::vector<TreeEntry> list_tree(const std::string& revision,
+        const std::string& dir = "", bool recursive = false);
+
+    /**
+     * Look up a file or directory as of a given revision.
+     *
+     * \param revision  Revision to read from
+     * \param path      Path relative to the repository root (e.g. "dir/file.txt")
+     * \returns the tree entry, or an empty optional if the path does not exist.
+     * \exception Error is thrown if the revision cannot be resolved.
+     * \see list_tree()
+     */
+    gul14::optional<TreeEntry> lookup_path(const std::string& revision,
+        const std::string& path);
+
+    /**
+     * Compare the trees of two revisions.
+     *
+     * \code
+     * // Which files did the last commit touch?
+     * for (const auto& delta : repo.diff("HEAD~1", "HEAD").deltas)
+     *     std::cout << delta << "\n";
+     * \endcode
+     *
+     * \param from     Revision for the old side (e.g. "HEAD~1", a branch name or an ID)
+     * \param to       Revision for the new side
+     * \param options  Mode, path filter, rename detection, and patch callbacks
+     * \exception Error is thrown if a revision cannot be resolved or the diff fails.
+     *            Exceptions thrown by the callbacks are propagated.
+     */
+    DiffResult diff(const std::string& from, const std::string& to,
+        const DiffOptions& options = DiffOptions{ });
+
+    /**
+     * Compare the HEAD commit with the index (the staged changes, like
+     * "git diff --cached"). An unborn HEAD is compared as an empty tree.
+     * \see diff()
+     */
+    DiffResult diff_index(const DiffOptions& options = DiffOptions{ });
+
+    /**
+     * Compare the index with the work tree (the unstaged changes, like "git diff").
+     * Untracked files are only reported if \c options.include_untracked is set.
+     * \see diff()
+     */
+    DiffResult diff_workdir(const DiffOptions& options = DiffOptions{ });
+
+    /**
+     * Move constructor.
+     *
+     * The underlying libgit2 repository is handed over, so Remote, CommitLog and
+     * BlobContent objects obtained from the moved-from object stay valid. The moved-from
+     * object may only be destroyed or assigned to. A repository must not be moved while
+     * an IndexTransaction or ReferenceTransaction refers to it.
+     */
+    Repository(Repository&& other) noexcept;
+
+    /// Move assignment (see the move constructor).
+    Repository& operator=(Repository&& other) noexcept;
+
+    Repository(const Repository&) = delete;
+    Repository& operator=(const Repository&) = delete;
 
     /// Destructor
     ~Repository();
 
 private:
+    friend class RepositoryPool;
+
+    /// Keeps libgit2 initialized for the lifetime of the repository (destroyed last).
+    LibraryContext library_;
 
     /// Path to the repository.
     std::filesystem::path repo_path_;
 
     /// Pointer which holds all infos of the active repository.
-    LibGitRepository repo_{ nullptr, git_repository_free };
+    LibGitRepository repo_;
+
+    /// Signature used in commits (loaded on first use, see get_signature()).
+    LibGitSignature my_signature_;
+
+    /// The index of the repository (opened on first use).
+    LibGitIndex index_;
+
+    /// Number of active IndexTransaction objects.
+    unsigned int index_transaction_depth_{ 0 };
+
+    /// True if the index has been modified in memory during an IndexTransaction.
+    bool index_dirty_{ false };
+
+    /// True if a (nested) IndexTransaction has been rolled back.
+    bool index_rollback_{ false };
+
+    /// Identity and modification time of a file (zero if the file does not exist).
+    struct FileStamp
+    {
+        std::uint64_t inode = 0;
+        std::int64_t mtime_ns = 0;
+
+        bool operator==(const FileStamp& o) const noexcept
+        {
+            return inode == o.inode && mtime_ns == o.mtime_ns;
+        }
+    };
+
+    /// Stamps of the files that determine where HEAD points to.
+    struct RefStamps
+    {
+        FileStamp head;        ///< HEAD
+        FileStamp ref;         ///< loose file of the branch HEAD points to
+        FileStamp packed_refs; ///< packed-refs
+
+        bool operator==(const RefStamps& o) const noexcept
+        {
+            return head == o.head && ref == o.ref && packed_refs == o.packed_refs;
+        }
+    };
+
+    /// Cached state of HEAD, see head_commit().
+    struct HeadCache
+    {
+        bool valid = false;
+        std::string ref_name;   ///< Full name of the reference HEAD resolves to
+        git_oid id;             ///< ID of the HEAD commit
+        LibGitCommit commit;    ///< Looked up on first use
+        RefStamps stamps;
+    };
+
+    HeadCache head_cache_;
 
-    /// Signature used in commits.
-    LibGitSignature my_signature_{ nullptr, git_signature_free };
+    /// Maximum number of trees kept by tree_cache_.
+    static constexpr std::size_t tree_cache_capacity_ = 16;
+
+    /// Recently used trees, most recently used first (see cached_tree()).
+    std::list<LibGitTree> tree_cache_;
+
+    /**
+     * Construct a Repository object for an already opened libgit2 repository.
+     * If no signature is given, it is loaded on first use (see get_signature()).
+     */
+    Repository(const std::filesystem::path& file_path, LibGitRepository repo,
+        LibGitSignature signature = LibGitSignature{ });
+
+    /// Release all libgit2 objects, the repository last (used by the destructor and
+    /// reset_repo()).
+    void release() noexcept;
 
     /**
      * Initialize a new git repository and commit all files in its path.
@@ -376,31 +1013,267 @@ private:
      */
     void make_signature();
 
+    /// Return the signature for commits, loading it on first use via make_signature().
+    git_signature* get_signature();
+
+    /**
+     * Check out a commit into the index and the work tree, using the HEAD commit as the
+     * baseline (see checkout(const std::string&, const CheckoutOptions&)).
+     */
+    void checkout_commit(git_commit* target, const CheckoutOptions& options);
+
+    /**
+     * Push refspecs to a remote (shared by push(), push_async() and push_to_remotes()).
+     * The token may be null.
+     */
+    static void push_to(const Remote& remote, const std::vector<std::string>& refspecs,
+        const CancellationToken* token = nullptr);
+
+    /**
+     * Fetch from a remote (shared by fetch(), fetch_async() and fetch_from_remotes()).
+     * The token may be null.
+     */
+    static FetchResult fetch_from(const Remote& remote,
+        const std::vector<std::string>& refspecs, const FetchOptions& options,
+        const CancellationToken* token = nullptr);
+
+    /**
+     * Return the tree with the given ID, from tree_cache_ if possible.
+     * \returns a non-owning pointer that stays valid until the next call.
+     * \exception Error is thrown if the tree cannot be read.
+     */
+    git_tree* cached_tree(const git_oid& id);
+
     /**
-     * Translate all status information for each submodule into String.
-     * \param status C-type status of all submodules from libgit
-     * \return A vector of dynamic length which contains a status struct
+     * Return a directory of the tree with the given root ID via cached_tree().
+     * \returns the directory tree, or null if the path does not exist or is not a
+     *          directory.
+     * \exception Error is thrown if a tree cannot be read.
      */
-    RepoState collect_status(LibGitStatusList& status) const;
+    git_tree* cached_directory(const git_oid& root_id, const std::string& dir);
 
     /**
-     * Check if the file from the status entry is not staged and collect the status in filestats.
-     * \note this function is solely called by collect_status. It has no other purpose.
-     * \param filestats a structure which will be filled with the status of the file if the file is unstaged
-     * \param s status of the file. A struct which contains flags about every possible state
-     * \return true if file is unstaged (and filestats initialized), else false
+     * Return the commit HEAD points to, or null if HEAD is unborn.
+     *
+     * The result is cached. The cache is invalidated by member functions that move HEAD
+     * and also whenever the HEAD, loose branch or packed-refs files have been modified
+     * since, so that changes by other processes are noticed.
+     *
+     * \returns a non-owning pointer that stays valid until HEAD changes.
+     * \exception Error is thrown if HEAD cannot be resolved.
+     */
+    git_commit* head_commit_or_null();
+
+    /**
+     * Return the commit HEAD points to.
+     * \exception Error is thrown if HEAD is unborn or cannot be resolved.
+     * \see head_commit_or_null()
+     */
+    git_commit* head_commit();
+
+    /// Update the HEAD cache after this object has moved HEAD to the given commit.
+    void update_head_cache(const git_oid& commit_id);
+
+    /// Drop the cached HEAD state.
+    void invalidate_head_cache() noexcept;
+
+    /// Determine the current stamps of the files that determine HEAD.
+    RefStamps get_ref_stamps(const std::string& ref_name) const;
+
+    /**
+     * Return the index of the repository, opening it on first use.
+     * \exception Error is thrown if the index cannot be opened.
+     */
+    git_index* get_index();
+
+    /**
+     * Write the index to disk, or only mark it as modified if an IndexTransaction is
+     * active.
+     * \exception Error is thrown if the index cannot be written.
+     */
+    void write_index();
+
+    /// Leave an IndexTransaction, writing or re-reading the index for the outermost one.
+    void end_index_transaction(bool rollback);
+
+};
+
+/**
+ * A scope in which all modifications of the index are collected in memory.
+ *
+ * Normally, each call to Repository::add(), add_files(), update(), remove_files(),
+ * remove_directory(), or commit() writes the complete index file to disk. While an
+ * IndexTransaction is alive, these functions only modify the in-memory index, and the
+ * index file is written exactly once when the transaction is committed or goes out of
+ * scope. Other functions of the Repository (e.g. status()) already see the in-memory
+ * state.
+ *
+ * \code
+ * {
+ *     Repository::IndexTransaction transaction{ repo };
+ *     for (const auto& file : thousands_of_files)
+ *         repo.add_files({ file });
+ *     repo.commit("Add many files");
+ * } // index is written here
+ * \endcode
+ *
+ * If the scope is left because of an exception, the in-memory changes are discarded
+ * by re-reading the index from disk (commits that have already been created are not
+ * undone). Transactions may be nested; only the outermost one writes or discards the
+ * index, and it discards everything if any inner transaction has been rolled back.
+ *
+ * The Repository must outlive the transaction.
+ */
+class Repository::IndexTransaction
+{
+public:
+    /// Begin an index transaction on the given repository.
+    explicit IndexTransaction(Repository& repo);
+
+    /// Commit the transaction unless it has already ended or an exception is in flight.
+    ~IndexTransaction();
+
+    IndexTransaction(const IndexTransaction&) = delete;
+    IndexTransaction& operator=(const IndexTransaction&) = delete;
+
+    /**
+     * End the transaction and write the modified index to disk.
+     * Does nothing if the transaction has already ended.
+     * \exception Error is thrown if the index cannot be written.
+     */
+    void commit();
+
+    /**
+     * End the transaction and discard the in-memory modifications of the index.
+     * Does nothing if the transaction has already ended.
+     * \exception Error is thrown if the index cannot be re-read.
+     */
+    void rollback();
+
+private:
+    Repository& repo_;
+    int nr_uncaught_exceptions_;
+    bool active_{ true };
+};
+
+/**
+ * A set of reference updates that is applied all at once.
+ *
+ * Creating or moving references one by one (e.g. with Repository::new_branch()) looks
+ * up, locks, and writes each reference file separately. A ReferenceTransaction locks
+ * each reference when an update is staged and writes all of them together in commit().
+ * Until then, no reference is changed and other processes cannot modify the locked
+ * references.
+ *
+ * \code
+ * Repository::ReferenceTransaction transaction{ repo };
+ * for (const auto& name : hundreds_of_branch_names)
+ *     transaction.create_branch(name, "main");
+ * transaction.remove("refs/heads/obsolete");
+ * transaction.commit(true); // write all references, then pack them
+ * \endcode
+ *
+ * If the transaction is destroyed without commit() or rollback(), it is committed
+ * unless an exception is in flight, like an IndexTransaction. Errors are only reported
+ * by an explicit call of commit(). Rolling back releases all locks without changing
+ * any reference. libgit2 does not update the references atomically: if writing one of
+ * them fails, the ones written before stay updated.
+ *
+ * The Repository must outlive the transaction.
+ */
+class Repository::ReferenceTransaction
+{
+public:
+    /**
+     * Begin a reference transaction on the given repository.
+     * \exception Error is thrown if the transaction cannot be created.
+     */
+    explicit ReferenceTransaction(Repository& repo);
+
+    /// Commit the transaction unless it has already ended or an exception is in flight.
+    ~ReferenceTransaction();
+
+    ReferenceTransaction(const ReferenceTransaction&) = delete;
+    ReferenceTransaction& operator=(const ReferenceTransaction&) = delete;
+
+    /**
+     * Stage the creation of a branch.
+     * \param branch_name  Short name of the new branch (e.g. "feature")
+     * \param start_point  Revision the branch points to (e.g. "HEAD", "main", an ID)
+     * \param force        Overwrite an existing branch of the same name
+     * \exception Error is thrown if the start point cannot be resolved, if the branch
+     *            exists and \c force is false, or if the reference cannot be locked.
+     */
+    void create_branch(const std::string& branch_name,
+        const std::string& start_point = "HEAD", bool force = false);
+
+    /**
+     * Stage the creation or update of a direct reference.
+     * \param ref_name     Full name of the reference (e.g. "refs/tags/v1.0")
+     * \param id           Object ID the reference points to
+     * \param log_message  Message for the reflog (empty: libgit2 default)
+     * \exception Error is thrown if the reference cannot be locked or updated.
+     */
+    void set_target(const std::string& ref_name, const git_oid& id,
+        const std::string& log_message = "");
+
+    /**
+     * Stage the creation or update of a direct reference to a revision.
+     * \param ref_name     Full name of the reference (e.g. "refs/heads/release")
+     * \param revision     Revision to point to (e.g. "HEAD~2", "main", an ID)
+     * \param log_message  Message for the reflog (empty: libgit2 default)
+     * \exception Error is thrown if the revision cannot be resolved or the reference
+     *            cannot be locked or updated.
+     */
+    void set_target(const std::string& ref_name, const std::string& revision,
+        const std::string& log_message = "");
+
+    /**
+     * Stage the creation or update of a symbolic reference.
+     * \param ref_name     Full name of the reference (e.g. "HEAD")
+     * \param target       Full name of the reference it points to
+     * \param log_message  Message for the reflog (empty: libgit2 default)
+     * \exception Error is thrown if the reference cannot be locked or updated.
+     */
+    void set_symbolic_target(const std::string& ref_name, const std::string& target,
+        const std::string& log_message = "");
+
+    /**
+     * Stage the removal of a reference.
+     * \param ref_name  Full name of the reference (e.g. "refs/heads/obsolete")
+     * \exception Error is thrown if the reference cannot be locked.
      */
-    static bool is_unstaged(FileStatus& filestats, const git_status_entry* s);
+    void remove(const std::string& ref_name);
+
+    /// Return the number of staged updates.
+    std::size_t size() const noexcept { return nr_updates_; }
 
     /**
-     * Check if the file from the status entry is not unstaged and collect the status in filestats.
-     * \note this function is solely called by collect_status. It has no other purpose.
-     * \param filestats a structure which will be filled with the status of the file if the file is staged
-     * \param s status of the file. A struct which contains flags about every possible state
-     * \return true if file is staged (and filestats initialized), else false
+     * End the transaction and write all staged updates.
+     * Does nothing if the transaction has already ended.
+     * \param pack_refs  Pack all loose references afterwards (see Repository::pack_refs())
+     * \exception Error is thrown if the references cannot be written or packed.
      */
-    static bool is_staged(FileStatus& filestats, const git_status_entry* s);
+    void commit(bool pack_refs = false);
+
+    /**
+     * End the transaction without changing any reference and release all locks.
+     * Does nothing if the transaction has already ended.
+     */
+    void rollback() noexcept;
+
+private:
+    Repository& repo_;
+    LibGitTransaction transaction_;
+    std::unordered_set<std::string> locked_refs_;
+    std::size_t nr_updates_{ 0 };
+    int nr_uncaught_exceptions_;
+
+    /// Lock a reference unless it has already been locked by this transaction.
+    void lock(const std::string& ref_name);
 
+    /// Throw an Error if the transaction has already ended.
+    void throw_if_ended() const;
 };
 
 } // namespace git
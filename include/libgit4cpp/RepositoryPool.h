@@ -0,0 +1,188 @@
+/**
+ * \file   RepositoryPool.h
+ * \date   Created on October 14, 2026
+ * \brief  Declaration of the RepositoryPool class.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef LIBGIT4CPP_REPOSITORYPOOL_H_
+#define LIBGIT4CPP_REPOSITORYPOOL_H_
+
+#include <cstddef>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "libgit4cpp/LibraryContext.h"
+#include "libgit4cpp/Repository.h"
+#include "libgit4cpp/types.h"
+
+namespace git {
+
+/**
+ * A pool of Repository objects for the same repository, for use by many threads.
+ *
+ * libgit2 objects must not be used by several threads at once, so each thread needs
+ * its own Repository object. Opening one per request is costly, and sharing one behind
+ * a mutex does not scale. A RepositoryPool opens Repository objects lazily and keeps
+ * them for reuse, either checked out for the duration of a request or bound to a
+ * thread:
+ *
+ * \code
+ * RepositoryPool pool{ "/path/to/repo" };
+ *
+ * // In a request handler running on any thread:
+ * {
+ *     auto repo = pool.acquire();
+ *     auto log = repo->log();
+ *     // ...
+ * } // the Repository goes back to the pool
+ *
+ * // Or, on a long-lived worker thread:
+ * Repository& repo = pool.for_this_thread();
+ * \endcode
+ *
+ * The repository must already exist; the pool never initializes a repository or
+ * creates commits. The commit signature is read from the git configuration once and
+ * shared by all Repository objects of the pool.
+ *
+ * All member functions are thread-safe. The pool must outlive all handles and all
+ * references returned by for_this_thread().
+ */
+class RepositoryPool
+{
+public:
+    class Handle;
+
+    /**
+     * Create a pool for the repository at the given path. No repository is opened yet.
+     * \param path      Path to the repository
+     * \param max_idle  Maximum number of idle Repository objects kept for reuse by
+     *                  acquire() (0: the number of hardware threads)
+     */
+    explicit RepositoryPool(std::filesystem::path path, std::size_t max_idle = 0);
+
+    RepositoryPool(const RepositoryPool&) = delete;
+    RepositoryPool& operator=(const RepositoryPool&) = delete;
+
+    ~RepositoryPool();
+
+    /**
+     * Check out a Repository object for exclusive use by the caller.
+     *
+     * An idle object is reused if available, otherwise a new one is opened. The object
+     * goes back to the pool when the handle is destroyed.
+     *
+     * \exception Error is thrown if the repository cannot be opened.
+     */
+    Handle acquire();
+
+    /**
+     * Return the Repository object bound to the calling thread, opening it on first use.
+     *
+     * The object stays bound to the thread until release_this_thread() is called or the
+     * pool is destroyed. It must not be passed to other threads.
+     *
+     * \exception Error is thrown if the repository cannot be opened.
+     */
+    Repository& for_this_thread();
+
+    /**
+     * Destroy the Repository object bound to the calling thread, if any.
+     * Call this before a thread that used for_this_thread() exits.
+     */
+    void release_this_thread();
+
+    /// Return the path to the repository.
+    const std::filesystem::path& get_path() const noexcept { return path_; }
+
+    /// Return the number of idle Repository objects available to acquire().
+    std::size_t idle_count() const;
+
+    /// Return the number of Repository objects opened by the pool so far.
+    std::size_t open_count() const;
+
+    /// Destroy all idle Repository objects.
+    void clear_idle();
+
+private:
+    /// Keeps libgit2 initialized for the lifetime of the pool (destroyed last).
+    LibraryContext library_;
+
+    std::filesystem::path path_;
+    std::size_t max_idle_;
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<Repository>> idle_;
+    std::map<std::thread::id, std::unique_ptr<Repository>> per_thread_;
+    std::size_t nr_opened_{ 0 };
+
+    /// Signature shared by all Repository objects (read on first open).
+    LibGitSignature signature_;
+
+    /// Open a new Repository object.
+    std::unique_ptr<Repository> open();
+
+    /// Return a Repository object to the idle list (or destroy it if the list is full).
+    void release(std::unique_ptr<Repository> repo) noexcept;
+};
+
+/**
+ * A Repository object checked out from a RepositoryPool.
+ *
+ * The handle gives exclusive access to the object and returns it to the pool when it
+ * is destroyed. Handles are movable but not copyable.
+ */
+class RepositoryPool::Handle
+{
+public:
+    Handle(Handle&& other) noexcept = default;
+    Handle& operator=(Handle&& other) noexcept;
+
+    /// Return the Repository object to the pool.
+    ~Handle();
+
+    /// Access the Repository object.
+    Repository& operator*() const noexcept { return *repo_; }
+
+    /// Access the Repository object.
+    Repository* operator->() const noexcept { return repo_.get(); }
+
+    /// Return a pointer to the Repository object (null for a moved-from handle).
+    Repository* get() const noexcept { return repo_.get(); }
+
+private:
+    friend class RepositoryPool;
+
+    RepositoryPool* pool_{ nullptr };
+    std::unique_ptr<Repository> repo_;
+
+    Handle(RepositoryPool* pool, std::unique_ptr<Repository> repo) noexcept
+        : pool_{ pool }, repo_{ std::move(repo) }
+    { }
+};
+
+} // namespace git
+
+#endif
+
+// vi:ts=4:sw=4:sts=4:et
@@ -0,0 +1,179 @@
+/**
+ * \file   Result.h
+ * \date   Created on October 14, 2026
+ * \brief  Declaration of the Result class template for non-throwing operations.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef LIBGIT4CPP_RESULT_H_
+#define LIBGIT4CPP_RESULT_H_
+
+#include <system_error>
+#include <utility>
+
+#include <gul14/optional.h>
+
+#include "libgit4cpp/Error.h"
+
+namespace git {
+
+/**
+ * The result of a non-throwing operation: either a value or an error code.
+ *
+ * The try_...() member functions of Repository return a Result instead of throwing an
+ * Error. On failure, they only store the libgit2 error code (in git_category()), so
+ * that probing for things that may not exist costs neither an exception nor the
+ * formatting of an error message.
+ *
+ * \code
+ * for (const auto& name : candidates)
+ * {
+ *     auto id = repo.try_resolve("refs/heads/" + name);
+ *     if (id)
+ *         std::cout << name << " -> " << git_oid_tostr_s(&*id) << "\n";
+ *     else if (id.error() != GIT_ENOTFOUND)
+ *         std::cerr << name << ": " << id.error().message() << "\n";
+ * }
+ * \endcode
+ *
+ * \tparam T  Type of the value
+ */
+template <typename T>
+class Result
+{
+public:
+    /// Construct a successful result holding a value.
+    Result(T value) : value_{ std::move(value) }
+    { }
+
+    /// Construct a failed result from an error code (which must not be zero).
+    Result(std::error_code error) noexcept : error_{ error }
+    { }
+
+    /// Construct a failed result from a libgit2 error code (which must not be zero).
+    Result(git_error_code error) noexcept : error_{ make_error_code(error) }
+    { }
+
+    /// Determine if the result holds a value.
+    bool has_value() const noexcept { return not error_; }
+
+    /// Determine if the result holds a value.
+    explicit operator bool() const noexcept { return has_value(); }
+
+    /// Return the error code (zero if the result holds a value).
+    std::error_code error() const noexcept { return error_; }
+
+    /**
+     * Return the value.
+     * \exception Error is thrown with the stored error code if there is no value.
+     */
+    T& value() &
+    {
+        throw_if_error();
+        return *value_;
+    }
+
+    /// \copydoc value()
+    const T& value() const &
+    {
+        throw_if_error();
+        return *value_;
+    }
+
+    /// \copydoc value()
+    T&& value() &&
+    {
+        throw_if_error();
+        return std::move(*value_);
+    }
+
+    /// Return the value if there is one, or the given default value otherwise.
+    template <typename U>
+    T value_or(U&& default_value) const &
+    {
+        return has_value() ? *value_ : static_cast<T>(std::forward<U>(default_value));
+    }
+
+    /// Access the value (undefined behavior if there is none).
+    T& operator*() & noexcept { return *value_; }
+
+    /// Access the value (undefined behavior if there is none).
+    const T& operator*() const & noexcept { return *value_; }
+
+    /// Access a member of the value (undefined behavior if there is none).
+    T* operator->() noexcept { return &*value_; }
+
+    /// Access a member of the value (undefined behavior if there is none).
+    const T* operator->() const noexcept { return &*value_; }
+
+private:
+    gul14::optional<T> value_;
+    std::error_code error_;
+
+    void throw_if_error() const
+    {
+        if (error_)
+            throw Error{ error_ };
+    }
+};
+
+/// The result of a non-throwing operation that does not produce a value.
+template <>
+class Result<void>
+{
+public:
+    /// Construct a successful result.
+    Result() noexcept = default;
+
+    /// Construct a failed result from an error code (zero means success).
+    Result(std::error_code error) noexcept : error_{ error }
+    { }
+
+    /// Construct a failed result from a libgit2 error code (GIT_OK means success).
+    Result(git_error_code error) noexcept : error_{ make_error_code(error) }
+    { }
+
+    /// Determine if the operation succeeded.
+    bool has_value() const noexcept { return not error_; }
+
+    /// Determine if the operation succeeded.
+    explicit operator bool() const noexcept { return has_value(); }
+
+    /// Return the error code (zero on success).
+    std::error_code error() const noexcept { return error_; }
+
+    /**
+     * Do nothing on success.
+     * \exception Error is thrown with the stored error code on failure.
+     */
+    void value() const
+    {
+        if (error_)
+            throw Error{ error_ };
+    }
+
+private:
+    std::error_code error_;
+};
+
+} // namespace git
+
+#endif
+
+// vi:ts=4:sw=4:sts=4:et
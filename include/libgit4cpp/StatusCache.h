@@ -0,0 +1,186 @@
+/**
+ * \file   StatusCache.h
+ * \date   Created on October 14, 2026
+ * \brief  Declaration of the StatusCache class.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef LIBGIT4CPP_STATUSCACHE_H_
+#define LIBGIT4CPP_STATUSCACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+#include <git2.h>
+
+#include "libgit4cpp/Repository.h"
+#include "libgit4cpp/StatusList.h"
+
+namespace git {
+
+/**
+ * An incrementally updated git status of a work tree.
+ *
+ * Repository::status_list() scans the whole work tree on every call. A StatusCache
+ * instead subscribes to file system notifications (inotify on Linux) for the work tree
+ * and remembers which paths have changed since the last call. status() then only lets
+ * libgit2 re-examine these paths (as literal pathspecs, so that the other directories
+ * are not even listed) and merges the result into the previous status.
+ *
+ * A full scan is made on the first call and whenever the incremental result could be
+ * wrong:
+ * - if the notification queue of the kernel has overflowed,
+ * - if HEAD or the index file have changed (e.g. after a commit or by another process),
+ * - if a directory has been renamed or a .gitignore file has changed,
+ * - after invalidate(),
+ * - on every call if \c options.detect_renames is set, because renames can only be
+ *   found by looking at the whole tree, or if \c options.pathspecs is not empty.
+ *
+ * Without file system notifications (on other platforms, or if the inotify watch limit
+ * is exhausted), every call makes a full scan, so the results are always correct.
+ *
+ * If ignored files are not reported, ignored directories are only watched if the index
+ * has entries below them (e.g. files added with "git add -f"). Such files are noticed
+ * when the index changes.
+ *
+ * \code
+ * StatusOptions opt;
+ * opt.include_unmodified = false;
+ * opt.include_ignored = false;
+ * StatusCache cache{ repo, opt };
+ *
+ * while (editor_is_running())
+ * {
+ *     show(cache.status()); // cheap unless many files have changed
+ *     sleep(2s);
+ * }
+ * \endcode
+ *
+ * Changes to .git/info/exclude or to the git configuration are not noticed; call
+ * invalidate() after modifying them. libgit2 does not support git's untracked cache or
+ * fsmonitor index extensions, so they are not used.
+ *
+ * The repository must outlive the cache. A StatusCache is not thread-safe.
+ */
+class StatusCache
+{
+public:
+    /**
+     * Start watching the work tree of a repository.
+     * \param repo     Repository whose status is tracked
+     * \param options  Which files to report (see Repository::status_list())
+     * \exception Error is thrown if the repository has no work tree.
+     */
+    explicit StatusCache(Repository& repo, const StatusOptions& options = StatusOptions{ });
+
+    /// Stop watching the work tree.
+    ~StatusCache();
+
+    StatusCache(const StatusCache&) = delete;
+    StatusCache& operator=(const StatusCache&) = delete;
+
+    /**
+     * Return the current status, re-examining only the paths that have changed since
+     * the last call (or making a full scan, see above).
+     * \exception Error is thrown if the status cannot be determined.
+     */
+    StatusList status();
+
+    /// Make the next call to status() do a full scan.
+    void invalidate() noexcept { full_scan_needed_ = true; }
+
+    /// Determine if file system notifications are used (false means always full scans).
+    bool is_watching() const noexcept { return inotify_fd_ >= 0; }
+
+    /// Return the number of full scans made so far.
+    std::size_t get_full_scan_count() const noexcept { return nr_full_scans_; }
+
+    /// Return the number of incremental updates made so far.
+    std::size_t get_incremental_update_count() const noexcept { return nr_incremental_; }
+
+private:
+    /// Status of one path (the key of entries_).
+    struct Entry
+    {
+        std::string old_path;
+        FileHandling handling;
+        FileChange changes;
+    };
+
+    /// Identity of the index file and HEAD at the time of the last scan.
+    struct GitState
+    {
+        std::uint64_t index_inode = 0;
+        std::int64_t index_mtime_ns = 0;
+        std::int64_t index_size = -1;
+        git_oid head_id{ };
+
+        bool operator==(const GitState& o) const noexcept;
+    };
+
+    Repository& repo_;
+    StatusOptions options_;
+    std::string workdir_;      ///< Work tree with a trailing slash
+    int inotify_fd_{ -1 };
+    std::unordered_map<int, std::string> watches_; ///< Watch descriptor -> directory
+    std::map<std::string, Entry> entries_;
+    std::set<std::string> dirty_paths_;
+    std::set<std::string> unwatched_ignored_dirs_; ///< Ignored dirs without tracked files
+    bool full_scan_needed_{ true };
+    GitState git_state_;
+    std::size_t nr_full_scans_{ 0 };
+    std::size_t nr_incremental_{ 0 };
+
+    /// Close the inotify instance and forget all watches.
+    void stop_watching() noexcept;
+
+    /// Remove all watches and set them up again for the whole work tree.
+    void rewatch();
+
+    /// Add watches for a directory (relative to the work tree) and its subdirectories.
+    void watch_tree(const std::string& dir);
+
+    /// Watch those unwatched ignored directories that now contain tracked files.
+    void watch_tracked_ignored_dirs();
+
+    /// Read all pending notifications into dirty_paths_ (or set full_scan_needed_).
+    void read_events();
+
+    /// Return the current identity of the index file and HEAD.
+    GitState get_git_state() const;
+
+    /// Replace all entries by a full scan of the work tree.
+    void full_scan();
+
+    /// Re-examine the paths in dirty_paths_.
+    void incremental_update();
+
+    /// Add the entries of a status list to entries_.
+    void store(const StatusList& list);
+};
+
+} // namespace git
+
+#endif
+
+// vi:ts=4:sw=4:sts=4:et
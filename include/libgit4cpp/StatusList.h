@@ -0,0 +1,300 @@
+/**
+ * \file   StatusList.h
+ * \date   Created on October 14, 2026
+ * \brief  Declaration of the StatusList class and the associated status enums.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef LIBGIT4CPP_STATUSLIST_H_
+#define LIBGIT4CPP_STATUSLIST_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <git2.h>
+#include <gul14/escape.h>
+#include <gul14/string_view.h>
+
+namespace git {
+
+/**
+ * Struct to express the git status for one file
+ */
+struct FileStatus
+{
+    std::string path_name; /// Relative path to file. If the path changed this value will have the shape "OLD_NAME -> NEW_NAME".
+    std::string handling;  /// Handling status of file [unchanged, unstaged, staged, untracked, ignored]
+    std::string changes;   /// Change status of file [new file, deleted, renamed, typechanged, modified, unchanged, ignored, untracked]
+
+    friend std::ostream& operator<<(std::ostream& stream, FileStatus const& state) {
+        stream << "FileStatus{ \"" << gul14::escape(state.path_name) << "\": " << state.handling << "; " << state.changes << " }";
+        return stream;
+    }
+};
+
+using RepoState = std::vector<FileStatus>; /// State of all files in the repo
+
+inline std::ostream& operator<<(std::ostream& stream, const RepoState& repostate)
+{
+    stream << "RepoState {\n";
+    for (auto& e : repostate)
+        stream << e << '\n';
+    stream << "}";
+    return stream;
+}
+
+/// What git will do with a file (the "handling status").
+enum class FileHandling : std::uint8_t
+{
+    unchanged, ///< File is tracked and identical in HEAD, index, and work tree
+    unstaged,  ///< File differs between index and work tree
+    staged,    ///< File differs between HEAD and index
+    untracked, ///< File exists in the work tree only
+    ignored    ///< File is ignored via .gitignore or similar
+};
+
+/// How a file has changed (the "change status").
+enum class FileChange : std::uint8_t
+{
+    unchanged,
+    new_file,
+    modified,
+    deleted,
+    renamed,
+    typechange,
+    untracked,
+    ignored
+};
+
+/// Return the textual representation of a handling status (e.g. "unstaged").
+const char* to_string(FileHandling handling) noexcept;
+
+/// Return the textual representation of a change status (e.g. "new file").
+const char* to_string(FileChange change) noexcept;
+
+/**
+ * Options that control which files are reported by Repository::status() and
+ * Repository::status_list().
+ *
+ * The default-constructed options report every file in the work tree, including
+ * unmodified and ignored ones. For large repositories it is usually much cheaper to
+ * only ask for the categories that are really needed:
+ *
+ * \code
+ * StatusOptions opt;
+ * opt.include_unmodified = false;
+ * opt.include_ignored = false;
+ * opt.pathspecs = { "*.cc" };
+ * auto changes = repo.status_list(opt);
+ * \endcode
+ */
+struct StatusOptions
+{
+    /// Report files that are identical in HEAD, index, and work tree.
+    bool include_unmodified = true;
+    /// Report untracked files.
+    bool include_untracked = true;
+    /// Report the individual files in untracked directories instead of the directory.
+    bool recurse_untracked_dirs = true;
+    /// Report ignored files.
+    bool include_ignored = true;
+    /// Detect renamed files in the index and in the work tree (costly on large trees).
+    bool detect_renames = false;
+    /**
+     * Restrict the status to files matching one of these patterns (see Repository::add()
+     * for the glob syntax). An empty list means all files.
+     */
+    std::vector<std::string> pathspecs;
+    /// Treat the pathspecs as literal paths instead of glob patterns.
+    bool disable_pathspec_match = false;
+};
+
+/**
+ * Lightweight, non-owning description of the git status of one file.
+ *
+ * The string views point into memory owned by someone else, usually a StatusList. They
+ * stay valid as long as the owner is alive and unmodified.
+ */
+struct FileStatusView
+{
+    /// Relative path to the file (the new path for renamed files).
+    gul14::string_view path;
+    /// Relative path before a rename, or an empty view if the file was not renamed.
+    gul14::string_view old_path;
+    /// What git will do with the file.
+    FileHandling handling{ FileHandling::unchanged };
+    /// How the file has changed.
+    FileChange changes{ FileChange::unchanged };
+
+    /// Determine if the file has been renamed (i.e. if old_path is not empty).
+    bool is_renamed() const noexcept { return not old_path.empty(); }
+
+    friend std::ostream& operator<<(std::ostream& stream, const FileStatusView& status);
+};
+
+/**
+ * A compact snapshot of the git status of a repository.
+ *
+ * In contrast to RepoState, a StatusList stores the status of each file as a pair of
+ * enums. All path names are stored in a single string pool owned by the list, so that
+ * building the list does not cause an allocation per file. Entries are accessed as
+ * FileStatusView objects pointing into this pool.
+ *
+ * \code
+ * Repository repo{ "/path/to/repo" };
+ * for (const FileStatusView& entry : repo.status_list())
+ * {
+ *     if (entry.handling == FileHandling::staged)
+ *         std::cout << entry.path << "\n";
+ * }
+ * \endcode
+ *
+ * \see Repository::status_list(), to_repo_state()
+ */
+class StatusList
+{
+public:
+    class const_iterator;
+    using value_type = FileStatusView;
+    using size_type = std::size_t;
+
+    /// Construct an empty status list.
+    StatusList() = default;
+
+    /**
+     * Construct a status list from a libgit2 status list.
+     * Entries that do not map onto one of the handling states (e.g. conflicts) are
+     * skipped.
+     * \exception Error is thrown if the total length of all paths exceeds 4 GiB.
+     */
+    explicit StatusList(git_status_list* status);
+
+    /// Return the number of entries.
+    size_type size() const noexcept { return entries_.size(); }
+
+    /// Determine if the list is empty.
+    bool empty() const noexcept { return entries_.empty(); }
+
+    /// Return the entry with the given index (no bounds check).
+    FileStatusView operator[](size_type idx) const noexcept;
+
+    /// Return an iterator to the first entry.
+    const_iterator begin() const noexcept;
+
+    /// Return an iterator past the last entry.
+    const_iterator end() const noexcept;
+
+    /**
+     * Append an entry, copying the paths into the string pool.
+     * \exception Error is thrown if the string pool would exceed 4 GiB.
+     */
+    void push_back(const FileStatusView& entry);
+
+    /// Reserve space for a number of entries and path characters.
+    void reserve(size_type nr_entries, size_type nr_chars = 0);
+
+private:
+    struct Entry
+    {
+        std::uint32_t path_offset;
+        std::uint32_t path_size;
+        std::uint32_t old_path_offset;
+        std::uint32_t old_path_size;
+        FileHandling handling;
+        FileChange changes;
+    };
+
+    std::string pool_;
+    std::vector<Entry> entries_;
+
+    std::uint32_t store(gul14::string_view str);
+};
+
+/// Forward iterator over the entries of a StatusList.
+class StatusList::const_iterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = FileStatusView;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = FileStatusView;
+
+    const_iterator() = default;
+
+    FileStatusView operator*() const noexcept { return (*list_)[idx_]; }
+
+    const_iterator& operator++() noexcept { ++idx_; return *this; }
+
+    const_iterator operator++(int) noexcept
+    {
+        const_iterator copy{ *this };
+        ++idx_;
+        return copy;
+    }
+
+    friend bool operator==(const const_iterator& a, const const_iterator& b) noexcept
+    {
+        return a.idx_ == b.idx_ && a.list_ == b.list_;
+    }
+
+    friend bool operator!=(const const_iterator& a, const const_iterator& b) noexcept
+    {
+        return not (a == b);
+    }
+
+private:
+    friend class StatusList;
+
+    const StatusList* list_{ nullptr };
+    size_type idx_{ 0 };
+
+    const_iterator(const StatusList* list, size_type idx) noexcept
+        : list_{ list }, idx_{ idx }
+    { }
+};
+
+inline StatusList::const_iterator StatusList::begin() const noexcept
+{
+    return const_iterator{ this, 0 };
+}
+
+inline StatusList::const_iterator StatusList::end() const noexcept
+{
+    return const_iterator{ this, entries_.size() };
+}
+
+/**
+ * Convert a status view into a self-contained FileStatus object.
+ * Renamed files get a path name of the shape "OLD_NAME -> NEW_NAME".
+ */
+FileStatus to_file_status(const FileStatusView& view);
+
+/// Convert a compact StatusList into a RepoState.
+RepoState to_repo_state(const StatusList& list);
+
+} // namespace git
+
+#endif
+
+// vi:ts=4:sw=4:sts=4:et
@@ -0,0 +1,71 @@
+/**
+ * \file   TreeEntry.h
+ * \date   Created on October 14, 2026
+ * \brief  Declaration of the TreeEntry struct.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef LIBGIT4CPP_TREEENTRY_H_
+#define LIBGIT4CPP_TREEENTRY_H_
+
+#include <string>
+
+#include <git2.h>
+
+namespace git {
+
+/// Kind of object a tree entry refers to.
+enum class TreeEntryType
+{
+    file,       ///< Regular file
+    executable, ///< File with the executable bit set
+    symlink,    ///< Symbolic link
+    directory,  ///< Directory (subtree)
+    submodule   ///< Submodule (commit in another repository)
+};
+
+/**
+ * An entry of a git tree as returned by Repository::list_tree() and
+ * Repository::lookup_path().
+ */
+struct TreeEntry
+{
+    /// Path relative to the repository root, with forward slashes (e.g. "dir/file.txt")
+    std::string path;
+    /// Kind of the entry
+    TreeEntryType type{ TreeEntryType::file };
+    /// ID of the blob, tree or commit the entry refers to
+    git_oid id;
+
+    /// Return the last component of the path.
+    std::string name() const
+    {
+        const auto pos = path.rfind('/');
+        return pos == std::string::npos ? path : path.substr(pos + 1);
+    }
+
+    /// Determine if the entry is a directory.
+    bool is_directory() const noexcept { return type == TreeEntryType::directory; }
+};
+
+} // namespace git
+
+#endif
+
+// vi:ts=4:sw=4:sts=4:et
@@ -25,8 +25,27 @@
 #ifndef LIBGIT4CPP_LIBGIT4CPP_H_
 #define LIBGIT4CPP_LIBGIT4CPP_H_
 
+#include "libgit4cpp/BlobContent.h"
+#include "libgit4cpp/BranchTracking.h"
+#include "libgit4cpp/CancellationToken.h"
+#include "libgit4cpp/CheckoutOptions.h"
+#include "libgit4cpp/CloneOptions.h"
+#include "libgit4cpp/CommitLog.h"
+#include "libgit4cpp/Diff.h"
 #include "libgit4cpp/Error.h"
+#include "libgit4cpp/FetchOptions.h"
+#include "libgit4cpp/LibraryContext.h"
+#include "libgit4cpp/Metrics.h"
+#include "libgit4cpp/Remote.h"
+#include "libgit4cpp/RemoteReferenceList.h"
+#include "libgit4cpp/RemoteResult.h"
+#include "libgit4cpp/RepackOptions.h"
 #include "libgit4cpp/Repository.h"
+#include "libgit4cpp/RepositoryPool.h"
+#include "libgit4cpp/Result.h"
+#include "libgit4cpp/StatusCache.h"
+#include "libgit4cpp/StatusList.h"
+#include "libgit4cpp/TreeEntry.h"
 #include "libgit4cpp/types.h"
 #include "libgit4cpp/wrapper_functions.h"
 
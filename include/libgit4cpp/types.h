@@ -30,16 +30,43 @@
 
 namespace git {
 
-using LibGitTree = std::unique_ptr<git_tree, void(*)(git_tree*)>;
-using LibGitSignature = std::unique_ptr<git_signature, void(*)(git_signature*)>;
-using LibGitIndex = std::unique_ptr<git_index, void(*)(git_index*)>;
-using LibGitRepository = std::unique_ptr<git_repository, void(*)(git_repository*)>;
-using LibGitRemote = std::unique_ptr<git_remote, void(*)(git_remote*)>;
-using LibGitCommit = std::unique_ptr<git_commit, void(*)(git_commit*)>;
-using LibGitStatusList = std::unique_ptr<git_status_list, void(*)(git_status_list*)>;
-using LibGitReference = std::unique_ptr<git_reference, void(*)(git_reference*)>;
-using LibGitBuf = std::unique_ptr<git_buf, void(*)(git_buf*)>;
-using LibGitBranchIterator = std::unique_ptr<git_branch_iterator, void(*)(git_branch_iterator*)>;
+namespace detail {
+
+/**
+ * A stateless deleter that calls a libgit2 free function.
+ *
+ * In contrast to a function pointer, it takes up no space in a std::unique_ptr, so that
+ * the handles below are as small and as cheap to move as a raw pointer.
+ */
+template <typename T, void (*free_function)(T*)>
+struct LibGitDeleter
+{
+    void operator()(T* ptr) const noexcept { free_function(ptr); }
+};
+
+} // namespace detail
+
+/// An owning pointer to a libgit2 object that is released with the given free function.
+template <typename T, void (*free_function)(T*)>
+using LibGitPtr = std::unique_ptr<T, detail::LibGitDeleter<T, free_function>>;
+
+using LibGitBlob = LibGitPtr<git_blob, git_blob_free>;
+using LibGitTree = LibGitPtr<git_tree, git_tree_free>;
+using LibGitSignature = LibGitPtr<git_signature, git_signature_free>;
+using LibGitIndex = LibGitPtr<git_index, git_index_free>;
+using LibGitRepository = LibGitPtr<git_repository, git_repository_free>;
+using LibGitRemote = LibGitPtr<git_remote, git_remote_free>;
+using LibGitCommit = LibGitPtr<git_commit, git_commit_free>;
+using LibGitStatusList = LibGitPtr<git_status_list, git_status_list_free>;
+using LibGitReference = LibGitPtr<git_reference, git_reference_free>;
+using LibGitBuf = LibGitPtr<git_buf, git_buf_dispose>;
+using LibGitTreeBuilder = LibGitPtr<git_treebuilder, git_treebuilder_free>;
+using LibGitDiff = LibGitPtr<git_diff, git_diff_free>;
+using LibGitRevwalk = LibGitPtr<git_revwalk, git_revwalk_free>;
+using LibGitTransaction = LibGitPtr<git_transaction, git_transaction_free>;
+using LibGitBranchIterator = LibGitPtr<git_branch_iterator, git_branch_iterator_free>;
+using LibGitOdb = LibGitPtr<git_odb, git_odb_free>;
+using LibGitPackBuilder = LibGitPtr<git_packbuilder, git_packbuilder_free>;
 
 } // namespace git
 
@@ -93,6 +93,29 @@ LibGitSignature signature_new(const std::string& name, const std::string& email,
  */
 LibGitTree tree_lookup(git_repository* repo, git_oid tree_id);
 
+/**
+ * Create a new tree builder.
+ * \param repo Pointer to repository object whose object database is used
+ * \param source Tree to initialize the builder with (null for an empty builder)
+ * \return new git_treebuilder object (null on failure)
+ */
+LibGitTreeBuilder treebuilder_new(git_repository* repo, const git_tree* source);
+
+/**
+ * Look up a commit by its ID.
+ * \param repo Pointer to repository object
+ * \param commit_id ID of the commit
+ * \return new git_commit object (null if the commit does not exist)
+ */
+LibGitCommit commit_lookup(git_repository* repo, const git_oid& commit_id);
+
+/**
+ * Create a new revision walker.
+ * \param repo Pointer to repository object whose history is walked
+ * \return new git_revwalk object (null on failure)
+ */
+LibGitRevwalk revwalk_new(git_repository* repo);
+
 /**
  * Create a new status list of the index.
  * The returned status object contains status_list_entry* elements.
@@ -132,9 +155,11 @@ LibGitRemote remote_lookup(git_repository* repo, const std::string& remote_name)
  * Clone an existing git repository into the local filesystem.
  * \param url Address of remote connection, e.g https://github.com/...
  * \param repo_path Absolute or relative path to the repository root
- * \return new git_repository object
+ * \param options Clone options (null for the libgit2 defaults)
+ * \return new git_repository object (null on failure)
  */
-LibGitRepository clone(const std::string& url, const std::string& repo_path);
+LibGitRepository clone(const std::string& url, const std::string& repo_path,
+    const git_clone_options* options = nullptr);
 
 /**
  * Find a named branch.
@@ -0,0 +1,86 @@
+/**
+ * \file   BlobContent.cc
+ * \date   Created on October 14, 2026
+ * \brief  Implementation of the BlobContent class.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <utility>
+
+#include "libgit4cpp/BlobContent.h"
+
+namespace git {
+
+BlobContent::BlobContent(LibGitBlob blob, git_buf* filtered) noexcept
+    : blob_{ std::move(blob) }
+{
+    if (filtered != nullptr)
+    {
+        filtered_ = *filtered;
+        *filtered = git_buf{ };
+        is_filtered_ = true;
+    }
+}
+
+BlobContent::BlobContent(BlobContent&& other) noexcept
+    : blob_{ std::move(other.blob_) }
+    , filtered_{ other.filtered_ }
+    , is_filtered_{ other.is_filtered_ }
+{
+    other.filtered_ = git_buf{ };
+    other.is_filtered_ = false;
+}
+
+BlobContent& BlobContent::operator=(BlobContent&& other) noexcept
+{
+    if (this != &other)
+    {
+        git_buf_dispose(&filtered_);
+        blob_ = std::move(other.blob_);
+        filtered_ = other.filtered_;
+        is_filtered_ = other.is_filtered_;
+        other.filtered_ = git_buf{ };
+        other.is_filtered_ = false;
+    }
+    return *this;
+}
+
+BlobContent::~BlobContent()
+{
+    git_buf_dispose(&filtered_);
+}
+
+gul14::string_view BlobContent::data() const noexcept
+{
+    if (is_filtered_)
+        return gul14::string_view{ filtered_.ptr, filtered_.size };
+
+    if (not blob_)
+        return gul14::string_view{ };
+
+    return gul14::string_view{ static_cast<const char*>(git_blob_rawcontent(blob_.get())),
+        static_cast<std::size_t>(git_blob_rawsize(blob_.get())) };
+}
+
+bool BlobContent::is_binary() const noexcept
+{
+    return blob_ && git_blob_is_binary(blob_.get());
+}
+
+} // namespace git
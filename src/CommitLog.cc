@@ -0,0 +1,307 @@
+/**
+ * \file   CommitLog.cc
+ * \date   Created on October 14, 2026
+ * \brief  Implementation of the CommitLog and CommitRecord classes.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <algorithm>
+#include <iterator>
+
+#include <gul14/cat.h>
+#include <gul14/finalizer.h>
+
+#include "libgit4cpp/CommitLog.h"
+#include "libgit4cpp/Error.h"
+#include "libgit4cpp/wrapper_functions.h"
+
+using gul14::cat;
+
+namespace git {
+
+namespace {
+
+// Duplicate a commit handle (this only increments the reference count of the object).
+LibGitCommit duplicate(git_commit* commit)
+{
+    git_commit* copy = nullptr;
+    if (commit != nullptr && git_commit_dup(&copy, commit))
+        throw Error{ cat("Cannot duplicate commit: ", git_error_last()->message) };
+    return LibGitCommit{ copy };
+}
+
+// Return the ID of the tree entry at the given path, or a zero OID if it does not exist.
+git_oid entry_id(const git_tree* tree, const std::string& path)
+{
+    git_oid id{ };
+
+    if (path.empty() || path == ".")
+        return *git_tree_id(tree);
+
+    git_tree_entry* entry = nullptr;
+    if (git_tree_entry_bypath(&entry, tree, path.c_str()) == 0)
+    {
+        id = *git_tree_entry_id(entry);
+        git_tree_entry_free(entry);
+    }
+    return id;
+}
+
+// git_oid_is_zero() is not available in all supported versions of libgit2.
+bool is_zero(const git_oid& id) noexcept
+{
+    return std::all_of(std::begin(id.id), std::end(id.id),
+        [](unsigned char c) { return c == 0; });
+}
+
+unsigned int to_sort_flags(LogSort sort, bool reverse) noexcept
+{
+    unsigned int flags = GIT_SORT_NONE;
+
+    switch (sort)
+    {
+    case LogSort::none:
+        break;
+    case LogSort::time:
+        flags = GIT_SORT_TIME;
+        break;
+    case LogSort::topological:
+        flags = GIT_SORT_TOPOLOGICAL;
+        break;
+    case LogSort::topological_time:
+        flags = GIT_SORT_TOPOLOGICAL | GIT_SORT_TIME;
+        break;
+    }
+
+    if (reverse)
+        flags |= GIT_SORT_REVERSE;
+
+    return flags;
+}
+
+} // anonymous namespace
+
+
+CommitRecord::CommitRecord(LibGitCommit&& commit)
+    : commit_{ std::move(commit) }
+{
+    if (commit_ == nullptr)
+        throw Error{ "Cannot create a commit record from a null commit" };
+}
+
+CommitRecord::CommitRecord(const CommitRecord& other)
+    : commit_{ duplicate(other.commit_.get()) }
+{ }
+
+CommitRecord& CommitRecord::operator=(const CommitRecord& other)
+{
+    if (this != &other)
+        commit_ = duplicate(other.commit_.get());
+    return *this;
+}
+
+const git_oid& CommitRecord::id() const noexcept
+{
+    return *git_commit_id(commit_.get());
+}
+
+std::string CommitRecord::id_string() const
+{
+    char buf[GIT_OID_HEXSZ + 1];
+    return git_oid_tostr(buf, sizeof(buf), git_commit_id(commit_.get()));
+}
+
+gul14::string_view CommitRecord::author_name() const noexcept
+{
+    return git_commit_author(commit_.get())->name;
+}
+
+gul14::string_view CommitRecord::author_email() const noexcept
+{
+    return git_commit_author(commit_.get())->email;
+}
+
+std::time_t CommitRecord::time() const noexcept
+{
+    return static_cast<std::time_t>(git_commit_time(commit_.get()));
+}
+
+int CommitRecord::time_offset() const noexcept
+{
+    return git_commit_time_offset(commit_.get());
+}
+
+gul14::string_view CommitRecord::summary() const
+{
+    // libgit2 computes the summary on first use and caches it inside the commit object
+    const char* summary = git_commit_summary(commit_.get());
+    if (summary == nullptr)
+        throw Error{ cat("Cannot determine commit summary: ", git_error_last()->message) };
+    return summary;
+}
+
+gul14::string_view CommitRecord::message() const noexcept
+{
+    return git_commit_message(commit_.get());
+}
+
+unsigned int CommitRecord::parent_count() const noexcept
+{
+    return git_commit_parentcount(commit_.get());
+}
+
+
+CommitLog::CommitLog(git_repository* repo, const LogOptions& options)
+    : repo_{ repo }
+    , walk_{ revwalk_new(repo) }
+    , paths_{ options.paths }
+    , first_parent_only_{ options.first_parent_only }
+    , page_size_{ options.page_size > 0 ? options.page_size : 1 }
+{
+    if (walk_ == nullptr)
+        throw Error{ cat("Cannot create revision walker: ", git_error_last()->message) };
+
+    git_revwalk_sorting(walk_.get(), to_sort_flags(options.sort, options.reverse));
+
+    if (options.revision.find("..") != std::string::npos)
+    {
+        if (git_revwalk_push_range(walk_.get(), options.revision.c_str()))
+        {
+            throw Error{ cat("Cannot resolve revision range \"", options.revision,
+                "\": ", git_error_last()->message) };
+        }
+    }
+    else
+    {
+        git_object* obj = nullptr;
+        git_object* commit = nullptr;
+        auto free_objects = gul14::finally([&]() {
+            git_object_free(commit);
+            git_object_free(obj);
+        });
+
+        if (git_revparse_single(&obj, repo_, options.revision.c_str())
+            || git_object_peel(&commit, obj, GIT_OBJECT_COMMIT)
+            || git_revwalk_push(walk_.get(), git_object_id(commit)))
+        {
+            throw Error{ cat("Cannot resolve revision \"", options.revision, "\": ",
+                git_error_last()->message) };
+        }
+    }
+
+    if (options.first_parent_only)
+        git_revwalk_simplify_first_parent(walk_.get());
+}
+
+gul14::optional<CommitRecord> CommitLog::next()
+{
+    git_oid id;
+
+    while (true)
+    {
+        int error = git_revwalk_next(&id, walk_.get());
+        if (error == GIT_ITEROVER)
+            return gul14::nullopt;
+        if (error)
+            throw Error{ error, cat("Cannot walk history: ", git_error_last()->message) };
+
+        auto commit = commit_lookup(repo_, id);
+        if (commit == nullptr)
+            throw Error{ cat("Cannot look up commit: ", git_error_last()->message) };
+
+        if (paths_.empty() || touches_paths(commit.get()))
+            return CommitRecord{ std::move(commit) };
+    }
+}
+
+std::vector<CommitRecord> CommitLog::next_page()
+{
+    std::vector<CommitRecord> page;
+    page.reserve(page_size_);
+
+    while (page.size() < page_size_)
+    {
+        auto commit = next();
+        if (not commit)
+            break;
+        page.push_back(std::move(*commit));
+    }
+
+    return page;
+}
+
+// A commit touches the paths if it differs from each of its parents in at least one of
+// them. When only first parents are followed, the side branches of merges are never
+// visited, so a merge is compared against its first parent only (like git log
+// --first-parent). Only tree entry IDs are compared, so no blob is ever loaded.
+bool CommitLog::touches_paths(git_commit* commit) const
+{
+    auto tree = commit_tree(commit);
+    if (tree == nullptr)
+        throw Error{ cat("Cannot find tree of commit: ", git_error_last()->message) };
+
+    std::vector<git_oid> ids;
+    ids.reserve(paths_.size());
+    for (const auto& path : paths_)
+        ids.push_back(entry_id(tree.get(), path));
+
+    auto nr_parents = git_commit_parentcount(commit);
+    if (first_parent_only_ && nr_parents > 1)
+        nr_parents = 1;
+
+    if (nr_parents == 0)
+    {
+        for (const auto& id : ids)
+        {
+            if (not is_zero(id))
+                return true;
+        }
+        return false;
+    }
+
+    for (unsigned int i = 0; i != nr_parents; ++i)
+    {
+        git_commit* parent_ptr = nullptr;
+        if (git_commit_parent(&parent_ptr, commit, i))
+            throw Error{ cat("Cannot look up parent commit: ", git_error_last()->message) };
+        LibGitCommit parent{ parent_ptr };
+
+        auto parent_tree = commit_tree(parent.get());
+        if (parent_tree == nullptr)
+            throw Error{ cat("Cannot find tree of commit: ", git_error_last()->message) };
+
+        bool same_as_parent = true;
+        for (std::size_t j = 0; j != paths_.size(); ++j)
+        {
+            const auto parent_id = entry_id(parent_tree.get(), paths_[j]);
+            if (git_oid_cmp(&parent_id, &ids[j]) != 0)
+            {
+                same_as_parent = false;
+                break;
+            }
+        }
+
+        if (same_as_parent)
+            return false;
+    }
+
+    return true;
+}
+
+} // namespace git
@@ -0,0 +1,250 @@
+/**
+ * \file   Diff.cc
+ * \date   Created on October 14, 2026
+ * \brief  Implementation of the diff helpers.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <algorithm>
+#include <exception>
+
+#include <gul14/cat.h>
+#include <gul14/escape.h>
+
+#include "libgit4cpp/Error.h"
+#include "diff_result.h"
+
+using gul14::cat;
+
+namespace git {
+
+namespace {
+
+// State shared with the git_diff_foreach() callbacks.
+struct DiffWalkState
+{
+    const DiffOptions* options;
+    DiffResult* result;
+    DiffHunk hunk;
+    std::exception_ptr exception;
+};
+
+FileChange to_file_change(git_delta_t status) noexcept
+{
+    switch (status)
+    {
+    case GIT_DELTA_UNMODIFIED:
+        return FileChange::unchanged;
+    case GIT_DELTA_ADDED:
+    case GIT_DELTA_COPIED:
+        return FileChange::new_file;
+    case GIT_DELTA_DELETED:
+        return FileChange::deleted;
+    case GIT_DELTA_RENAMED:
+        return FileChange::renamed;
+    case GIT_DELTA_TYPECHANGE:
+        return FileChange::typechange;
+    case GIT_DELTA_UNTRACKED:
+        return FileChange::untracked;
+    case GIT_DELTA_IGNORED:
+        return FileChange::ignored;
+    default:
+        return FileChange::modified;
+    }
+}
+
+DiffDelta make_delta(const git_diff_delta* delta)
+{
+    DiffDelta out;
+    out.old_path = delta->old_file.path ? delta->old_file.path : "";
+    out.new_path = delta->new_file.path ? delta->new_file.path : "";
+    out.change = to_file_change(delta->status);
+    out.old_id = delta->old_file.id;
+    out.new_id = delta->new_file.id;
+    out.binary = (delta->flags & GIT_DIFF_FLAG_BINARY) != 0;
+    return out;
+}
+
+// Call a user callback, turning false or an exception into GIT_EUSER.
+template <typename Function>
+int call_user_callback(DiffWalkState* state, Function&& fct) noexcept
+{
+    try
+    {
+        return fct() ? 0 : GIT_EUSER;
+    }
+    catch (...)
+    {
+        state->exception = std::current_exception();
+        return GIT_EUSER;
+    }
+}
+
+} // anonymous namespace
+
+} // namespace git
+
+extern "C" {
+
+static int diff_walk_file(const git_diff_delta* delta, float /*progress*/, void* payload)
+{
+    auto* state = static_cast<git::DiffWalkState*>(payload);
+    try
+    {
+        state->result->deltas.push_back(git::make_delta(delta));
+    }
+    catch (...)
+    {
+        state->exception = std::current_exception();
+        return GIT_EUSER;
+    }
+    return 0;
+}
+
+static int diff_walk_hunk(const git_diff_delta* /*delta*/, const git_diff_hunk* hunk,
+    void* payload)
+{
+    auto* state = static_cast<git::DiffWalkState*>(payload);
+
+    state->hunk.header = gul14::string_view{ hunk->header, hunk->header_len };
+    state->hunk.old_start = hunk->old_start;
+    state->hunk.old_lines = hunk->old_lines;
+    state->hunk.new_start = hunk->new_start;
+    state->hunk.new_lines = hunk->new_lines;
+
+    if (not state->options->on_hunk)
+        return 0;
+
+    return git::call_user_callback(state, [state]() {
+        return state->options->on_hunk(state->result->deltas.back(), state->hunk);
+    });
+}
+
+static int diff_walk_line(const git_diff_delta* /*delta*/, const git_diff_hunk* /*hunk*/,
+    const git_diff_line* line, void* payload)
+{
+    auto* state = static_cast<git::DiffWalkState*>(payload);
+    auto& current = state->result->deltas.back();
+
+    if (line->origin == GIT_DIFF_LINE_ADDITION)
+        ++current.additions;
+    else if (line->origin == GIT_DIFF_LINE_DELETION)
+        ++current.deletions;
+
+    if (not state->options->on_line)
+        return 0;
+
+    git::DiffLine out;
+    out.origin = line->origin;
+    out.content = gul14::string_view{ line->content, line->content_len };
+    out.old_lineno = line->old_lineno;
+    out.new_lineno = line->new_lineno;
+
+    return git::call_user_callback(state, [state, &current, &out]() {
+        return state->options->on_line(current, state->hunk, out);
+    });
+}
+
+} // extern "C"
+
+namespace git {
+
+std::ostream& operator<<(std::ostream& stream, const DiffDelta& delta)
+{
+    stream << "DiffDelta{ \"" << gul14::escape(delta.new_path) << "\": "
+        << to_string(delta.change);
+    if (delta.old_path != delta.new_path)
+        stream << " from \"" << gul14::escape(delta.old_path) << "\"";
+    stream << " }";
+    return stream;
+}
+
+git_diff_options make_diff_options(const DiffOptions& options,
+    std::vector<const char*>& pathspec_storage)
+{
+    git_diff_options diff_opt = GIT_DIFF_OPTIONS_INIT;
+
+    pathspec_storage.clear();
+    pathspec_storage.reserve(options.paths.size());
+    for (const auto& path : options.paths)
+        pathspec_storage.push_back(path.c_str());
+    diff_opt.pathspec.strings = const_cast<char**>(pathspec_storage.data());
+    diff_opt.pathspec.count = pathspec_storage.size();
+
+    if (options.disable_pathspec_match)
+        diff_opt.flags |= GIT_DIFF_DISABLE_PATHSPEC_MATCH;
+    if (options.include_untracked)
+        diff_opt.flags |= GIT_DIFF_INCLUDE_UNTRACKED | GIT_DIFF_RECURSE_UNTRACKED_DIRS;
+
+    diff_opt.context_lines = options.context_lines;
+
+    return diff_opt;
+}
+
+DiffResult make_diff_result(git_diff* diff, const DiffOptions& options)
+{
+    if (options.detect_renames)
+    {
+        git_diff_find_options find_opt = GIT_DIFF_FIND_OPTIONS_INIT;
+        find_opt.flags = GIT_DIFF_FIND_RENAMES;
+        if (options.include_untracked)
+            find_opt.flags |= GIT_DIFF_FIND_FOR_UNTRACKED;
+        if (options.mode == DiffMode::name_status)
+            find_opt.flags |= GIT_DIFF_FIND_EXACT_MATCH_ONLY;
+
+        int error = git_diff_find_similar(diff, &find_opt);
+        if (error)
+        {
+            throw Error{ error, cat("Cannot detect renames: ",
+                git_error_last()->message) };
+        }
+    }
+
+    DiffResult result;
+    const std::size_t nr_deltas = git_diff_num_deltas(diff);
+    result.deltas.reserve(nr_deltas);
+
+    if (options.mode == DiffMode::name_status)
+    {
+        for (std::size_t i = 0; i != nr_deltas; ++i)
+            result.deltas.push_back(make_delta(git_diff_get_delta(diff, i)));
+    }
+    else
+    {
+        DiffWalkState state{ &options, &result, DiffHunk{ }, nullptr };
+
+        int error = git_diff_foreach(diff, diff_walk_file, nullptr, diff_walk_hunk,
+            diff_walk_line, &state);
+        if (state.exception)
+            std::rethrow_exception(state.exception);
+        if (error && error != GIT_EUSER)
+            throw Error{ error, cat("Cannot compute diff: ", git_error_last()->message) };
+
+        for (const auto& delta : result.deltas)
+        {
+            result.stats.insertions += delta.additions;
+            result.stats.deletions += delta.deletions;
+        }
+    }
+
+    result.stats.files_changed = result.deltas.size();
+    return result;
+}
+
+} // namespace git
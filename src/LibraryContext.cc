@@ -0,0 +1,148 @@
+/**
+ * \file   LibraryContext.cc
+ * \date   Created on October 14, 2026
+ * \brief  Implementation of the LibraryContext class.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <sys/types.h>
+
+#include <git2.h>
+#include <gul14/cat.h>
+
+#include "libgit4cpp/Error.h"
+#include "libgit4cpp/LibraryContext.h"
+
+using gul14::cat;
+
+namespace git {
+
+namespace {
+
+void init_library()
+{
+    int error = git_libgit2_init();
+    if (error < 0)
+        throw Error{ error, "Cannot initialize libgit2" };
+}
+
+void check(int error, const char* what)
+{
+    if (error < 0)
+        throw Error{ error, cat("Cannot access libgit2 option ", what, ": ", git_error_last()->message) };
+}
+
+} // anonymous namespace
+
+
+LibraryContext::LibraryContext()
+{
+    init_library();
+}
+
+LibraryContext::LibraryContext(const LibraryOptions& options)
+{
+    init_library();
+
+    try
+    {
+        configure(options);
+    }
+    catch (...)
+    {
+        git_libgit2_shutdown();
+        throw;
+    }
+}
+
+LibraryContext::LibraryContext(const LibraryContext&)
+{
+    init_library();
+}
+
+LibraryContext::LibraryContext(LibraryContext&&) noexcept
+{
+    git_libgit2_init();
+}
+
+LibraryContext::~LibraryContext()
+{
+    git_libgit2_shutdown();
+}
+
+void LibraryContext::configure(const LibraryOptions& options) const
+{
+    if (options.enable_caching)
+    {
+        check(git_libgit2_opts(GIT_OPT_ENABLE_CACHING, *options.enable_caching ? 1 : 0),
+            "ENABLE_CACHING");
+    }
+
+    if (options.cache_max_size)
+    {
+        check(git_libgit2_opts(GIT_OPT_SET_CACHE_MAX_SIZE,
+            static_cast<ssize_t>(*options.cache_max_size)), "SET_CACHE_MAX_SIZE");
+    }
+
+    if (options.mwindow_size)
+    {
+        check(git_libgit2_opts(GIT_OPT_SET_MWINDOW_SIZE, *options.mwindow_size),
+            "SET_MWINDOW_SIZE");
+    }
+
+    if (options.mwindow_mapped_limit)
+    {
+        check(git_libgit2_opts(GIT_OPT_SET_MWINDOW_MAPPED_LIMIT,
+            *options.mwindow_mapped_limit), "SET_MWINDOW_MAPPED_LIMIT");
+    }
+
+    if (options.mwindow_file_limit)
+    {
+#if LIBGIT2_FULLVERSION >= 1001000
+        check(git_libgit2_opts(GIT_OPT_SET_MWINDOW_FILE_LIMIT, *options.mwindow_file_limit),
+            "SET_MWINDOW_FILE_LIMIT");
+#else
+        throw Error{ "mwindow_file_limit requires libgit2 1.1 or newer" };
+#endif
+    }
+
+    if (options.strict_object_creation)
+    {
+        check(git_libgit2_opts(GIT_OPT_ENABLE_STRICT_OBJECT_CREATION,
+            *options.strict_object_creation ? 1 : 0), "ENABLE_STRICT_OBJECT_CREATION");
+    }
+
+    if (options.strict_hash_verification)
+    {
+        check(git_libgit2_opts(GIT_OPT_ENABLE_STRICT_HASH_VERIFICATION,
+            *options.strict_hash_verification ? 1 : 0), "ENABLE_STRICT_HASH_VERIFICATION");
+    }
+}
+
+CacheUsage LibraryContext::cache_usage() const
+{
+    ssize_t current = 0;
+    ssize_t allowed = 0;
+
+    check(git_libgit2_opts(GIT_OPT_GET_CACHED_MEMORY, &current, &allowed), "GET_CACHED_MEMORY");
+
+    return { static_cast<std::size_t>(current), static_cast<std::size_t>(allowed) };
+}
+
+} // namespace git
@@ -0,0 +1,133 @@
+/**
+ * \file   Metrics.cc
+ * \date   Created on October 14, 2026
+ * \brief  Implementation of the Metrics sink registry and the MetricsCollector class.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <atomic>
+
+#include "libgit4cpp/Metrics.h"
+
+namespace git {
+
+namespace {
+
+std::atomic<Metrics*> metrics_sink{ nullptr };
+
+} // anonymous namespace
+
+
+void set_metrics(Metrics* sink) noexcept
+{
+    metrics_sink.store(sink, std::memory_order_release);
+}
+
+Metrics* get_metrics() noexcept
+{
+    return metrics_sink.load(std::memory_order_acquire);
+}
+
+void LatencyHistogram::add(std::chrono::nanoseconds duration) noexcept
+{
+    ++count;
+    total += duration;
+    if (duration > max)
+        max = duration;
+
+    // Bucket index = number of bits of the duration in microseconds
+    auto us = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+    std::size_t idx = 0;
+    while (us != 0 && idx + 1 < num_buckets)
+    {
+        us >>= 1;
+        ++idx;
+    }
+    ++buckets[idx];
+}
+
+std::chrono::nanoseconds LatencyHistogram::mean() const noexcept
+{
+    if (count == 0)
+        return std::chrono::nanoseconds{ 0 };
+    return total / static_cast<std::chrono::nanoseconds::rep>(count);
+}
+
+void MetricsCollector::record_latency(const char* operation,
+    std::chrono::nanoseconds duration) noexcept
+{
+    try
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        histograms_[operation].add(duration);
+    }
+    catch (...)
+    {
+        // Out of memory: drop the measurement
+    }
+}
+
+void MetricsCollector::add_to_counter(const char* counter, std::uint64_t value) noexcept
+{
+    try
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        counters_[counter] += value;
+    }
+    catch (...)
+    {
+        // Out of memory: drop the measurement
+    }
+}
+
+std::uint64_t MetricsCollector::get_counter(gul14::string_view counter) const
+{
+    std::lock_guard<std::mutex> lock{ mutex_ };
+    auto it = counters_.find(counter);
+    return it == counters_.end() ? 0 : it->second;
+}
+
+LatencyHistogram MetricsCollector::get_histogram(gul14::string_view operation) const
+{
+    std::lock_guard<std::mutex> lock{ mutex_ };
+    auto it = histograms_.find(operation);
+    return it == histograms_.end() ? LatencyHistogram{ } : it->second;
+}
+
+std::map<std::string, std::uint64_t> MetricsCollector::get_counters() const
+{
+    std::lock_guard<std::mutex> lock{ mutex_ };
+    return { counters_.begin(), counters_.end() };
+}
+
+std::map<std::string, LatencyHistogram> MetricsCollector::get_histograms() const
+{
+    std::lock_guard<std::mutex> lock{ mutex_ };
+    return { histograms_.begin(), histograms_.end() };
+}
+
+void MetricsCollector::reset()
+{
+    std::lock_guard<std::mutex> lock{ mutex_ };
+    counters_.clear();
+    histograms_.clear();
+}
+
+} // namespace git
@@ -22,18 +22,37 @@
 
 // SPDX-License-Identifier: LGPL-2.1-or-later
 
+#include <future>
+#include <string>
+
 #include <git2.h>
 #include <gul14/cat.h>
+#include <gul14/finalizer.h>
 
 #include "libgit4cpp/Error.h"
 #include "libgit4cpp/Remote.h"
 #include "libgit4cpp/wrapper_functions.h"
 #include "credentials_callback.h"
+#include "remote_callbacks.h"
+#include "scoped_timer.h"
 
 using gul14::cat;
 
 namespace git {
 
+namespace {
+
+// Callbacks for connections that outlive a single operation: they must not refer to
+// the state of the operation that happened to open the connection.
+git_remote_callbacks make_session_callbacks()
+{
+    git_remote_callbacks callbacks = GIT_REMOTE_CALLBACKS_INIT;
+    callbacks.credentials = get_dummy_credentials_callback();
+    return callbacks;
+}
+
+} // anonymous namespace
+
 Remote::Remote(LibGitRemote&& remote_ptr)
     : remote_{ std::move(remote_ptr) }
 {
@@ -53,37 +72,167 @@ std::string Remote::get_url() const
     return url ? url : "";
 }
 
-std::vector<std::string> Remote::list_references()
+RemoteReferenceList Remote::list_references(gul14::string_view prefix)
 {
-    if (!git_remote_connected(remote_.get()))
-    {
-        git_remote_callbacks callbacks = GIT_REMOTE_CALLBACKS_INIT;
-        callbacks.credentials = get_dummy_credentials_callback();
+    return list_references_impl(prefix, nullptr);
+}
 
-        int error = git_remote_connect(remote_.get(), GIT_DIRECTION_FETCH, &callbacks,
-            nullptr, nullptr);
-        if (error < 0)
-        {
-            throw Error{ cat("Cannot connect to remote \"", get_name(), "\": ",
-                git_error_last()->message) };
-        }
-    }
+std::future<RemoteReferenceList>
+Remote::list_references_async(gul14::string_view prefix, CancellationToken token) const
+{
+    return std::async(std::launch::async,
+        [url = get_url(), prefix = std::string(prefix), token]() {
+            LibraryContext library;
+
+            throw_if_cancelled(&token, "Listing references");
+
+            git_remote* remote_ptr = nullptr;
+            if (git_remote_create_detached(&remote_ptr, url.c_str()))
+            {
+                throw Error{ cat("Cannot create remote for ", url, ": ",
+                    git_error_last()->message) };
+            }
+
+            Remote remote{ LibGitRemote{ remote_ptr } };
+            return remote.list_references_impl(prefix, &token);
+        });
+}
+
+RemoteReferenceList Remote::list_references_impl(gul14::string_view prefix,
+    const CancellationToken* token)
+{
+    ScopedTimer timer{ "Remote::list_references" };
+    RemoteCallbackState state;
+    state.token = token;
+
+    const bool temporary = acquire_connection(RemoteDirection::fetch,
+        make_remote_callbacks(state), true);
+    auto release = gul14::finally([this, temporary]() { release_connection(temporary); });
+
+    throw_if_cancelled(token, "Listing references");
 
     const git_remote_head** out{ nullptr };
     size_t size{ 0 };
     auto error = git_remote_ls(&out, &size, remote_.get());
     if (error)
     {
-        throw Error{ cat("Cannot list references on remote \"", get_name(), "\": ",
+        throw Error{ error, cat("Cannot list references on remote \"", get_name(), "\": ",
             git_error_last()->message) };
     }
 
-    std::vector<std::string> refs;
-    refs.reserve(size);
-    for (size_t i = 0; i != size; ++i)
-        refs.emplace_back(out[i]->name);
+    return RemoteReferenceList{ out, size, prefix };
+}
+
+void Remote::connect(RemoteDirection direction)
+{
+    ScopedTimer timer{ "Remote::connect" };
+    disconnect();
+    open_connection(direction, make_session_callbacks());
+    keep_connection_ = true;
+}
+
+void Remote::disconnect() noexcept
+{
+    keep_connection_ = false;
+    if (git_remote_connected(remote_.get()))
+        git_remote_disconnect(remote_.get());
+}
+
+bool Remote::is_connected() const noexcept
+{
+    return keep_connection_ && git_remote_connected(remote_.get());
+}
+
+bool Remote::disconnect_if_idle() noexcept
+{
+    if (not is_connected() || not is_idle())
+        return false;
+
+    disconnect();
+    return true;
+}
+
+bool Remote::acquire_connection(RemoteDirection direction,
+    const git_remote_callbacks& callbacks, bool accept_any_direction, bool transfer) const
+{
+    if (git_remote_connected(remote_.get()))
+    {
+        const bool session_used_up = transfer && transfer_done_ && has_stateful_transport();
+
+        if (keep_connection_ && (accept_any_direction || direction == direction_)
+            && not is_idle() && not session_used_up)
+        {
+            last_used_ = std::chrono::steady_clock::now();
+            return false;
+        }
+
+        git_remote_disconnect(remote_.get());
+    }
+
+    if (keep_connection_)
+    {
+        open_connection(direction, make_session_callbacks());
+        return false;
+    }
+
+    open_connection(direction, callbacks);
+    return true;
+}
+
+void Remote::release_connection(bool temporary, bool transfer) const noexcept
+{
+    if (temporary)
+    {
+        git_remote_disconnect(remote_.get());
+        return;
+    }
+
+    last_used_ = std::chrono::steady_clock::now();
+    if (transfer)
+        transfer_done_ = true;
+}
+
+bool Remote::has_stateful_transport() const
+{
+    const std::string url = get_url();
+
+    for (const char* scheme : { "ssh://", "git://", "ssh+git://", "git+ssh://" })
+    {
+        if (url.rfind(scheme, 0) == 0)
+            return true;
+    }
+
+    // scp-like syntax "user@host:path/to/repo"
+    const auto colon = url.find(':');
+    return url.find("://") == std::string::npos && colon != std::string::npos
+        && colon < url.find('/');
+}
+
+bool Remote::is_idle() const noexcept
+{
+    return idle_timeout_.count() > 0
+        && std::chrono::steady_clock::now() - last_used_ > idle_timeout_;
+}
+
+void Remote::open_connection(RemoteDirection direction,
+    const git_remote_callbacks& callbacks) const
+{
+    const auto dir = direction == RemoteDirection::push ? GIT_DIRECTION_PUSH
+                                                         : GIT_DIRECTION_FETCH;
+
+    int error = git_remote_connect(remote_.get(), dir, &callbacks, nullptr, nullptr);
+    if (error < 0)
+    {
+        if (error == GIT_EUSER)
+            throw Error{ error, cat("Connecting to remote \"", get_name(), "\" cancelled") };
+
+        throw Error{ error, cat("Cannot connect to remote \"", get_name(), "\": ",
+            git_error_last()->message) };
+    }
 
-    return refs;
+    direction_ = direction;
+    last_used_ = std::chrono::steady_clock::now();
+    transfer_done_ = false;
 }
 
 } // namespace git
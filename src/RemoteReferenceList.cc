@@ -0,0 +1,152 @@
+/**
+ * \file   RemoteReferenceList.cc
+ * \date   Created on October 14, 2026
+ * \brief  Implementation of the RemoteReferenceList class.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <cstring>
+#include <limits>
+
+#include <gul14/cat.h>
+
+#include "libgit4cpp/Error.h"
+#include "libgit4cpp/RemoteReferenceList.h"
+
+using gul14::cat;
+
+namespace git {
+
+namespace {
+
+constexpr gul14::string_view peeled_suffix{ "^{}" };
+
+bool starts_with(gul14::string_view str, gul14::string_view prefix) noexcept
+{
+    return str.substr(0, prefix.size()) == prefix;
+}
+
+bool ends_with(gul14::string_view str, gul14::string_view suffix) noexcept
+{
+    return str.size() >= suffix.size()
+        && str.substr(str.size() - suffix.size()) == suffix;
+}
+
+} // anonymous namespace
+
+
+RemoteReferenceList::RemoteReferenceList(const git_remote_head** heads,
+    std::size_t nr_heads, gul14::string_view prefix)
+{
+    std::size_t nr_chars = 0;
+    for (std::size_t i = 0; i != nr_heads; ++i)
+        nr_chars += std::strlen(heads[i]->name);
+
+    entries_.reserve(nr_heads);
+    pool_.reserve(nr_chars);
+
+    for (std::size_t i = 0; i != nr_heads; ++i)
+    {
+        const git_remote_head* head = heads[i];
+        const gul14::string_view name{ head->name };
+
+        if (not starts_with(name, prefix))
+            continue;
+
+        if (ends_with(name, peeled_suffix))
+        {
+            // The peeled entry normally directly follows the tag, so search backwards
+            const auto tag_name = name.substr(0, name.size() - peeled_suffix.size());
+            for (auto it = entries_.rbegin(); it != entries_.rend(); ++it)
+            {
+                if (name_of(*it) == tag_name)
+                {
+                    it->peeled_id = head->oid;
+                    it->has_peeled_id = true;
+                    break;
+                }
+            }
+            continue;
+        }
+
+        const gul14::string_view symref{ head->symref_target ? head->symref_target : "" };
+
+        Entry e;
+        e.name_offset = store(name);
+        e.name_size = static_cast<std::uint32_t>(name.size());
+        e.symref_offset = store(symref);
+        e.symref_size = static_cast<std::uint32_t>(symref.size());
+        e.id = head->oid;
+        e.peeled_id = git_oid{ };
+        e.has_peeled_id = false;
+        entries_.push_back(e);
+    }
+}
+
+RemoteReference RemoteReferenceList::operator[](size_type idx) const noexcept
+{
+    const Entry& e = entries_[idx];
+
+    RemoteReference ref;
+    ref.name = name_of(e);
+    ref.id = e.id;
+    if (e.has_peeled_id)
+        ref.peeled_id = e.peeled_id;
+    ref.symref_target = gul14::string_view{ pool_.data() + e.symref_offset, e.symref_size };
+    return ref;
+}
+
+gul14::optional<RemoteReference>
+RemoteReferenceList::find(gul14::string_view name) const noexcept
+{
+    for (size_type i = 0; i != entries_.size(); ++i)
+    {
+        if (name_of(entries_[i]) == name)
+            return (*this)[i];
+    }
+    return gul14::nullopt;
+}
+
+std::vector<std::string> RemoteReferenceList::names() const
+{
+    std::vector<std::string> result;
+    result.reserve(entries_.size());
+    for (const auto& e : entries_)
+        result.emplace_back(name_of(e));
+    return result;
+}
+
+gul14::string_view RemoteReferenceList::name_of(const Entry& e) const noexcept
+{
+    return gul14::string_view{ pool_.data() + e.name_offset, e.name_size };
+}
+
+std::uint32_t RemoteReferenceList::store(gul14::string_view str)
+{
+    const std::size_t offset = pool_.size();
+
+    if (str.size() > std::numeric_limits<std::uint32_t>::max() - offset)
+        throw Error{ cat("Reference list exceeds maximum size of ",
+            std::numeric_limits<std::uint32_t>::max(), " bytes") };
+
+    pool_.append(str.data(), str.size());
+    return static_cast<std::uint32_t>(offset);
+}
+
+} // namespace git
@@ -22,9 +22,21 @@
 
 // SPDX-License-Identifier: LGPL-2.1-or-later
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <future>
 #include <iostream>
+#include <map>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#include <sys/stat.h>
+
 #include <git2.h>
 #include <gul14/cat.h>
 #include <gul14/finalizer.h>
@@ -32,24 +44,649 @@
 #include "libgit4cpp/Error.h"
 #include "libgit4cpp/Repository.h"
 #include "libgit4cpp/wrapper_functions.h"
+#include "blob_staging.h"
 #include "credentials_callback.h"
+#include "diff_result.h"
+#include "remote_callbacks.h"
+#include "scoped_timer.h"
+#include "status_entry.h"
+#include "tree_building.h"
 
 using gul14::cat;
 
+#if LIBGIT2_FULLVERSION >= 99000
+using LibGitIndexerProgress = git_indexer_progress;
+#else
+using LibGitIndexerProgress = git_transfer_progress;
+#endif
+
+extern "C" {
+
+// Diff notification callback that stops the diff at the first reported file.
+static int abort_on_first_delta(const git_diff* /*diff*/,
+    const git_diff_delta* /*delta_to_add*/, const char* /*matched_pathspec*/,
+    void* /*payload*/)
+{
+    return GIT_EUSER;
+}
+
+// Remote creation callback for single-branch clones: the payload is the fetch refspec.
+static int create_single_branch_remote(git_remote** out, git_repository* repo,
+    const char* name, const char* url, void* payload)
+{
+    const auto* fetchspec = static_cast<const std::string*>(payload);
+    return git_remote_create_with_fetchspec(out, repo, name, url, fetchspec->c_str());
+}
+
+// Checkout notification callback forwarding to a CheckoutNotifyCallback (the payload).
+static int forward_checkout_notification(git_checkout_notify_t why, const char* path,
+    const git_diff_file* /*baseline*/, const git_diff_file* /*target*/,
+    const git_diff_file* /*workdir*/, void* payload)
+{
+    const auto* callback = static_cast<const git::CheckoutNotifyCallback*>(payload);
+
+    git::CheckoutNotification notification;
+    switch (why)
+    {
+    case GIT_CHECKOUT_NOTIFY_CONFLICT:
+        notification = git::CheckoutNotification::conflict;
+        break;
+    case GIT_CHECKOUT_NOTIFY_DIRTY:
+        notification = git::CheckoutNotification::dirty;
+        break;
+    case GIT_CHECKOUT_NOTIFY_UPDATED:
+        notification = git::CheckoutNotification::updated;
+        break;
+    case GIT_CHECKOUT_NOTIFY_UNTRACKED:
+        notification = git::CheckoutNotification::untracked;
+        break;
+    case GIT_CHECKOUT_NOTIFY_IGNORED:
+        notification = git::CheckoutNotification::ignored;
+        break;
+    default:
+        return 0;
+    }
+
+    try
+    {
+        return (*callback)(notification, path) ? 0 : GIT_EUSER;
+    }
+    catch (...)
+    {
+        return GIT_EUSER;
+    }
+}
+
+// Pack builder progress callback forwarding to a RepackProgressCallback (the payload).
+static int forward_packbuilder_progress(int stage, uint32_t current, uint32_t total,
+    void* payload)
+{
+    const auto* callback = static_cast<const git::RepackProgressCallback*>(payload);
+    const auto repack_stage = stage == GIT_PACKBUILDER_ADDING_OBJECTS
+        ? git::RepackStage::adding_objects : git::RepackStage::deltification;
+
+    try
+    {
+        return (*callback)(repack_stage, current, total) ? 0 : GIT_EUSER;
+    }
+    catch (...)
+    {
+        return GIT_EUSER;
+    }
+}
+
+// Indexer progress callback forwarding to a RepackProgressCallback (the payload).
+static int forward_indexer_progress(const LibGitIndexerProgress* stats, void* payload)
+{
+    const auto* callback = static_cast<const git::RepackProgressCallback*>(payload);
+
+    try
+    {
+        return (*callback)(git::RepackStage::indexing, stats->indexed_objects,
+            stats->total_objects) ? 0 : GIT_EUSER;
+    }
+    catch (...)
+    {
+        return GIT_EUSER;
+    }
+}
+
+} // extern "C"
+
 namespace git {
 
+namespace {
+
+// Open a private handle of the repository and look up a remote in it, for use on a
+// worker thread. The repository handle is destroyed after the remote.
+std::pair<LibGitRepository, Remote> open_remote_for_worker(
+    const std::filesystem::path& repo_path, const std::string& remote_name)
+{
+    auto repo = repository_open(repo_path);
+    if (not repo)
+        throw Error{ cat("Cannot open repository: ", git_error_last()->message) };
+
+    auto remote_ptr = remote_lookup(repo.get(), remote_name);
+    if (not remote_ptr)
+        throw Error{ cat("Cannot find remote \"", remote_name, "\"") };
+
+    return { std::move(repo), Remote{ std::move(remote_ptr) } };
+}
+
+// Run an operation for each of the named remotes on a pool of worker threads. Each
+// operation uses its own handle of the repository because libgit2 objects must not be
+// shared between threads.
+template <typename Operation>
+std::vector<RemoteResult> run_on_remotes(const std::filesystem::path& repo_path,
+    const std::vector<std::string>& remote_names, unsigned int nr_threads, Operation op)
+{
+    std::vector<RemoteResult> results(remote_names.size());
+    std::atomic<std::size_t> next_idx{ 0 };
+
+    auto work = [&]() {
+        for (std::size_t i = next_idx++; i < remote_names.size(); i = next_idx++)
+        {
+            RemoteResult& result = results[i];
+            result.remote_name = remote_names[i];
+
+            const auto start = std::chrono::steady_clock::now();
+            try
+            {
+                auto remote = open_remote_for_worker(repo_path, remote_names[i]);
+                op(remote.second, result);
+                result.ok = true;
+            }
+            catch (const std::system_error& e)
+            {
+                result.error = e.code();
+                result.error_message = e.what();
+            }
+            catch (const std::exception& e)
+            {
+                result.error = std::error_code{ GIT_ERROR, git_category() };
+                result.error_message = e.what();
+            }
+            catch (...)
+            {
+                result.error = std::error_code{ GIT_ERROR, git_category() };
+                result.error_message = "Unknown exception";
+            }
+            result.duration = std::chrono::steady_clock::now() - start;
+        }
+    };
+
+    if (nr_threads == 0)
+        nr_threads = std::max(1u, std::thread::hardware_concurrency());
+    if (remote_names.size() < nr_threads)
+        nr_threads = static_cast<unsigned int>(remote_names.size());
+
+    std::vector<std::thread> workers;
+    workers.reserve(nr_threads);
+    for (unsigned int i = 0; i != nr_threads; ++i)
+        workers.emplace_back(work);
+    for (auto& worker : workers)
+        worker.join();
+
+    return results;
+}
+
+// Ask a remote for its default branch and return its short name (e.g. "main").
+std::string remote_default_branch(const std::string& url,
+    const git_remote_callbacks& callbacks)
+{
+    git_remote* remote_ptr = nullptr;
+    if (git_remote_create_detached(&remote_ptr, url.c_str()))
+        throw Error{ cat("Cannot create remote for ", url, ": ", git_error_last()->message) };
+    LibGitRemote remote{ remote_ptr };
+
+    int error = git_remote_connect(remote.get(), GIT_DIRECTION_FETCH, &callbacks,
+        nullptr, nullptr);
+    if (error)
+        throw Error{ error, cat("Cannot connect to ", url, ": ", git_error_last()->message) };
+    auto disconnect = gul14::finally([&remote]() { git_remote_disconnect(remote.get()); });
+
+    git_buf buf{ };
+    auto dispose = gul14::finally([&buf]() { git_buf_dispose(&buf); });
+    error = git_remote_default_branch(&buf, remote.get());
+    if (error)
+    {
+        throw Error{ error, cat("Cannot determine the default branch of ", url, ": ",
+            git_error_last()->message) };
+    }
+
+    std::string branch{ buf.ptr, buf.size };
+    if (branch.compare(0, 11, "refs/heads/") == 0)
+        branch.erase(0, 11);
+    return branch;
+}
+
+// Resolve a revision (e.g. "HEAD~1") and return the tree it points to.
+LibGitTree revision_tree(git_repository* repo, const std::string& revision)
+{
+    git_object* obj = nullptr;
+    git_object* tree = nullptr;
+    auto free_object = gul14::finally([&obj]() { git_object_free(obj); });
+
+    if (git_revparse_single(&obj, repo, revision.c_str())
+        || git_object_peel(&tree, obj, GIT_OBJECT_TREE))
+    {
+        throw Error{ cat("Cannot resolve revision \"", revision, "\": ",
+            git_error_last()->message) };
+    }
+
+    return LibGitTree{ reinterpret_cast<git_tree*>(tree) };
+}
+
+// Convert a libgit2 return value into a failed Result.
+git_error_code to_error_code(int error) noexcept
+{
+    return static_cast<git_error_code>(error);
+}
+
+// Run a blob through the configured filters (for a check-out to the given path).
+int filter_blob(git_buf& buf, git_blob* blob, const std::string& path)
+{
+#if LIBGIT2_FULLVERSION >= 99000
+    git_blob_filter_options filter_opt = GIT_BLOB_FILTER_OPTIONS_INIT;
+    return git_blob_filter(&buf, blob, path.c_str(), &filter_opt);
+#else
+    return git_blob_filtered_content(&buf, blob, path.c_str(), 1);
+#endif
+}
+
+// Resolve a revision (e.g. "HEAD~1") and return the ID of the tree it points to.
+git_oid revision_tree_id(git_repository* repo, const std::string& revision)
+{
+    git_object* obj = nullptr;
+    git_object* commit = nullptr;
+    auto free_objects = gul14::finally([&obj, &commit]()
+        {
+            git_object_free(commit);
+            git_object_free(obj);
+        });
+
+    if (git_revparse_single(&obj, repo, revision.c_str()))
+    {
+        throw Error{ cat("Cannot resolve revision \"", revision, "\": ",
+            git_error_last()->message) };
+    }
+
+    if (git_object_type(obj) == GIT_OBJECT_TREE)
+        return *git_object_id(obj);
+
+    // Peeling to the commit avoids parsing the tree itself
+    if (git_object_peel(&commit, obj, GIT_OBJECT_COMMIT))
+    {
+        throw Error{ cat("Cannot resolve revision \"", revision, "\": ",
+            git_error_last()->message) };
+    }
+
+    return *git_commit_tree_id(reinterpret_cast<git_commit*>(commit));
+}
+
+// Convert a libgit2 tree entry into a TreeEntry with the given path.
+TreeEntry make_tree_entry(const git_tree_entry* entry, std::string path)
+{
+    TreeEntry result;
+    result.path = std::move(path);
+    result.id = *git_tree_entry_id(entry);
+
+    switch (git_tree_entry_filemode(entry))
+    {
+    case GIT_FILEMODE_BLOB_EXECUTABLE:
+        result.type = TreeEntryType::executable;
+        break;
+    case GIT_FILEMODE_LINK:
+        result.type = TreeEntryType::symlink;
+        break;
+    case GIT_FILEMODE_TREE:
+        result.type = TreeEntryType::directory;
+        break;
+    case GIT_FILEMODE_COMMIT:
+        result.type = TreeEntryType::submodule;
+        break;
+    default:
+        result.type = TreeEntryType::file;
+    }
+
+    return result;
+}
+
+// Append the entries of a tree to a vector, prefixing their names with a directory
+// path. Subtrees of a recursive listing are read directly and not via the tree cache,
+// which would otherwise be flushed by a single large listing.
+void collect_tree_entries(git_repository* repo, const git_tree* tree,
+    const std::string& prefix, bool recursive, std::vector<TreeEntry>& out)
+{
+    const std::size_t count = git_tree_entrycount(tree);
+    out.reserve(out.size() + count);
+
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        const git_tree_entry* entry = git_tree_entry_byindex(tree, i);
+        out.push_back(make_tree_entry(entry, prefix + git_tree_entry_name(entry)));
+
+        if (not recursive || not out.back().is_directory())
+            continue;
+
+        auto subtree = tree_lookup(repo, out.back().id);
+        if (not subtree)
+        {
+            throw Error{ cat("Cannot read tree \"", out.back().path, "\": ",
+                git_error_last()->message) };
+        }
+        collect_tree_entries(repo, subtree.get(), out.back().path + "/", true, out);
+    }
+}
+
+// A loose object file in the objects directory.
+struct LooseObject
+{
+    git_oid id;
+    std::filesystem::path file;
+};
+
+// Find all loose objects in an objects directory (".git/objects"). The files live in
+// fan-out directories named after the first two hex digits of their ID.
+std::vector<LooseObject> find_loose_objects(const std::filesystem::path& objects_dir)
+{
+    namespace fs = std::filesystem;
+
+    std::vector<LooseObject> objects;
+    std::error_code ec;
+
+    for (const auto& dir : fs::directory_iterator{ objects_dir, ec })
+    {
+        const auto prefix = dir.path().filename().string();
+        if (prefix.size() != 2 || not dir.is_directory(ec))
+            continue;
+
+        for (const auto& file : fs::directory_iterator{ dir.path(), ec })
+        {
+            const auto hex = prefix + file.path().filename().string();
+            LooseObject object;
+            if (hex.size() != GIT_OID_HEXSZ || git_oid_fromstr(&object.id, hex.c_str()))
+                continue; // e.g. a temporary file
+            object.file = file.path();
+            objects.push_back(std::move(object));
+        }
+    }
+
+    return objects;
+}
+
+// Remove trailing slashes from a directory path.
+std::string strip_trailing_slashes(std::string path)
+{
+    while (not path.empty() && path.back() == '/')
+        path.pop_back();
+    return path;
+}
+
+// Look up the blob at a path in a tree.
+LibGitBlob tree_blob(git_repository* repo, const git_tree* tree, const std::string& path)
+{
+    git_tree_entry* entry = nullptr;
+    int error = git_tree_entry_bypath(&entry, tree, path.c_str());
+    if (error)
+    {
+        throw Error{ error, cat("Cannot find \"", path, "\": ",
+            git_error_last()->message) };
+    }
+    auto free_entry = gul14::finally([entry]() { git_tree_entry_free(entry); });
+
+    if (git_tree_entry_type(entry) != GIT_OBJECT_BLOB)
+        throw Error{ cat("\"", path, "\" is not a file") };
+
+    git_blob* blob = nullptr;
+    error = git_blob_lookup(&blob, repo, git_tree_entry_id(entry));
+    if (error)
+    {
+        throw Error{ error, cat("Cannot read \"", path, "\": ",
+            git_error_last()->message) };
+    }
+    return LibGitBlob{ blob };
+}
+
+// Resolve a revision (e.g. "origin/main") and return the ID of the commit it points to.
+git_oid revision_commit_id(git_repository* repo, const std::string& revision)
+{
+    git_object* obj = nullptr;
+    git_object* commit = nullptr;
+    auto free_objects = gul14::finally([&]() {
+        git_object_free(commit);
+        git_object_free(obj);
+    });
+
+    if (git_revparse_single(&obj, repo, revision.c_str())
+        || git_object_peel(&commit, obj, GIT_OBJECT_COMMIT))
+    {
+        throw Error{ cat("Cannot resolve revision \"", revision, "\": ",
+            git_error_last()->message) };
+    }
+
+    return *git_object_id(commit);
+}
+
+// Return the ID of the commit a reference points to.
+git_oid reference_commit_id(git_reference* ref)
+{
+    git_object* commit = nullptr;
+    if (git_reference_peel(&commit, ref, GIT_OBJECT_COMMIT))
+    {
+        throw Error{ cat("Cannot resolve reference \"", git_reference_name(ref), "\": ",
+            git_error_last()->message) };
+    }
+    auto free_commit = gul14::finally([commit]() { git_object_free(commit); });
+
+    return *git_object_id(commit);
+}
+
+AheadBehind count_ahead_behind(git_repository* repo, const git_oid& local,
+    const git_oid& upstream)
+{
+    AheadBehind counts;
+    if (git_oid_equal(&local, &upstream))
+        return counts;
+
+    int error = git_graph_ahead_behind(&counts.ahead, &counts.behind, repo, &local,
+        &upstream);
+    if (error)
+        throw Error{ error, cat("Cannot compare commits: ", git_error_last()->message) };
+    return counts;
+}
+
+// Order pairs of object IDs, for memoizing ahead/behind counts.
+struct OidPairLess
+{
+    bool operator()(const std::pair<git_oid, git_oid>& a,
+        const std::pair<git_oid, git_oid>& b) const noexcept
+    {
+        int cmp = git_oid_cmp(&a.first, &b.first);
+        if (cmp != 0)
+            return cmp < 0;
+        return git_oid_cmp(&a.second, &b.second) < 0;
+    }
+};
+
+git_clone_local_t to_clone_local(CloneLocal local) noexcept
+{
+    switch (local)
+    {
+    case CloneLocal::hardlink:
+        return GIT_CLONE_LOCAL;
+    case CloneLocal::copy:
+        return GIT_CLONE_LOCAL_NO_LINKS;
+    case CloneLocal::transport:
+        return GIT_CLONE_NO_LOCAL;
+    case CloneLocal::automatic:
+        break;
+    }
+    return GIT_CLONE_LOCAL_AUTO;
+}
+
+} // anonymous namespace
+
 Repository::Repository(const std::filesystem::path& file_path)
     : repo_path_{ file_path }
 {
-    git_libgit2_init();
     init(file_path);
 }
 
+Repository::Repository(const std::filesystem::path& file_path, LibGitRepository repo,
+    LibGitSignature signature)
+    : repo_path_{ file_path }
+    , repo_{ std::move(repo) }
+    , my_signature_{ std::move(signature) }
+{ }
+
+Repository Repository::open_existing(const std::filesystem::path& path,
+    const OpenOptions& options)
+{
+    ScopedTimer timer{ "Repository::open_existing" };
+    LibraryContext library;
+
+    unsigned int flags = 0;
+    if (not options.search_parents)
+        flags |= GIT_REPOSITORY_OPEN_NO_SEARCH;
+    if (options.cross_filesystem)
+        flags |= GIT_REPOSITORY_OPEN_CROSS_FS;
+    if (options.bare)
+        flags |= GIT_REPOSITORY_OPEN_BARE;
+    if (options.no_dotgit)
+        flags |= GIT_REPOSITORY_OPEN_NO_DOTGIT;
+
+    git_repository* repo_ptr = nullptr;
+    int error = git_repository_open_ext(&repo_ptr, path.c_str(), flags, nullptr);
+    if (error)
+    {
+        throw Error{ error, cat("Cannot open repository ", path.string(), ": ",
+            git_error_last()->message) };
+    }
+    LibGitRepository repo{ repo_ptr };
+
+    // libgit2 reports the directories with a trailing slash
+    const char* workdir = git_repository_workdir(repo.get());
+    std::filesystem::path repo_path{ workdir ? workdir : git_repository_path(repo.get()) };
+    if (not repo_path.has_filename())
+        repo_path = repo_path.parent_path();
+
+    return Repository{ repo_path, std::move(repo) };
+}
+
+Repository Repository::clone(const std::string& url, const std::filesystem::path& path,
+    const CloneOptions& options)
+{
+    ScopedTimer timer{ "Repository::clone" };
+    LibraryContext library;
+
+    RemoteCallbackState state;
+    if (options.on_progress)
+        state.on_progress = &options.on_progress;
+    auto count_bytes = gul14::finally([&state]() {
+        count_metric("Repository::clone.received_bytes", state.received_bytes);
+    });
+
+    git_clone_options clone_options;
+    int error = git_clone_init_options(&clone_options, GIT_CLONE_OPTIONS_VERSION);
+    if (error)
+    {
+        throw Error{ error, cat("Cannot initialize clone options: ",
+            git_error_last()->message) };
+    }
+
+    clone_options.fetch_opts.callbacks = make_remote_callbacks(state);
+    clone_options.bare = options.bare ? 1 : 0;
+    clone_options.local = to_clone_local(options.local);
+    if (not options.checkout)
+        clone_options.checkout_opts.checkout_strategy = GIT_CHECKOUT_NONE;
+
+    if (options.depth > 0)
+    {
+#if LIBGIT2_FULLVERSION >= 1007000
+        clone_options.fetch_opts.depth = options.depth;
+#else
+        throw Error{ "Shallow clones require libgit2 1.7 or newer" };
+#endif
+    }
+
+    std::string branch = options.branch;
+    std::string fetchspec;
+    if (options.single_branch)
+    {
+        if (branch.empty())
+            branch = remote_default_branch(url, clone_options.fetch_opts.callbacks);
+
+        fetchspec = cat("+refs/heads/", branch, ":refs/remotes/origin/", branch);
+        clone_options.remote_cb = create_single_branch_remote;
+        clone_options.remote_cb_payload = &fetchspec;
+    }
+    if (not branch.empty())
+        clone_options.checkout_branch = branch.c_str();
+
+    auto repo = git::clone(url, path.string(), &clone_options);
+    if (not repo)
+    {
+        if (state.cancelled)
+            throw Error{ GIT_EUSER, cat("Clone of ", url, " cancelled") };
+        throw Error{ cat("Cannot clone ", url, ": ", git_error_last()->message) };
+    }
+
+    return Repository{ path, std::move(repo) };
+}
+
+Repository::Repository(Repository&& other) noexcept
+    : library_{ std::move(other.library_) }
+    , repo_path_{ std::move(other.repo_path_) }
+    , repo_{ std::move(other.repo_) }
+    , my_signature_{ std::move(other.my_signature_) }
+    , index_{ std::move(other.index_) }
+    , index_transaction_depth_{ other.index_transaction_depth_ }
+    , index_dirty_{ other.index_dirty_ }
+    , index_rollback_{ other.index_rollback_ }
+    , head_cache_{ std::move(other.head_cache_) }
+    , tree_cache_{ std::move(other.tree_cache_) }
+{
+    other.release();
+}
+
+Repository& Repository::operator=(Repository&& other) noexcept
+{
+    if (this == &other)
+        return *this;
+
+    release();
+
+    repo_path_ = std::move(other.repo_path_);
+    repo_ = std::move(other.repo_);
+    my_signature_ = std::move(other.my_signature_);
+    index_ = std::move(other.index_);
+    index_transaction_depth_ = other.index_transaction_depth_;
+    index_dirty_ = other.index_dirty_;
+    index_rollback_ = other.index_rollback_;
+    head_cache_ = std::move(other.head_cache_);
+    tree_cache_ = std::move(other.tree_cache_);
+
+    other.release();
+    return *this;
+}
+
 Repository::~Repository()
 {
+    release();
+}
+
+void Repository::release() noexcept
+{
+    head_cache_.commit.reset();
+    head_cache_.valid = false;
+    tree_cache_.clear();
+    index_.reset();
+    index_transaction_depth_ = 0;
+    index_dirty_ = false;
+    index_rollback_ = false;
     repo_.reset();
     my_signature_.reset();
-    git_libgit2_shutdown();
 }
 
 void Repository::make_signature()
@@ -59,10 +696,18 @@ void Repository::make_signature()
         my_signature_ = signature_new("Taskomat", "(none)", std::time(0), 0);
 }
 
+git_signature* Repository::get_signature()
+{
+    if (not my_signature_)
+        make_signature();
+    return my_signature_.get();
+}
+
 void Repository::reset_repo()
 {
-    repo_.reset();
-    my_signature_.reset();
+    ScopedTimer timer{ "Repository::reset_repo" };
+    // Drop all handles that belong to the old git_repository, including cached trees
+    release();
 
     // initialize repo and signature again
     init(repo_path_);
@@ -70,8 +715,14 @@ void Repository::reset_repo()
 
 std::string Repository::get_last_commit_message()
 {
-    const auto commit = get_commit();
-    return git_commit_message(commit.get());
+    ScopedTimer timer{ "Repository::get_last_commit_message" };
+    return git_commit_message(head_commit());
+}
+
+CommitLog Repository::log(const LogOptions& options)
+{
+    ScopedTimer timer{ "Repository::log" };
+    return CommitLog{ repo_.get(), options };
 }
 
 std::filesystem::path Repository::get_path() const
@@ -86,14 +737,13 @@ git_repository* Repository::get_repo()
 
 void Repository::update(const std::string& glob)
 {
-    auto index = repository_index(repo_.get());
-
+    ScopedTimer timer{ "Repository::update" };
     char *paths[1] = {const_cast<char*>(glob.c_str())};
     git_strarray array = { paths, 1 };
 
     // update index to check for files
-    git_index_update_all(index.get(), &array, nullptr, nullptr);
-    git_index_write(index.get());
+    git_index_update_all(get_index(), &array, nullptr, nullptr);
+    write_index();
 }
 
 void Repository::init(const std::filesystem::path& file_path)
@@ -108,31 +758,25 @@ void Repository::init(const std::filesystem::path& file_path)
         if (not repo_)
             throw Error{ "Git init failed" };
 
-        make_signature();
         update();
         commit_initial();
     }
-    else
-    {
-        make_signature();
-    }
 }
 
 void Repository::commit_initial()
 {
     // prepare gitlib data types
-    auto index = repository_index(repo_.get());
     git_oid tree_id, commit_id;
 
-    git_index_write_tree(&tree_id, index.get());
+    git_index_write_tree(&tree_id, get_index());
     auto tree = tree_lookup(repo_.get(), tree_id);
 
     int error = git_commit_create(
         &commit_id,
         repo_.get(),
         "HEAD",
-        my_signature_.get(),
-        my_signature_.get(),
+        get_signature(),
+        get_signature(),
         "UTF-8",
         "Initial commit",
         tree.get(),
@@ -142,26 +786,27 @@ void Repository::commit_initial()
 
     if (error)
         throw Error{ cat("Initial commit failed: ", git_error_last()->message) };
+
+    invalidate_head_cache();
 }
 
 void Repository::commit(const std::string& commit_message)
 {
-    auto parent_commit = get_commit();
-    const git_commit* raw_commit = parent_commit.get();
+    ScopedTimer timer{ "Repository::commit" };
+    const git_commit* raw_commit = head_commit();
 
     //define types for commit call and get index
-    auto index = repository_index(repo_.get());
     git_oid tree_id, commit_id;
 
-    git_index_write_tree(&tree_id, index.get());
+    git_index_write_tree(&tree_id, get_index());
     auto tree = tree_lookup(repo_.get(), tree_id);
 
     int error = git_commit_create(
         &commit_id,
         repo_.get(),
         "HEAD",
-        my_signature_.get(),
-        my_signature_.get(),
+        get_signature(),
+        get_signature(),
         "UTF-8",
         commit_message.c_str(),
         tree.get(),
@@ -171,61 +816,445 @@ void Repository::commit(const std::string& commit_message)
 
     if (error)
         throw Error{ cat("Commit: ", git_error_last()->message) };
+
+    update_head_cache(commit_id);
 }
 
-void Repository::add(const std::string& glob)
+git_oid Repository::commit_files(const TreeChanges& files,
+    const std::string& commit_message)
 {
-    auto gindex = repository_index(repo_.get());
+    ScopedTimer timer{ "Repository::commit_files" };
+    const git_commit* raw_parent = head_commit_or_null();
+    LibGitTree base_tree;
 
-    char *paths[] = { const_cast<char*>(glob.c_str()) };
-    git_strarray array = { paths, 1 };
+    if (raw_parent)
+    {
+        base_tree = commit_tree(const_cast<git_commit*>(raw_parent));
+        if (not base_tree)
+            throw Error{ cat("Cannot find tree of HEAD: ", git_error_last()->message) };
+    }
 
-    int error = git_index_add_all(gindex.get(), &array, GIT_INDEX_ADD_DEFAULT, nullptr,
-        nullptr);
-    if (error)
-        throw Error{ cat("Cannot stage files: ", git_error_last()->message) };
+    const git_oid tree_id = write_tree_with_changes(repo_.get(), base_tree.get(), files);
+    auto tree = tree_lookup(repo_.get(), tree_id);
+    if (not tree)
+        throw Error{ cat("Cannot look up new tree: ", git_error_last()->message) };
 
-    git_index_write(gindex.get());
-}
+    git_oid commit_id;
 
-void Repository::remove_directory(const std::filesystem::path& directory)
-{
-    auto gindex = repository_index(repo_.get());
+    int error = git_commit_create(
+        &commit_id,
+        repo_.get(),
+        "HEAD",
+        get_signature(),
+        get_signature(),
+        "UTF-8",
+        commit_message.c_str(),
+        tree.get(),
+        raw_parent ? 1 : 0,
+        raw_parent ? &raw_parent : nullptr
+    );
 
-    int error = git_index_remove_directory(gindex.get(), directory.c_str(), 0);
     if (error)
-        throw Error{ cat("Cannot remove directory: ", git_error_last()->message) };
+        throw Error{ error, cat("Commit: ", git_error_last()->message) };
+
+    if (raw_parent)
+        update_head_cache(commit_id);
+    else
+        invalidate_head_cache();
 
-    git_index_write(gindex.get());
+    return commit_id;
 }
 
-void Repository::remove_files(const std::vector<std::filesystem::path>& filepaths)
+std::vector<git_oid> Repository::commit_batch(const std::vector<BatchCommit>& records,
+    bool update_index)
 {
-    auto gindex = repository_index(repo_.get());
+    ScopedTimer timer{ "Repository::commit_batch" };
+    std::vector<git_oid> commit_ids;
+    if (records.empty())
+        return commit_ids;
 
-    //remove files from directory
-    //TODO: Teste, ob oberer Teil ausreicht
+    commit_ids.reserve(records.size());
+
+    const git_commit* initial_parent = head_commit_or_null();
+    const bool was_unborn = initial_parent == nullptr;
+    git_oid initial_id;
+    if (not was_unborn)
+        git_oid_cpy(&initial_id, git_commit_id(initial_parent));
+
+    LibGitTree tree;
+    if (initial_parent)
+    {
+        tree = commit_tree(const_cast<git_commit*>(initial_parent));
+        if (not tree)
+            throw Error{ cat("Cannot find tree of HEAD: ", git_error_last()->message) };
+    }
+
+    // Owns the parent of the next commit, except for the initial one (owned by the cache)
+    LibGitCommit parent;
+    const git_commit* raw_parent = initial_parent;
+
+    for (const auto& record : records)
+    {
+        const git_oid tree_id = write_tree_with_changes(repo_.get(), tree.get(),
+            record.changes);
+        tree = tree_lookup(repo_.get(), tree_id);
+        if (not tree)
+            throw Error{ cat("Cannot look up new tree: ", git_error_last()->message) };
+
+        // Do not update any reference yet
+        git_oid commit_id;
+        int error = git_commit_create(&commit_id, repo_.get(), nullptr, get_signature(),
+            get_signature(), "UTF-8", record.message.c_str(), tree.get(),
+            raw_parent ? 1 : 0, raw_parent ? &raw_parent : nullptr);
+        if (error)
+            throw Error{ error, cat("Commit: ", git_error_last()->message) };
+
+        git_commit* commit = nullptr;
+        if (git_commit_lookup(&commit, repo_.get(), &commit_id))
+            throw Error{ cat("Cannot look up new commit: ", git_error_last()->message) };
+        parent.reset(commit);
+        raw_parent = commit;
+
+        commit_ids.push_back(commit_id);
+    }
+
+    // Prepare the index entries before HEAD is moved, so that a failure cannot leave
+    // HEAD advanced and the index half-updated
+    struct IndexUpdate
+    {
+        std::string path;
+        bool remove = true;
+        git_filemode_t mode = GIT_FILEMODE_UNREADABLE;
+        git_oid id{ };
+    };
+    std::vector<IndexUpdate> index_updates;
+
+    if (update_index && not git_repository_is_bare(repo_.get()))
+    {
+        std::unordered_set<std::string> paths;
+        for (const auto& record : records)
+        {
+            for (const auto& change : record.changes)
+                paths.insert(change.first);
+        }
+
+        auto remove_from_index = [&index_updates](const std::string& path) {
+            IndexUpdate update;
+            update.path = path;
+            index_updates.push_back(std::move(update));
+        };
+
+        index_updates.reserve(paths.size());
+        for (const auto& path : paths)
+        {
+            git_tree_entry* entry = nullptr;
+            int error = git_tree_entry_bypath(&entry, tree.get(), path.c_str());
+            if (error == GIT_ENOTFOUND)
+            {
+                remove_from_index(path);
+                continue;
+            }
+            if (error)
+            {
+                throw Error{ error, cat("Cannot find \"", path, "\": ",
+                    git_error_last()->message) };
+            }
+            auto free_entry = gul14::finally([entry]() { git_tree_entry_free(entry); });
+
+            // A file that a later record has turned into a directory: libgit2 rejects
+            // index entries for trees, and the files below it are changed paths as well
+            if (git_tree_entry_type(entry) == GIT_OBJECT_TREE)
+            {
+                remove_from_index(path);
+                continue;
+            }
+
+            IndexUpdate update;
+            update.path = path;
+            update.remove = false;
+            update.mode = git_tree_entry_filemode(entry);
+            git_oid_cpy(&update.id, git_tree_entry_id(entry));
+            index_updates.push_back(std::move(update));
+        }
+    }
+
+    // Advance HEAD (or the branch it points to) once, but only if nobody else moved it
+    git_reference* head_ptr = nullptr;
+    int error = git_reference_lookup(&head_ptr, repo_.get(), "HEAD");
+    if (error)
+        throw Error{ error, cat("Cannot look up HEAD: ", git_error_last()->message) };
+    LibGitReference head{ head_ptr };
+
+    const std::string reflog_message = cat("commit (batch of ", records.size(), "): ",
+        records.back().message.substr(0, records.back().message.find('\n')));
+
+    if (git_reference_type(head.get()) == GIT_REFERENCE_SYMBOLIC)
+    {
+        git_reference* updated = nullptr;
+        const char* target = git_reference_symbolic_target(head.get());
+        if (was_unborn)
+        {
+            error = git_reference_create(&updated, repo_.get(), target, &commit_ids.back(),
+                0, reflog_message.c_str());
+        }
+        else
+        {
+            error = git_reference_create_matching(&updated, repo_.get(), target,
+                &commit_ids.back(), 1, &initial_id, reflog_message.c_str());
+        }
+        git_reference_free(updated);
+    }
+    else
+    {
+        const git_oid* current = git_reference_target(head.get());
+        if (was_unborn || current == nullptr || not git_oid_equal(current, &initial_id))
+        {
+            invalidate_head_cache();
+            throw Error{ GIT_EMODIFIED, "Cannot update HEAD after batch commit: "
+                "HEAD has moved" };
+        }
+        error = git_repository_set_head_detached(repo_.get(), &commit_ids.back());
+    }
+
+    if (error)
+    {
+        invalidate_head_cache();
+        throw Error{ error, cat("Cannot update HEAD after batch commit: ",
+            git_error_last()->message) };
+    }
+
+    if (was_unborn)
+        invalidate_head_cache();
+    else
+        update_head_cache(commit_ids.back());
+
+    if (not index_updates.empty())
+    {
+        git_index* index = get_index();
+
+        // Removals first, so that a file replaced by a directory does not collide with
+        // the new entries below it
+        for (const auto& update : index_updates)
+        {
+            if (update.remove)
+                git_index_remove_bypath(index, update.path.c_str());
+        }
+
+        for (const auto& update : index_updates)
+        {
+            if (update.remove)
+                continue;
+
+            // Without stat data, the file is rehashed by the next status()
+            git_index_entry index_entry{ };
+            index_entry.mode = update.mode;
+            git_oid_cpy(&index_entry.id, &update.id);
+            index_entry.path = update.path.c_str();
+            error = git_index_add(index, &index_entry);
+            if (error)
+            {
+                throw Error{ error, cat("Cannot update index: ",
+                    git_error_last()->message) };
+            }
+        }
+
+        write_index();
+    }
+
+    return commit_ids;
+}
+
+void Repository::add(const std::string& glob)
+{
+    ScopedTimer timer{ "Repository::add" };
+    char *paths[] = { const_cast<char*>(glob.c_str()) };
+    git_strarray array = { paths, 1 };
+
+    int error = git_index_add_all(get_index(), &array, GIT_INDEX_ADD_DEFAULT, nullptr,
+        nullptr);
+    if (error)
+        throw Error{ cat("Cannot stage files: ", git_error_last()->message) };
+
+    write_index();
+}
+
+void Repository::remove_directory(const std::filesystem::path& directory)
+{
+    ScopedTimer timer{ "Repository::remove_directory" };
+    int error = git_index_remove_directory(get_index(), directory.c_str(), 0);
+    if (error)
+        throw Error{ cat("Cannot remove directory: ", git_error_last()->message) };
+
+    write_index();
+}
+
+void Repository::remove_files(const std::vector<std::filesystem::path>& filepaths)
+{
+    ScopedTimer timer{ "Repository::remove_files" };
+    git_index* gindex = get_index();
+
+    //remove files from directory
+    //TODO: Teste, ob oberer Teil ausreicht
     for (auto gfile: filepaths)
     {
-        int error = git_index_remove_bypath(gindex.get(), gfile.c_str());
+        int error = git_index_remove_bypath(gindex, gfile.c_str());
         if (error)
             throw Error{ cat("Cannot remove file: ", git_error_last()->message) };
     }
 
-    git_index_write(gindex.get());
+    write_index();
+}
+
+git_tree* Repository::cached_tree(const git_oid& id)
+{
+    auto it = std::find_if(tree_cache_.begin(), tree_cache_.end(),
+        [&id](const LibGitTree& tree)
+        {
+            return git_oid_equal(git_tree_id(tree.get()), &id);
+        });
+
+    if (it != tree_cache_.end())
+    {
+        tree_cache_.splice(tree_cache_.begin(), tree_cache_, it);
+        return tree_cache_.front().get();
+    }
+
+    auto tree = tree_lookup(repo_.get(), id);
+    if (not tree)
+        throw Error{ cat("Cannot read tree: ", git_error_last()->message) };
+
+    tree_cache_.push_front(std::move(tree));
+    if (tree_cache_.size() > tree_cache_capacity_)
+        tree_cache_.pop_back();
+
+    return tree_cache_.front().get();
+}
+
+git_tree* Repository::cached_directory(const git_oid& root_id, const std::string& dir)
+{
+    git_tree* root = cached_tree(root_id);
+    if (dir.empty())
+        return root;
+
+    git_tree_entry* entry = nullptr;
+    int error = git_tree_entry_bypath(&entry, root, dir.c_str());
+    if (error == GIT_ENOTFOUND)
+        return nullptr;
+    if (error)
+    {
+        throw Error{ error, cat("Cannot find \"", dir, "\": ",
+            git_error_last()->message) };
+    }
+    auto free_entry = gul14::finally([entry]() { git_tree_entry_free(entry); });
+
+    if (git_tree_entry_type(entry) != GIT_OBJECT_TREE)
+        return nullptr;
+
+    // The root tree stays in the cache because it has just been moved to the front
+    return cached_tree(*git_tree_entry_id(entry));
+}
+
+git_commit* Repository::head_commit_or_null()
+{
+    if (head_cache_.valid && not (get_ref_stamps(head_cache_.ref_name) == head_cache_.stamps))
+        invalidate_head_cache();
+
+    if (not head_cache_.valid)
+    {
+        git_reference* ref = nullptr;
+        int error = git_repository_head(&ref, repo_.get());
+        if (error == GIT_EUNBORNBRANCH || error == GIT_ENOTFOUND)
+            return nullptr;
+        if (error)
+            throw Error{ error, cat("Cannot resolve HEAD: ", git_error_last()->message) };
+        LibGitReference head{ ref };
+
+        const git_oid* target = git_reference_target(head.get());
+        if (target == nullptr)
+            throw Error{ "Cannot resolve HEAD: No direct reference" };
+
+        head_cache_.ref_name = reference_name(head.get());
+        head_cache_.id = *target;
+        head_cache_.stamps = get_ref_stamps(head_cache_.ref_name);
+        head_cache_.valid = true;
+    }
+
+    if (not head_cache_.commit)
+    {
+        git_commit* commit;
+        int error = git_commit_lookup(&commit, repo_.get(), &head_cache_.id);
+        if (error)
+            throw Error{ error, cat("Cannot find HEAD commit: ", git_error_last()->message) };
+        head_cache_.commit.reset(commit);
+    }
+
+    return head_cache_.commit.get();
+}
+
+git_commit* Repository::head_commit()
+{
+    git_commit* commit = head_commit_or_null();
+    if (commit == nullptr)
+        throw Error{ GIT_EUNBORNBRANCH, "Cannot find HEAD of branch: HEAD is unborn" };
+    return commit;
+}
+
+void Repository::update_head_cache(const git_oid& commit_id)
+{
+    if (not head_cache_.valid)
+        return;
+
+    head_cache_.id = commit_id;
+    head_cache_.commit.reset();
+    head_cache_.stamps = get_ref_stamps(head_cache_.ref_name);
+}
+
+void Repository::invalidate_head_cache() noexcept
+{
+    head_cache_.valid = false;
+    head_cache_.commit.reset();
+}
+
+Repository::RefStamps Repository::get_ref_stamps(const std::string& ref_name) const
+{
+    // Refs are replaced by renaming a lock file, so a new inode reveals changes even
+    // within the granularity of the file system timestamps
+    auto stamp = [](const std::filesystem::path& path) {
+        FileStamp result;
+        struct stat st;
+        if (::stat(path.c_str(), &st) == 0)
+        {
+            result.inode = static_cast<std::uint64_t>(st.st_ino);
+            result.mtime_ns = static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1'000'000'000
+                + st.st_mtim.tv_nsec;
+        }
+        return result;
+    };
+
+    const std::filesystem::path git_dir = git_repository_path(repo_.get());
+    const char* common_dir_cstr = git_repository_commondir(repo_.get());
+    const std::filesystem::path common_dir = common_dir_cstr ? common_dir_cstr : git_dir;
+
+    RefStamps stamps;
+    stamps.head = stamp(git_dir / "HEAD");
+    stamps.ref = stamp(common_dir / ref_name);
+    stamps.packed_refs = stamp(common_dir / "packed-refs");
+    return stamps;
 }
 
 LibGitCommit Repository::get_commit(unsigned int count)
 {
+    ScopedTimer timer{ "Repository::get_commit" };
     git_commit* parent;
-    auto err = git_commit_nth_gen_ancestor(&parent, get_commit("HEAD").get(), count);
+    auto err = git_commit_nth_gen_ancestor(&parent, head_commit(), count);
     if (err)
         throw Error{ cat("Cannot find ", count, "th ancestor: ", git_error_last()->message) };
-    return { parent, git_commit_free };
+    return LibGitCommit{ parent };
 }
 
 LibGitCommit Repository::get_commit(const std::string& ref)
 {
+    ScopedTimer timer{ "Repository::get_commit" };
     git_commit* commit;
     git_oid oid_parent_commit;
 
@@ -239,199 +1268,590 @@ LibGitCommit Repository::get_commit(const std::string& ref)
     if (error)
         throw Error{ "Cannot find HEAD of branch" };
 
-    return { commit, git_commit_free };
+    return LibGitCommit{ commit };
 }
 
-bool Repository::is_unstaged(FileStatus& filestats, const git_status_entry* s)
+RepoState Repository::status(const StatusOptions& options)
 {
-    std::string wstatus = "";
+    ScopedTimer timer{ "Repository::status" };
+    return to_repo_state(status_list(options));
+}
 
-    if (s->status & GIT_STATUS_WT_MODIFIED)
-        wstatus = "modified";
-    if (s->status & GIT_STATUS_WT_DELETED)
-        wstatus = "deleted";
-    if (s->status & GIT_STATUS_WT_RENAMED)
-        wstatus = "renamed";
-    if (s->status & GIT_STATUS_WT_TYPECHANGE)
-        wstatus = "typechange";
+StatusList Repository::status_list(const StatusOptions& options)
+{
+    ScopedTimer timer{ "Repository::status_list" };
+    std::vector<const char*> pathspecs;
+    const git_status_options status_opt = make_status_options(options, pathspecs);
 
-    if (wstatus.empty())
-        return false;
+    auto my_status = status_list_new(repo_.get(), status_opt);
+    if (not my_status)
+        throw Error{ "Cannot initialize status" };
 
-    filestats.handling = "unstaged";
-    filestats.changes = wstatus;
+    return StatusList{ my_status.get() };
+}
 
-    const char* old_path = s->index_to_workdir->old_file.path;
-    const char* new_path = s->index_to_workdir->new_file.path;
+std::size_t Repository::for_each_status(
+    const std::function<bool(const FileStatusView&)>& visitor, const StatusOptions& options)
+{
+    ScopedTimer timer{ "Repository::for_each_status" };
+    std::vector<const char*> pathspecs;
+    const git_status_options status_opt = make_status_options(options, pathspecs);
 
-    if (old_path && new_path && strcmp(old_path, new_path))
-        filestats.path_name = cat(old_path, " -> ", new_path);
-    else
-        filestats.path_name = old_path ? old_path : new_path;
+    auto my_status = status_list_new(repo_.get(), status_opt);
+    if (not my_status)
+        throw Error{ "Cannot initialize status" };
 
-    return true;
-}
+    const std::size_t nr_entries = git_status_list_entrycount(my_status.get());
+    std::size_t nr_visited = 0;
+    FileStatusView view;
 
-bool Repository::is_staged(FileStatus& filestats, const git_status_entry* s)
-{
-    std::string istatus = "";
+    for (std::size_t i = 0; i < nr_entries; ++i)
+    {
+        if (not make_status_view(git_status_byindex(my_status.get(), i), view))
+            continue;
 
-    if (s->status & GIT_STATUS_INDEX_NEW)
-        istatus = "new file";
-    if (s->status & GIT_STATUS_INDEX_MODIFIED)
-        istatus = "modified";
-    if (s->status & GIT_STATUS_INDEX_DELETED)
-        istatus = "deleted";
-    if (s->status & GIT_STATUS_INDEX_RENAMED)
-        istatus = "renamed";
-    if (s->status & GIT_STATUS_INDEX_TYPECHANGE)
-        istatus = "typechange";
+        ++nr_visited;
+        if (not visitor(view))
+            break;
+    }
+
+    return nr_visited;
+}
 
-    if (istatus.empty())
-        return false;
+bool Repository::is_dirty(const StatusOptions& options)
+{
+    ScopedTimer timer{ "Repository::is_dirty" };
+    git_diff_options diff_opt = GIT_DIFF_OPTIONS_INIT;
+
+    std::vector<const char*> pathspecs;
+    pathspecs.reserve(options.pathspecs.size());
+    for (const auto& pathspec : options.pathspecs)
+        pathspecs.push_back(pathspec.c_str());
+    diff_opt.pathspec.strings = const_cast<char**>(pathspecs.data());
+    diff_opt.pathspec.count = pathspecs.size();
+    if (options.disable_pathspec_match)
+        diff_opt.flags |= GIT_DIFF_DISABLE_PATHSPEC_MATCH;
+
+    // Abort each diff as soon as the first changed file is found
+    diff_opt.notify_cb = abort_on_first_delta;
+
+    git_index* index = get_index();
+
+    // HEAD -> index (an unborn HEAD is compared as an empty tree)
+    LibGitTree head_tree;
+    if (git_commit* head = head_commit_or_null())
+    {
+        head_tree = commit_tree(head);
+        if (not head_tree)
+            throw Error{ cat("Cannot find tree of HEAD: ", git_error_last()->message) };
+    }
 
-    filestats.handling = "staged";
-    filestats.changes = std::string{istatus};
+    git_diff* diff = nullptr;
+    int error = git_diff_tree_to_index(&diff, repo_.get(), head_tree.get(), index,
+        &diff_opt);
+    LibGitDiff staged{ diff };
+    if (error == GIT_EUSER)
+        return true;
+    if (error)
+        throw Error{ error, cat("Cannot diff HEAD to index: ", git_error_last()->message) };
 
-    const char* old_path = s->head_to_index->old_file.path;
-    const char* new_path = s->head_to_index->new_file.path;
+    // index -> work tree
+    if (options.include_untracked)
+        diff_opt.flags |= GIT_DIFF_INCLUDE_UNTRACKED;
 
-    if (old_path && new_path && strcmp(old_path, new_path))
-        filestats.path_name = cat(old_path, " -> ", new_path);
-    else
-        filestats.path_name = old_path ? old_path : new_path;
+    diff = nullptr;
+    error = git_diff_index_to_workdir(&diff, repo_.get(), index, &diff_opt);
+    LibGitDiff unstaged{ diff };
+    if (error == GIT_EUSER)
+        return true;
+    if (error)
+    {
+        throw Error{ error, cat("Cannot diff index to work tree: ",
+            git_error_last()->message) };
+    }
 
-    return true;
+    return false;
 }
 
-RepoState Repository::collect_status(LibGitStatusList& status) const
+std::vector<int> Repository::add_files(const std::vector<std::filesystem::path>& filepaths)
 {
-    // get number of submodules
-    const size_t nr_entries = git_status_list_entrycount(status.get());
+    ScopedTimer timer{ "Repository::add_files" };
+    git_index* gindex = get_index();
 
-    // declare status holding vector for each submodule
-    RepoState return_array{ };
-    FileStatus filestats{ };
+    size_t v_len = filepaths.size();
 
-    for (size_t i = 0; i < nr_entries; ++i)
+    std::vector<int> error_list;
+    for (size_t i = 0; i < v_len; i++)
     {
-        const git_status_entry* s = git_status_byindex(status.get(), i);
-        const char* old_path = nullptr;
-        const char* new_path = nullptr;
-
-        std::string istatus = "";
-        std::string wstatus = "";
+        int error = git_index_add_bypath(gindex, filepaths[i].c_str());
+        if (error)
+            error_list.push_back(i);
+    }
 
-        // list files which exists but are untouched since last commit
-        //############################################################
-        if (s->status == GIT_STATUS_CURRENT)
-        {
-            filestats.handling = "unchanged";
-            filestats.changes = "unchanged";
+    write_index();
 
-            old_path = s->head_to_index->old_file.path;
-            new_path = s->head_to_index->new_file.path;
+    return error_list;
+}
 
-            filestats.path_name = old_path ? old_path : new_path;
+std::vector<int> Repository::add_files(const std::vector<std::filesystem::path>& filepaths,
+    unsigned int nr_threads)
+{
+    if (nr_threads == 0)
+        nr_threads = std::max(1u, std::thread::hardware_concurrency());
+    if (filepaths.size() < nr_threads)
+        nr_threads = static_cast<unsigned int>(filepaths.size());
 
-            return_array.push_back(filestats);
+    const char* workdir = git_repository_workdir(repo_.get());
+    git_index* gindex = get_index();
 
-            continue;
-        }
+    // Adding conflicted files must resolve the conflict, which only add_bypath() does
+    if (nr_threads <= 1 || workdir == nullptr || git_index_has_conflicts(gindex))
+        return add_files(filepaths);
 
-        // list files which were touched but stil are unchanged
-        //#####################################################
+    // Started only here because the serial overload above is timed itself
+    ScopedTimer timer{ "Repository::add_files" };
 
-        if (is_unstaged(filestats, s))
+    // Without core.filemode, the executable bit is taken from existing entries only
+    bool trust_filemode = true;
+    {
+        git_config* cfg = nullptr;
+        if (git_repository_config_snapshot(&cfg, repo_.get()) == 0)
         {
-            return_array.push_back(filestats);
-            continue;
+            int value = 1;
+            if (git_config_get_bool(&value, cfg, "core.filemode") == 0)
+                trust_filemode = value != 0;
+            git_config_free(cfg);
         }
+    }
 
-        // list files which are staged for next commit
-        //############################################
+    // libgit2 reports the work tree with a trailing slash
+    std::filesystem::path workdir_path{ workdir };
+    if (not workdir_path.has_filename())
+        workdir_path = workdir_path.parent_path();
 
+    auto blobs = write_blobs_in_parallel(repo_path_, workdir_path, filepaths, nr_threads);
 
-        if (is_staged(filestats, s))
+    std::vector<int> error_list;
+    for (size_t i = 0; i != blobs.size(); ++i)
+    {
+        int error;
+
+        if (blobs[i].ok)
         {
-            return_array.push_back(filestats);
-            continue;
+            git_index_entry& entry = blobs[i].entry;
+
+            if (not trust_filemode && entry.mode != GIT_FILEMODE_LINK)
+            {
+                const git_index_entry* existing = git_index_get_bypath(gindex, entry.path, 0);
+                if (existing && existing->mode != GIT_FILEMODE_LINK)
+                    entry.mode = existing->mode;
+                else
+                    entry.mode = GIT_FILEMODE_BLOB;
+            }
+
+            error = git_index_add(gindex, &entry);
         }
-
-        // list untracked files
-        //######################
-        if (s->status == GIT_STATUS_WT_NEW)
+        else
         {
+            error = git_index_add_bypath(gindex, filepaths[i].c_str());
+        }
 
-            filestats.handling = "untracked";
-            filestats.changes = "untracked";
-            filestats.path_name = s->index_to_workdir->old_file.path;
+        if (error)
+            error_list.push_back(static_cast<int>(i));
+    }
 
-            return_array.push_back(filestats);
+    write_index();
 
-            continue;
-        }
+    return error_list;
+}
 
-        // list ignored files
-        //####################
-        if (s->status == GIT_STATUS_IGNORED) {
+git_index* Repository::get_index()
+{
+    if (not index_)
+    {
+        index_ = repository_index(repo_.get());
+        if (not index_)
+            throw Error{ cat("Cannot open index: ", git_error_last()->message) };
+    }
+    return index_.get();
+}
 
-            filestats.handling = "ignored";
-            filestats.changes = "ignored";
-            filestats.path_name = s->index_to_workdir->old_file.path;
+void Repository::write_index()
+{
+    if (index_transaction_depth_ > 0)
+    {
+        index_dirty_ = true;
+        return;
+    }
 
-            return_array.push_back(filestats);
+    if (git_index_write(get_index()))
+        throw Error{ cat("Cannot write index: ", git_error_last()->message) };
+}
 
-            continue;
-        }
+void Repository::end_index_transaction(bool rollback)
+{
+    if (rollback)
+        index_rollback_ = true;
+
+    if (--index_transaction_depth_ > 0)
+        return;
+
+    const bool dirty = index_dirty_;
+    rollback = index_rollback_;
+    index_dirty_ = false;
+    index_rollback_ = false;
+
+    if (rollback)
+    {
+        // Discard in-memory changes by forcing a re-read from disk
+        if (index_ && git_index_read(index_.get(), 1))
+            throw Error{ cat("Cannot re-read index: ", git_error_last()->message) };
+    }
+    else if (dirty)
+    {
+        write_index();
     }
-    return return_array;
 }
 
-RepoState Repository::status()
+Repository::IndexTransaction::IndexTransaction(Repository& repo)
+    : repo_{ repo }
+    , nr_uncaught_exceptions_{ std::uncaught_exceptions() }
 {
-    git_status_options status_opt = GIT_STATUS_OPTIONS_INIT;
-    status_opt.flags =  GIT_STATUS_OPT_INCLUDE_UNTRACKED |          // untracked files
-                        GIT_STATUS_OPT_RECURSE_UNTRACKED_DIRS |     // untracked directories
-                        GIT_STATUS_OPT_INCLUDE_UNMODIFIED |         // unmodified files
-                        GIT_STATUS_OPT_INCLUDE_IGNORED;             // ignored files
+    ++repo_.index_transaction_depth_;
+}
 
-    auto my_status = status_list_new(repo_.get(), status_opt);
-    if (not my_status)
-        throw Error{ "Cannot initialize status" };
+Repository::IndexTransaction::~IndexTransaction()
+{
+    if (not active_)
+        return;
+
+    try
+    {
+        if (std::uncaught_exceptions() > nr_uncaught_exceptions_)
+            rollback();
+        else
+            commit();
+    }
+    catch (...)
+    {
+        // Destructors must not throw
+    }
+}
+
+void Repository::IndexTransaction::commit()
+{
+    if (not active_)
+        return;
+
+    active_ = false;
+    repo_.end_index_transaction(false);
+}
+
+void Repository::IndexTransaction::rollback()
+{
+    if (not active_)
+        return;
+
+    active_ = false;
+    repo_.end_index_transaction(true);
+}
+
+Repository::ReferenceTransaction::ReferenceTransaction(Repository& repo)
+    : repo_{ repo }
+    , nr_uncaught_exceptions_{ std::uncaught_exceptions() }
+{
+    git_transaction* transaction = nullptr;
+    if (git_transaction_new(&transaction, repo_.repo_.get()))
+    {
+        throw Error{ cat("Cannot create reference transaction: ",
+            git_error_last()->message) };
+    }
+    transaction_.reset(transaction);
+}
+
+Repository::ReferenceTransaction::~ReferenceTransaction()
+{
+    if (not transaction_)
+        return;
+
+    try
+    {
+        if (std::uncaught_exceptions() > nr_uncaught_exceptions_)
+            rollback();
+        else
+            commit();
+    }
+    catch (...)
+    {
+        // Destructors must not throw
+    }
+}
+
+void Repository::ReferenceTransaction::throw_if_ended() const
+{
+    if (not transaction_)
+        throw Error{ "Reference transaction has already ended" };
+}
+
+void Repository::ReferenceTransaction::lock(const std::string& ref_name)
+{
+    throw_if_ended();
+
+    if (locked_refs_.count(ref_name))
+        return;
+
+    int error = git_transaction_lock_ref(transaction_.get(), ref_name.c_str());
+    if (error)
+    {
+        throw Error{ error, cat("Cannot lock reference \"", ref_name, "\": ",
+            git_error_last()->message) };
+    }
+    locked_refs_.insert(ref_name);
+}
+
+void Repository::ReferenceTransaction::create_branch(const std::string& branch_name,
+    const std::string& start_point, bool force)
+{
+    const auto ref_name = cat("refs/heads/", branch_name);
+
+    lock(ref_name);
+
+    if (not force)
+    {
+        git_oid existing;
+        if (git_reference_name_to_id(&existing, repo_.repo_.get(), ref_name.c_str()) == 0)
+            throw Error{ GIT_EEXISTS, cat("Branch \"", branch_name, "\" already exists") };
+    }
+
+    set_target(ref_name, start_point, cat("branch: Created from ", start_point));
+}
+
+void Repository::ReferenceTransaction::set_target(const std::string& ref_name,
+    const git_oid& id, const std::string& log_message)
+{
+    lock(ref_name);
+
+    int error = git_transaction_set_target(transaction_.get(), ref_name.c_str(), &id,
+        repo_.get_signature(), log_message.empty() ? nullptr : log_message.c_str());
+    if (error)
+    {
+        throw Error{ error, cat("Cannot update reference \"", ref_name, "\": ",
+            git_error_last()->message) };
+    }
+    ++nr_updates_;
+}
+
+void Repository::ReferenceTransaction::set_target(const std::string& ref_name,
+    const std::string& revision, const std::string& log_message)
+{
+    throw_if_ended();
+
+    git_object* obj = nullptr;
+    git_object* commit = nullptr;
+    auto free_objects = gul14::finally([&]() {
+        git_object_free(commit);
+        git_object_free(obj);
+    });
+
+    if (git_revparse_single(&obj, repo_.repo_.get(), revision.c_str())
+        || git_object_peel(&commit, obj, GIT_OBJECT_COMMIT))
+    {
+        throw Error{ cat("Cannot resolve revision \"", revision, "\": ",
+            git_error_last()->message) };
+    }
+
+    set_target(ref_name, *git_object_id(commit), log_message);
+}
+
+void Repository::ReferenceTransaction::set_symbolic_target(const std::string& ref_name,
+    const std::string& target, const std::string& log_message)
+{
+    lock(ref_name);
+
+    int error = git_transaction_set_symbolic_target(transaction_.get(), ref_name.c_str(),
+        target.c_str(), repo_.get_signature(),
+        log_message.empty() ? nullptr : log_message.c_str());
+    if (error)
+    {
+        throw Error{ error, cat("Cannot update reference \"", ref_name, "\": ",
+            git_error_last()->message) };
+    }
+    ++nr_updates_;
+}
+
+void Repository::ReferenceTransaction::remove(const std::string& ref_name)
+{
+    lock(ref_name);
+
+    int error = git_transaction_remove(transaction_.get(), ref_name.c_str());
+    if (error)
+    {
+        throw Error{ error, cat("Cannot remove reference \"", ref_name, "\": ",
+            git_error_last()->message) };
+    }
+    ++nr_updates_;
+}
+
+void Repository::ReferenceTransaction::commit(bool pack_refs)
+{
+    ScopedTimer timer{ "Repository::ReferenceTransaction::commit" };
+    if (not transaction_)
+        return;
+
+    // Freeing the transaction releases the locks, also if the commit fails
+    auto transaction = std::move(transaction_);
+    int error = git_transaction_commit(transaction.get());
+    repo_.invalidate_head_cache();
+    if (error)
+    {
+        throw Error{ error, cat("Cannot commit reference transaction: ",
+            git_error_last()->message) };
+    }
+    transaction.reset();
+
+    if (pack_refs)
+        repo_.pack_refs();
+}
+
+void Repository::ReferenceTransaction::rollback() noexcept
+{
+    transaction_.reset();
+}
+
+void Repository::pack_refs()
+{
+    ScopedTimer timer{ "Repository::pack_refs" };
+    git_refdb* refdb = nullptr;
+    int error = git_repository_refdb(&refdb, repo_.get());
+    if (error)
+    {
+        throw Error{ error, cat("Cannot open reference database: ",
+            git_error_last()->message) };
+    }
+    auto free_refdb = gul14::finally([refdb]() { git_refdb_free(refdb); });
+
+    error = git_refdb_compress(refdb);
+    invalidate_head_cache();
+    if (error)
+        throw Error{ error, cat("Cannot pack references: ", git_error_last()->message) };
+}
+
+RepackResult Repository::repack(const RepackOptions& options)
+{
+    ScopedTimer timer{ "Repository::repack" };
+    RepackResult result;
+
+    // Linked worktrees share the object database of the main repository
+    const char* common_dir = git_repository_commondir(repo_.get());
+    const auto objects_dir = std::filesystem::path{
+        common_dir ? common_dir : git_repository_path(repo_.get()) } / "objects";
+    const auto loose_objects = find_loose_objects(objects_dir);
+
+    if (not loose_objects.empty())
+    {
+        git_packbuilder* builder_ptr = nullptr;
+        int error = git_packbuilder_new(&builder_ptr, repo_.get());
+        if (error)
+        {
+            throw Error{ error, cat("Cannot create pack builder: ",
+                git_error_last()->message) };
+        }
+        LibGitPackBuilder builder{ builder_ptr };
+
+        git_packbuilder_set_threads(builder.get(), options.threads);
+
+        // The callbacks take a non-const payload but do not modify it
+        void* progress_payload = const_cast<RepackProgressCallback*>(&options.on_progress);
+        if (options.on_progress)
+        {
+            git_packbuilder_set_callbacks(builder.get(), forward_packbuilder_progress,
+                progress_payload);
+        }
+
+        for (const auto& object : loose_objects)
+        {
+            error = git_packbuilder_insert(builder.get(), &object.id, nullptr);
+            if (error)
+                break;
+        }
+
+        if (not error)
+        {
+            error = git_packbuilder_write(builder.get(), nullptr, 0,
+                options.on_progress ? forward_indexer_progress : nullptr,
+                progress_payload);
+        }
+
+        if (error == GIT_EUSER)
+            throw Error{ error, "Repacking cancelled" };
+        if (error)
+            throw Error{ error, cat("Cannot write pack: ", git_error_last()->message) };
+
+        result.objects_packed = git_packbuilder_written(builder.get());
+#if LIBGIT2_FULLVERSION >= 1005000
+        result.pack_name = cat("pack-", git_packbuilder_name(builder.get()), ".pack");
+#else
+        result.pack_name = cat("pack-",
+            git_oid_tostr_s(git_packbuilder_hash(builder.get())), ".pack");
+#endif
+    }
+
+    git_odb* odb_ptr = nullptr;
+    int error = git_repository_odb(&odb_ptr, repo_.get());
+    if (error)
+    {
+        throw Error{ error, cat("Cannot open object database: ",
+            git_error_last()->message) };
+    }
+    LibGitOdb odb{ odb_ptr };
 
-    return collect_status(my_status);
-}
+    // Make the new pack known before the loose copies disappear
+    git_odb_refresh(odb.get());
 
-std::vector<int> Repository::add_files(const std::vector<std::filesystem::path>& filepaths)
-{
-    auto gindex = repository_index(repo_.get());
+    if (options.prune_loose)
+    {
+        std::error_code ec;
+        for (const auto& object : loose_objects)
+        {
+            if (std::filesystem::remove(object.file, ec))
+                ++result.loose_objects_removed;
+        }
 
-    size_t v_len = filepaths.size();
+        // Remove fan-out directories that have become empty (fails on non-empty ones)
+        for (const auto& object : loose_objects)
+            std::filesystem::remove(object.file.parent_path(), ec);
+    }
 
-    std::vector<int> error_list;
-    for (size_t i = 0; i < v_len; i++)
+    if (options.write_multi_pack_index)
     {
-        int error = git_index_add_bypath(gindex.get(), filepaths[i].c_str());
+#if LIBGIT2_FULLVERSION >= 1001000
+        error = git_odb_write_multi_pack_index(odb.get());
         if (error)
-            error_list.push_back(i);
+        {
+            throw Error{ error, cat("Cannot write multi-pack-index: ",
+                git_error_last()->message) };
+        }
+#else
+        throw Error{ "Writing a multi-pack-index requires libgit2 1.1 or newer" };
+#endif
     }
 
-    git_index_write(gindex.get());
-
-    return error_list;
+    return result;
 }
 
 void Repository::reset(unsigned int nr_of_commits)
 {
+    ScopedTimer timer{ "Repository::reset" };
     auto parent_commit = get_commit(nr_of_commits);
     auto error = git_reset(repo_.get(), reinterpret_cast<git_object*>(parent_commit.get()), GIT_RESET_HARD, nullptr);
+    invalidate_head_cache();
     if (error)
         throw Error{ cat("Reset: ", git_error_last()->message) };
 }
 
 Remote Repository::add_remote(const std::string& remote_name, const std::string& url)
 {
+    ScopedTimer timer{ "Repository::add_remote" };
     auto remote = remote_create(repo_.get(), remote_name, url);
     if (!remote)
     {
@@ -443,6 +1863,7 @@ Remote Repository::add_remote(const std::string& remote_name, const std::string&
 
 gul14::optional<Remote> Repository::get_remote(const std::string& remote_name) const
 {
+    ScopedTimer timer{ "Repository::get_remote" };
     auto remote = remote_lookup(repo_.get(), remote_name);
     if (!remote)
         return {};
@@ -450,8 +1871,33 @@ gul14::optional<Remote> Repository::get_remote(const std::string& remote_name) c
     return Remote{ std::move(remote) };
 }
 
+Result<Remote> Repository::try_get_remote(const std::string& remote_name) const
+{
+    ScopedTimer timer{ "Repository::try_get_remote" };
+    git_remote* remote = nullptr;
+    int error = git_remote_lookup(&remote, repo_.get(), remote_name.c_str());
+    if (error)
+        return to_error_code(error);
+
+    return Remote{ LibGitRemote{ remote } };
+}
+
+Result<git_oid> Repository::try_resolve(const std::string& revision) const
+{
+    ScopedTimer timer{ "Repository::try_resolve" };
+    git_object* obj = nullptr;
+    int error = git_revparse_single(&obj, repo_.get(), revision.c_str());
+    if (error)
+        return to_error_code(error);
+
+    const git_oid id = *git_object_id(obj);
+    git_object_free(obj);
+    return id;
+}
+
 std::vector<Remote> Repository::list_remotes() const
 {
+    ScopedTimer timer{ "Repository::list_remotes" };
     auto remote_names = list_remote_names();
 
     std::vector<Remote> result;
@@ -473,6 +1919,7 @@ std::vector<Remote> Repository::list_remotes() const
 
 std::vector<std::string> Repository::list_remote_names() const
 {
+    ScopedTimer timer{ "Repository::list_remote_names" };
     git_strarray remotes;
     int err = git_remote_list(&remotes, repo_.get());
     if (err)
@@ -492,30 +1939,233 @@ std::vector<std::string> Repository::list_remote_names() const
 
 void Repository::push(const Remote& remote, const std::string& refspec)
 {
-    git_remote_callbacks callbacks;
-    int error = git_remote_init_callbacks(&callbacks, GIT_REMOTE_CALLBACKS_VERSION);
-    if (error)
-    {
-        throw Error{ cat("Cannot initialize remote callbacks for push: ",
-            git_error_last()->message) };
-    }
-    callbacks.credentials = get_dummy_credentials_callback();
+    push_to(remote, { refspec });
+}
+
+void Repository::push_to(const Remote& remote, const std::vector<std::string>& refspecs,
+    const CancellationToken* token)
+{
+    ScopedTimer timer{ "Repository::push" };
+    RemoteCallbackState state;
+    state.token = token;
+    const git_remote_callbacks callbacks = make_remote_callbacks(state);
+    auto count_bytes = gul14::finally([&state]() {
+        count_metric("Repository::push.sent_bytes", state.sent_bytes);
+    });
 
     git_push_options push_options;
-    error = git_push_init_options(&push_options, GIT_PUSH_OPTIONS_VERSION);
+    int error = git_push_init_options(&push_options, GIT_PUSH_OPTIONS_VERSION);
     if (error)
         throw Error{ cat("Init push: ", git_error_last()->message) };
     push_options.callbacks = callbacks;
 
-    char* refspec_ptr = const_cast<char*>(refspec.c_str());
+    std::vector<char*> refspec_ptrs;
+    refspec_ptrs.reserve(refspecs.size());
+    for (const auto& refspec : refspecs)
+        refspec_ptrs.push_back(const_cast<char*>(refspec.c_str()));
     const git_strarray refspec_array = {
-        &refspec_ptr,
-        1
+        refspec_ptrs.data(),
+        refspec_ptrs.size()
     };
 
-    error = git_remote_push(remote.get(), &refspec_array, &push_options);
+    // Reuse an open connection of the remote if possible (see Remote::connect())
+    const bool temporary = remote.acquire_connection(RemoteDirection::push, callbacks,
+        false, true);
+    auto release = gul14::finally([&remote, temporary]() {
+        remote.release_connection(temporary, true);
+    });
+
+    throw_if_cancelled(token, "Push");
+
+    error = git_remote_upload(remote.get(), &refspec_array, &push_options);
     if (error)
+    {
+        if (state.cancelled)
+        {
+            throw Error{ GIT_EUSER, cat("Push to remote \"", remote.get_name(),
+                "\" cancelled") };
+        }
         throw Error{ cat("Push remote: ", git_error_last()->message) };
+    }
+
+    error = git_remote_update_tips(remote.get(), &callbacks, 0,
+        GIT_REMOTE_DOWNLOAD_TAGS_UNSPECIFIED, nullptr);
+    if (error)
+        throw Error{ cat("Push remote: Cannot update tips: ", git_error_last()->message) };
+}
+
+FetchResult Repository::fetch(const Remote& remote, const std::vector<std::string>& refspecs,
+    const FetchOptions& options)
+{
+    auto result = fetch_from(remote, refspecs, options);
+
+    // A refspec may have updated the current branch
+    invalidate_head_cache();
+
+    return result;
+}
+
+FetchResult Repository::fetch_from(const Remote& remote,
+    const std::vector<std::string>& refspecs, const FetchOptions& options,
+    const CancellationToken* token)
+{
+    ScopedTimer timer{ "Repository::fetch" };
+    FetchResult result;
+
+    RemoteCallbackState state;
+    state.on_progress = &options.on_progress;
+    state.updates = &result.updated_refs;
+    state.token = token;
+    auto count_bytes = gul14::finally([&state]() {
+        count_metric("Repository::fetch.received_bytes", state.received_bytes);
+    });
+
+    git_fetch_options fetch_options;
+    int error = git_fetch_init_options(&fetch_options, GIT_FETCH_OPTIONS_VERSION);
+    if (error)
+        throw Error{ cat("Init fetch: ", git_error_last()->message) };
+
+    fetch_options.callbacks = make_remote_callbacks(state);
+    fetch_options.prune = options.prune ? GIT_FETCH_PRUNE : GIT_FETCH_NO_PRUNE;
+    fetch_options.update_fetchhead = options.update_fetchhead ? 1 : 0;
+
+    switch (options.tags)
+    {
+    case FetchTags::automatic:
+        fetch_options.download_tags = GIT_REMOTE_DOWNLOAD_TAGS_AUTO;
+        break;
+    case FetchTags::none:
+        fetch_options.download_tags = GIT_REMOTE_DOWNLOAD_TAGS_NONE;
+        break;
+    case FetchTags::all:
+        fetch_options.download_tags = GIT_REMOTE_DOWNLOAD_TAGS_ALL;
+        break;
+    }
+
+    if (options.depth > 0)
+    {
+#if LIBGIT2_FULLVERSION >= 1007000
+        fetch_options.depth = options.depth;
+#else
+        throw Error{ "Shallow fetches require libgit2 1.7 or newer" };
+#endif
+    }
+
+    // Reuse an open connection of the remote if possible (see Remote::connect())
+    const bool temporary = remote.acquire_connection(RemoteDirection::fetch,
+        fetch_options.callbacks, false, true);
+    auto release = gul14::finally([&remote, temporary]() {
+        remote.release_connection(temporary, true);
+    });
+
+    const git_remote_head** heads{ nullptr };
+    size_t nr_heads{ 0 };
+    error = git_remote_ls(&heads, &nr_heads, remote.get());
+    if (error)
+    {
+        throw Error{ error, cat("Cannot list references on remote \"", remote.get_name(),
+            "\": ", git_error_last()->message) };
+    }
+    result.remote_references = RemoteReferenceList{ heads, nr_heads };
+
+    throw_if_cancelled(token, "Fetch");
+
+    std::vector<std::string> specs = refspecs;
+    if (options.only_changed_since)
+    {
+        specs = changed_refspecs(remote.get(), refspecs, *options.only_changed_since,
+            result.remote_references);
+        result.up_to_date = specs.empty();
+    }
+
+    if (not result.up_to_date)
+    {
+        std::vector<char*> spec_ptrs;
+        spec_ptrs.reserve(specs.size());
+        for (auto& spec : specs)
+            spec_ptrs.push_back(const_cast<char*>(spec.c_str()));
+        const git_strarray spec_array = { spec_ptrs.data(), spec_ptrs.size() };
+
+        error = git_remote_download(remote.get(), specs.empty() ? nullptr : &spec_array,
+            &fetch_options);
+        if (error)
+        {
+            if (state.cancelled)
+            {
+                throw Error{ GIT_EUSER, cat("Fetch from remote \"", remote.get_name(),
+                    "\" cancelled") };
+            }
+            throw Error{ error, cat("Fetch from remote \"", remote.get_name(), "\": ",
+                git_error_last()->message) };
+        }
+
+        error = git_remote_update_tips(remote.get(), &fetch_options.callbacks,
+            fetch_options.update_fetchhead, fetch_options.download_tags, nullptr);
+        if (error)
+        {
+            throw Error{ error, cat("Fetch: Cannot update references: ",
+                git_error_last()->message) };
+        }
+
+        result.stats = get_transfer_stats(remote.get());
+    }
+
+    if (options.prune)
+    {
+        error = git_remote_prune(remote.get(), &fetch_options.callbacks);
+        if (error)
+            throw Error{ error, cat("Fetch: Cannot prune: ", git_error_last()->message) };
+    }
+
+    return result;
+}
+
+std::future<void> Repository::push_async(const std::string& remote_name,
+    const std::vector<std::string>& refspecs, CancellationToken token)
+{
+    return std::async(std::launch::async,
+        [library = library_, path = repo_path_, remote_name, refspecs, token]() {
+            auto remote = open_remote_for_worker(path, remote_name);
+            push_to(remote.second, refspecs, &token);
+        });
+}
+
+std::future<FetchResult> Repository::fetch_async(const std::string& remote_name,
+    const std::vector<std::string>& refspecs, const FetchOptions& options,
+    CancellationToken token)
+{
+    return std::async(std::launch::async,
+        [library = library_, path = repo_path_, remote_name, refspecs, options, token]() {
+            auto remote = open_remote_for_worker(path, remote_name);
+            return fetch_from(remote.second, refspecs, options, &token);
+        });
+}
+
+std::vector<RemoteResult> Repository::push_to_remotes(
+    const std::vector<std::string>& remote_names, const std::vector<std::string>& refspecs,
+    unsigned int nr_threads)
+{
+    return run_on_remotes(repo_path_, remote_names, nr_threads,
+        [&refspecs](const Remote& remote, RemoteResult&) {
+            push_to(remote, refspecs);
+        });
+}
+
+std::vector<RemoteResult> Repository::fetch_from_remotes(
+    const std::vector<std::string>& remote_names, const std::vector<std::string>& refspecs,
+    const FetchOptions& options, unsigned int nr_threads)
+{
+    // Concurrent fetches would race for the lock on FETCH_HEAD
+    FetchOptions opt = options;
+    opt.update_fetchhead = false;
+
+    auto results = run_on_remotes(repo_path_, remote_names, nr_threads,
+        [&refspecs, &opt](const Remote& remote, RemoteResult& result) {
+            result.fetch = fetch_from(remote, refspecs, opt);
+        });
+
+    invalidate_head_cache();
+    return results;
 }
 
 #if 0
@@ -545,53 +2195,6 @@ void Repository::pull()
 
 }
 
-void Repository::clone_repo(const std::string& url, const std::filesystem::path& repo_path)
-{
-    auto repo = clone(url, repo_path);
-    if (not repo) {
-        throw Error{ "Cannot clone repository" };
-    }
-    else
-    {
-        url_ = url;
-        remote_ = remote_lookup(repo.get(), "origin"); // TODO: origin korrekt?
-        repo_path_ = repo_path;
-        repo_ = std::move(repo);
-
-    }
-}
-
-bool Repository::branch_up_to_date(const std::string& branch_name)
-{
-    auto local_ref = branch_lookup(repo_.get(), "master", GIT_BRANCH_LOCAL);
-    if (not local_ref)
-        throw Error{ cat("Branch lookup: ", git_error_last()->message) };
-
-    // Get the name of the remote associated with the local branch
-    //TODO: wrapper for buffer?
-    auto remote_name = branch_remote_name(repo_.get(), branch_name.c_str());
-    if (remote_name == "")
-        throw Error{ "Failed to get remote name for the local branch" };
-
-    // Open the remote
-    auto remote = remote_lookup(repo_.get(), remote_name);
-    if (not remote)
-        throw Error{ "Cannot find remote object" };
-
-    // Get the upstream branch
-    git_reference* upstream_ref = nullptr;
-    if (git_branch_upstream(&upstream_ref, local_ref.get()) != 0) {
-        std::cerr << "Failed to get upstream branch." << std::endl;
-        return 1;
-    }
-
-    // Get the OIDs of the local and remote branches
-    const git_oid* local_oid = git_reference_target(local_ref.get());
-    const git_oid* remote_oid = git_reference_target(upstream_ref);
-
-    // Compare OIDs to check if the branches are up to date
-    return git_oid_equal(local_oid, remote_oid);
-}
 #endif
 
 
@@ -603,6 +2206,7 @@ LibGitReference Repository::new_branch(const std::string& branch_name)
 LibGitReference Repository::new_branch(const std::string& branch_name,
     const std::string& origin_branch_name)
 {
+    ScopedTimer timer{ "Repository::new_branch" };
     // checkout origin branch
     auto ref = branch_lookup(repo_.get(), origin_branch_name, GIT_BRANCH_LOCAL);
 
@@ -615,6 +2219,7 @@ LibGitReference Repository::new_branch(const std::string& branch_name,
 
 std::string Repository::get_current_branch_name()
 {
+    ScopedTimer timer{ "Repository::get_current_branch_name" };
     // get current HEAD
     auto head = repository_head(repo_.get());
 
@@ -624,6 +2229,7 @@ std::string Repository::get_current_branch_name()
 
 std::vector<std::string> Repository::list_branches(BranchType type_flag)
 {
+    ScopedTimer timer{ "Repository::list_branches" };
     // transform libgit4cpp enum into libgit2 object
     git_branch_t flag;
     if (type_flag == BranchType::all)
@@ -648,48 +2254,411 @@ std::vector<std::string> Repository::list_branches(BranchType type_flag)
     return ret;
 }
 
-void Repository::checkout(const std::string& branch_name,
-    const std::vector<std::string>& paths)
+BlobContent Repository::read_blob(const std::string& revision, const std::string& path,
+    const BlobReadOptions& options)
 {
+    ScopedTimer timer{ "Repository::read_blob" };
+    auto tree = revision_tree(repo_.get(), revision);
+    auto blob = tree_blob(repo_.get(), tree.get(), path);
 
-    git_checkout_options checkout_opts = GIT_CHECKOUT_OPTIONS_INIT;
-    // define the paths of files to checkout
-    checkout_opts.paths.count = paths.size();
+    // Binary blobs are never filtered, so their content need not be copied
+    if (not options.apply_filters || git_blob_is_binary(blob.get()))
+        return BlobContent{ std::move(blob) };
+
+    git_buf buf{ };
+    auto dispose = gul14::finally([&buf]() { git_buf_dispose(&buf); });
+    int error = filter_blob(buf, blob.get(), path);
+    if (error)
+    {
+        throw Error{ error, cat("Cannot filter \"", path, "\": ",
+            git_error_last()->message) };
+    }
+
+    return BlobContent{ std::move(blob), &buf };
+}
+
+Result<BlobContent> Repository::try_read_blob(const std::string& revision,
+    const std::string& path, const BlobReadOptions& options)
+{
+    ScopedTimer timer{ "Repository::try_read_blob" };
+
+    git_object* obj = nullptr;
+    git_object* tree = nullptr;
+    auto free_objects = gul14::finally([&obj, &tree]()
+        {
+            git_object_free(tree);
+            git_object_free(obj);
+        });
+
+    int error = git_revparse_single(&obj, repo_.get(), revision.c_str());
+    if (not error)
+        error = git_object_peel(&tree, obj, GIT_OBJECT_TREE);
+    if (error)
+        return to_error_code(error);
+
+    git_tree_entry* entry = nullptr;
+    error = git_tree_entry_bypath(&entry, reinterpret_cast<git_tree*>(tree), path.c_str());
+    if (error)
+        return to_error_code(error);
+    auto free_entry = gul14::finally([entry]() { git_tree_entry_free(entry); });
+
+    if (git_tree_entry_type(entry) != GIT_OBJECT_BLOB)
+        return GIT_ENOTFOUND;
+
+    git_blob* blob_ptr = nullptr;
+    error = git_blob_lookup(&blob_ptr, repo_.get(), git_tree_entry_id(entry));
+    if (error)
+        return to_error_code(error);
+    LibGitBlob blob{ blob_ptr };
+
+    if (not options.apply_filters || git_blob_is_binary(blob.get()))
+        return BlobContent{ std::move(blob) };
+
+    git_buf buf{ };
+    auto dispose = gul14::finally([&buf]() { git_buf_dispose(&buf); });
+    error = filter_blob(buf, blob.get(), path);
+    if (error)
+        return to_error_code(error);
+
+    return BlobContent{ std::move(blob), &buf };
+}
+
+std::size_t Repository::stream_blob(const std::string& revision, const std::string& path,
+    const std::function<bool(gul14::string_view chunk)>& consumer,
+    const BlobReadOptions& options)
+{
+    const auto blob = read_blob(revision, path, options);
+    const auto data = blob.data();
+    const std::size_t chunk_size = std::max<std::size_t>(1, options.chunk_size);
+
+    std::size_t pos = 0;
+    while (pos < data.size())
+    {
+        const auto chunk = data.substr(pos, chunk_size);
+        pos += chunk.size();
+        if (not consumer(chunk))
+            break;
+    }
+
+    return pos;
+}
+
+std::vector<TreeEntry> Repository::list_tree(const std::string& revision,
+    const std::string& dir, bool recursive)
+{
+    ScopedTimer timer{ "Repository::list_tree" };
+    const auto path = strip_trailing_slashes(dir);
+    const git_tree* tree = cached_directory(revision_tree_id(repo_.get(), revision), path);
+    if (tree == nullptr)
+    {
+        throw Error{ GIT_ENOTFOUND,
+            cat("No directory \"", path, "\" in revision \"", revision, "\"") };
+    }
+
+    std::vector<TreeEntry> entries;
+    collect_tree_entries(repo_.get(), tree, path.empty() ? path : path + "/", recursive,
+        entries);
+    return entries;
+}
+
+gul14::optional<TreeEntry> Repository::lookup_path(const std::string& revision,
+    const std::string& path)
+{
+    ScopedTimer timer{ "Repository::lookup_path" };
+    const auto clean_path = strip_trailing_slashes(path);
+    const auto root_id = revision_tree_id(repo_.get(), revision);
+
+    // Look up the parent directory via the cache, so that lookups of several entries
+    // in the same directory do not parse the same trees again
+    const auto pos = clean_path.rfind('/');
+    const git_tree* parent = cached_directory(root_id,
+        pos == std::string::npos ? std::string{ } : clean_path.substr(0, pos));
+    if (parent == nullptr)
+        return gul14::nullopt;
+
+    const auto name = pos == std::string::npos ? clean_path : clean_path.substr(pos + 1);
+    const git_tree_entry* entry = git_tree_entry_byname(parent, name.c_str());
+    if (entry == nullptr)
+        return gul14::nullopt;
+
+    return make_tree_entry(entry, clean_path);
+}
+
+DiffResult Repository::diff(const std::string& from, const std::string& to,
+    const DiffOptions& options)
+{
+    ScopedTimer timer{ "Repository::diff" };
+    auto old_tree = revision_tree(repo_.get(), from);
+    auto new_tree = revision_tree(repo_.get(), to);
+
+    std::vector<const char*> pathspecs;
+    git_diff_options diff_opt = make_diff_options(options, pathspecs);
+
+    git_diff* diff_ptr = nullptr;
+    int error = git_diff_tree_to_tree(&diff_ptr, repo_.get(), old_tree.get(),
+        new_tree.get(), &diff_opt);
+    LibGitDiff diff{ diff_ptr };
+    if (error)
+    {
+        throw Error{ error, cat("Cannot diff ", from, " to ", to, ": ",
+            git_error_last()->message) };
+    }
+
+    return make_diff_result(diff.get(), options);
+}
+
+DiffResult Repository::diff_index(const DiffOptions& options)
+{
+    ScopedTimer timer{ "Repository::diff_index" };
+    LibGitTree head_tree;
+    if (git_commit* head = head_commit_or_null())
+    {
+        head_tree = commit_tree(head);
+        if (not head_tree)
+            throw Error{ cat("Cannot find tree of HEAD: ", git_error_last()->message) };
+    }
+
+    std::vector<const char*> pathspecs;
+    git_diff_options diff_opt = make_diff_options(options, pathspecs);
+
+    git_diff* diff_ptr = nullptr;
+    int error = git_diff_tree_to_index(&diff_ptr, repo_.get(), head_tree.get(),
+        get_index(), &diff_opt);
+    LibGitDiff diff{ diff_ptr };
+    if (error)
+        throw Error{ error, cat("Cannot diff HEAD to index: ", git_error_last()->message) };
+
+    return make_diff_result(diff.get(), options);
+}
+
+DiffResult Repository::diff_workdir(const DiffOptions& options)
+{
+    ScopedTimer timer{ "Repository::diff_workdir" };
+    std::vector<const char*> pathspecs;
+    git_diff_options diff_opt = make_diff_options(options, pathspecs);
+
+    git_diff* diff_ptr = nullptr;
+    int error = git_diff_index_to_workdir(&diff_ptr, repo_.get(), get_index(), &diff_opt);
+    LibGitDiff diff{ diff_ptr };
+    if (error)
+    {
+        throw Error{ error, cat("Cannot diff index to work tree: ",
+            git_error_last()->message) };
+    }
+
+    return make_diff_result(diff.get(), options);
+}
+
+AheadBehind Repository::ahead_behind(const std::string& local, const std::string& upstream)
+{
+    ScopedTimer timer{ "Repository::ahead_behind" };
+    const git_oid local_id = revision_commit_id(repo_.get(), local);
+
+    if (not upstream.empty())
+    {
+        const git_oid upstream_id = revision_commit_id(repo_.get(), upstream);
+        return count_ahead_behind(repo_.get(), local_id, upstream_id);
+    }
+
+    // Use the configured upstream of the local branch (resolving e.g. "HEAD" first)
+    auto ref = parse_reference_from_name(repo_.get(), local);
+    git_reference* resolved_ptr = nullptr;
+    if (git_reference_resolve(&resolved_ptr, ref.get()))
+    {
+        throw Error{ cat("Cannot resolve reference \"", local, "\": ",
+            git_error_last()->message) };
+    }
+    LibGitReference resolved{ resolved_ptr };
+
+    git_reference* upstream_ptr = nullptr;
+    int error = git_branch_upstream(&upstream_ptr, resolved.get());
+    if (error)
+    {
+        throw Error{ error, cat("Cannot find upstream of \"", local, "\": ",
+            git_error_last()->message) };
+    }
+    LibGitReference upstream_ref{ upstream_ptr };
+
+    const git_oid upstream_id = reference_commit_id(upstream_ref.get());
+    return count_ahead_behind(repo_.get(), local_id, upstream_id);
+}
+
+std::vector<BranchTracking> Repository::ahead_behind_all()
+{
+    ScopedTimer timer{ "Repository::ahead_behind_all" };
+    std::vector<BranchTracking> result;
+    std::map<std::pair<git_oid, git_oid>, AheadBehind, OidPairLess> counts_cache;
+
+    git_branch_t type = GIT_BRANCH_LOCAL;
+    LibGitBranchIterator iter = branch_iterator(repo_.get(), type);
+
+    LibGitReference ref = branch_next(&type, iter.get());
+    for (; ref != nullptr; ref = branch_next(&type, iter.get()))
+    {
+        BranchTracking tracking;
+        tracking.branch = reference_name(ref.get());
+        tracking.local_id = reference_commit_id(ref.get());
+        std::memset(&tracking.upstream_id, 0, sizeof(tracking.upstream_id));
+
+        git_reference* upstream_ptr = nullptr;
+        int error = git_branch_upstream(&upstream_ptr, ref.get());
+        if (error == GIT_ENOTFOUND)
+        {
+            result.push_back(std::move(tracking));
+            continue;
+        }
+        if (error)
+        {
+            throw Error{ error, cat("Cannot find upstream of \"", tracking.branch, "\": ",
+                git_error_last()->message) };
+        }
+        LibGitReference upstream{ upstream_ptr };
+
+        tracking.upstream = reference_name(upstream.get());
+        tracking.upstream_id = reference_commit_id(upstream.get());
+
+        const auto key = std::make_pair(tracking.local_id, tracking.upstream_id);
+        auto it = counts_cache.find(key);
+        if (it == counts_cache.end())
+        {
+            it = counts_cache.emplace(key, count_ahead_behind(repo_.get(),
+                tracking.local_id, tracking.upstream_id)).first;
+        }
+        tracking.counts = it->second;
 
-    // transform std::string input into readaable data for libgit2
-    std::vector<const char*> paths_as_cstr;
-    for(const auto& path: paths)
-        paths_as_cstr.push_back(path.c_str());
-    checkout_opts.paths.strings = const_cast<char **>(paths_as_cstr.data());
+        result.push_back(std::move(tracking));
+    }
+
+    return result;
+}
 
-    checkout_opts.checkout_strategy = GIT_CHECKOUT_FORCE;
+void Repository::checkout(const std::string& branch_name,
+    const std::vector<std::string>& paths)
+{
+    CheckoutOptions options;
+    options.mode = CheckoutMode::force;
+    options.paths = paths;
+    checkout(branch_name, options);
+}
 
+void Repository::checkout(const std::string& branch_name, const CheckoutOptions& options)
+{
+    ScopedTimer timer{ "Repository::checkout" };
     // find latest commit of said branch
     auto full_branch_name = reference_name(
         parse_reference_from_name(repo_.get(), branch_name).get());
     auto last_commit = get_commit(full_branch_name);
 
-    // checkout (the cast is necessary because libgit2 simulates inheritance by having a
-    // struct git_object as the first member of the opaque struct git_commit)
-    auto error = git_checkout_tree(repo_.get(),
-        reinterpret_cast<const git_object*>(last_commit.get()), &checkout_opts);
+    checkout_commit(last_commit.get(), options);
+}
+
+void Repository::checkout_commit(git_commit* target, const CheckoutOptions& options)
+{
+    auto target_tree = commit_tree(target);
+    if (not target_tree)
+        throw Error{ cat("Cannot find tree of commit: ", git_error_last()->message) };
+
+    // The HEAD tree is the baseline (an unborn HEAD is treated as an empty tree)
+    LibGitTree baseline;
+    if (git_commit* head = head_commit_or_null())
+    {
+        baseline = commit_tree(head);
+        if (not baseline)
+            throw Error{ cat("Cannot find tree of HEAD: ", git_error_last()->message) };
+    }
+
+    std::vector<const char*> pathspecs;
+    pathspecs.reserve(options.paths.size());
+    for (const auto& path : options.paths)
+        pathspecs.push_back(path.c_str());
+
+    git_checkout_options checkout_opts = GIT_CHECKOUT_OPTIONS_INIT;
+    checkout_opts.baseline = baseline.get();
+    checkout_opts.paths.strings = const_cast<char**>(pathspecs.data());
+    checkout_opts.paths.count = pathspecs.size();
+    if (options.disable_pathspec_match)
+        checkout_opts.checkout_strategy |= GIT_CHECKOUT_DISABLE_PATHSPEC_MATCH;
+
+    // Paths of the files that differ between baseline and target (safe mode only)
+    std::vector<std::string> plan;
+
+    if (options.mode == CheckoutMode::force)
+    {
+        checkout_opts.checkout_strategy |= GIT_CHECKOUT_FORCE;
+    }
+    else
+    {
+        checkout_opts.checkout_strategy |= GIT_CHECKOUT_SAFE;
+
+        // Plan: only the files that differ between the two trees need to be touched.
+        // Passing them as a literal path list lets libgit2 skip all other directories
+        // of the work tree.
+        git_diff_options diff_opt = GIT_DIFF_OPTIONS_INIT;
+        diff_opt.pathspec = checkout_opts.paths;
+        if (options.disable_pathspec_match)
+            diff_opt.flags |= GIT_DIFF_DISABLE_PATHSPEC_MATCH;
+
+        git_diff* diff_ptr = nullptr;
+        int error = git_diff_tree_to_tree(&diff_ptr, repo_.get(), baseline.get(),
+            target_tree.get(), &diff_opt);
+        LibGitDiff diff{ diff_ptr };
+        if (error)
+            throw Error{ error, cat("Checkout: ", git_error_last()->message) };
+
+        const std::size_t nr_deltas = git_diff_num_deltas(diff.get());
+        if (nr_deltas == 0)
+            return;
+
+        // Without rename detection, old and new path of each delta are the same (a
+        // rename shows up as a deletion and an addition)
+        plan.reserve(nr_deltas);
+        for (std::size_t i = 0; i != nr_deltas; ++i)
+            plan.emplace_back(git_diff_get_delta(diff.get(), i)->new_file.path);
+
+        pathspecs.clear();
+        for (const auto& path : plan)
+            pathspecs.push_back(path.c_str());
+        checkout_opts.paths.strings = const_cast<char**>(pathspecs.data());
+        checkout_opts.paths.count = pathspecs.size();
+        checkout_opts.checkout_strategy |= GIT_CHECKOUT_DISABLE_PATHSPEC_MATCH;
+    }
+
+    if (options.on_notify)
+    {
+        checkout_opts.notify_flags = GIT_CHECKOUT_NOTIFY_CONFLICT
+            | GIT_CHECKOUT_NOTIFY_DIRTY | GIT_CHECKOUT_NOTIFY_UPDATED
+            | GIT_CHECKOUT_NOTIFY_UNTRACKED | GIT_CHECKOUT_NOTIFY_IGNORED;
+        checkout_opts.notify_cb = forward_checkout_notification;
+        checkout_opts.notify_payload = const_cast<CheckoutNotifyCallback*>(&options.on_notify);
+    }
+
+    // The cast is necessary because libgit2 simulates inheritance by having a struct
+    // git_object as the first member of the opaque struct git_commit
+    int error = git_checkout_tree(repo_.get(), reinterpret_cast<const git_object*>(target),
+        &checkout_opts);
+    if (error == GIT_EUSER)
+        throw Error{ GIT_EUSER, "Checkout cancelled" };
     if (error)
-        throw Error{ cat("Checkout: ", git_error_last()->message) };
+        throw Error{ error, cat("Checkout: ", git_error_last()->message) };
 }
 
-void Repository::switch_branch(const std::string& branch_name)
+void Repository::switch_branch(const std::string& branch_name,
+    const CheckoutOptions& options)
 {
+    ScopedTimer timer{ "Repository::switch_branch" };
     // get full name from branch identifier
     auto branch_ref = parse_reference_from_name(repo_.get(), branch_name);
     auto branch_full_name = reference_name(branch_ref.get());
+    auto target = get_commit(branch_full_name);
+
+    // update index and work tree first, so that HEAD is only moved on success
+    checkout_commit(target.get(), options);
 
     // switch HEAD
     int error = git_repository_set_head(repo_.get(), branch_full_name.c_str());
+    invalidate_head_cache();
     if (error)
         throw Error{ cat("switch_branch: ", git_error_last()->message) };
-
-    // go back to original state on this branch
-    reset(0);
 }
 
 
@@ -0,0 +1,197 @@
+/**
+ * \file   RepositoryPool.cc
+ * \date   Created on October 14, 2026
+ * \brief  Implementation of the RepositoryPool class.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <algorithm>
+
+#include <gul14/cat.h>
+
+#include "libgit4cpp/Error.h"
+#include "libgit4cpp/RepositoryPool.h"
+#include "libgit4cpp/wrapper_functions.h"
+
+using gul14::cat;
+
+namespace git {
+
+namespace {
+
+LibGitSignature duplicate(const git_signature* signature)
+{
+    git_signature* copy = nullptr;
+    if (signature != nullptr && git_signature_dup(&copy, signature) != 0)
+        copy = nullptr;
+    return LibGitSignature{ copy };
+}
+
+} // anonymous namespace
+
+RepositoryPool::RepositoryPool(std::filesystem::path path, std::size_t max_idle)
+    : path_{ std::move(path) }
+    , max_idle_{ max_idle != 0 ? max_idle
+                               : std::max<std::size_t>(1, std::thread::hardware_concurrency()) }
+{ }
+
+RepositoryPool::~RepositoryPool()
+{
+    // Destroy all Repository objects before the signature (and libgit2 state) go away
+    per_thread_.clear();
+    idle_.clear();
+}
+
+std::unique_ptr<Repository> RepositoryPool::open()
+{
+    // Opening is the expensive part, so it happens without holding the lock
+    auto repo = repository_open(path_);
+    if (not repo)
+    {
+        throw Error{ cat("Cannot open repository ", path_.string(), ": ",
+            git_error_last()->message) };
+    }
+
+    LibGitSignature signature;
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        signature = duplicate(signature_.get());
+    }
+
+    const bool share_signature = not signature;
+
+    std::unique_ptr<Repository> result{
+        new Repository{ path_, std::move(repo), std::move(signature) } };
+
+    std::lock_guard<std::mutex> lock{ mutex_ };
+    if (share_signature && not signature_)
+        signature_ = duplicate(result->get_signature());
+    ++nr_opened_;
+
+    return result;
+}
+
+void RepositoryPool::release(std::unique_ptr<Repository> repo) noexcept
+{
+    std::unique_ptr<Repository> to_destroy;
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        if (idle_.size() < max_idle_)
+        {
+            try
+            {
+                idle_.push_back(std::move(repo));
+                return;
+            }
+            catch (...)
+            {
+                // Out of memory; destroy the object instead
+            }
+        }
+        to_destroy = std::move(repo);
+    }
+    // to_destroy is closed here, outside of the lock
+}
+
+RepositoryPool::Handle RepositoryPool::acquire()
+{
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        if (not idle_.empty())
+        {
+            auto repo = std::move(idle_.back());
+            idle_.pop_back();
+            return Handle{ this, std::move(repo) };
+        }
+    }
+
+    return Handle{ this, open() };
+}
+
+Repository& RepositoryPool::for_this_thread()
+{
+    const auto id = std::this_thread::get_id();
+
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        auto it = per_thread_.find(id);
+        if (it != per_thread_.end())
+            return *it->second;
+    }
+
+    auto repo = open();
+    Repository& ref = *repo;
+
+    std::lock_guard<std::mutex> lock{ mutex_ };
+    per_thread_.emplace(id, std::move(repo));
+    return ref;
+}
+
+void RepositoryPool::release_this_thread()
+{
+    std::unique_ptr<Repository> to_destroy;
+
+    std::lock_guard<std::mutex> lock{ mutex_ };
+    auto it = per_thread_.find(std::this_thread::get_id());
+    if (it == per_thread_.end())
+        return;
+    to_destroy = std::move(it->second);
+    per_thread_.erase(it);
+}
+
+std::size_t RepositoryPool::idle_count() const
+{
+    std::lock_guard<std::mutex> lock{ mutex_ };
+    return idle_.size();
+}
+
+std::size_t RepositoryPool::open_count() const
+{
+    std::lock_guard<std::mutex> lock{ mutex_ };
+    return nr_opened_;
+}
+
+void RepositoryPool::clear_idle()
+{
+    std::vector<std::unique_ptr<Repository>> to_destroy;
+    {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        to_destroy.swap(idle_);
+    }
+}
+
+RepositoryPool::Handle& RepositoryPool::Handle::operator=(Handle&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (repo_)
+            pool_->release(std::move(repo_));
+        pool_ = other.pool_;
+        repo_ = std::move(other.repo_);
+    }
+    return *this;
+}
+
+RepositoryPool::Handle::~Handle()
+{
+    if (repo_)
+        pool_->release(std::move(repo_));
+}
+
+} // namespace git
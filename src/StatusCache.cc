@@ -0,0 +1,410 @@
+/**
+ * \file   StatusCache.cc
+ * \date   Created on October 14, 2026
+ * \brief  Implementation of the StatusCache class.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <cerrno>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <git2.h>
+#include <gul14/cat.h>
+
+#include "libgit4cpp/Error.h"
+#include "libgit4cpp/StatusCache.h"
+#include "scoped_timer.h"
+
+using gul14::cat;
+
+namespace git {
+
+namespace {
+
+#ifdef __linux__
+// Events that can change the status of a file or directory in a watched directory
+constexpr std::uint32_t watch_mask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_ATTRIB
+    | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR | IN_EXCL_UNLINK;
+#endif
+
+// Join a directory relative to the work tree (empty for the top level) and a name.
+std::string join_path(const std::string& dir, const std::string& name)
+{
+    return dir.empty() ? name : cat(dir, '/', name);
+}
+
+// Determine if the index has entries below a directory (given with a trailing slash).
+bool has_index_entries_below(git_repository* repo, const std::string& dir)
+{
+    git_index* index_ptr = nullptr;
+    if (git_repository_index(&index_ptr, repo) != 0)
+        return true; // Unknown, so watching is the safe choice
+    LibGitIndex index{ index_ptr };
+
+    // Another process may have changed the index; it is only reread if it has changed
+    if (git_index_read(index.get(), 0) != 0)
+        return true;
+
+    std::size_t pos = 0;
+    return git_index_find_prefix(&pos, index.get(), dir.c_str()) == 0;
+}
+
+} // anonymous namespace
+
+bool StatusCache::GitState::operator==(const GitState& o) const noexcept
+{
+    return index_inode == o.index_inode && index_mtime_ns == o.index_mtime_ns
+        && index_size == o.index_size && git_oid_equal(&head_id, &o.head_id);
+}
+
+StatusCache::StatusCache(Repository& repo, const StatusOptions& options)
+    : repo_{ repo }, options_{ options }
+{
+    const char* workdir = git_repository_workdir(repo_.get_repo());
+    if (workdir == nullptr)
+        throw Error{ GIT_EBAREREPO, "Cannot track the status of a bare repository" };
+
+    workdir_ = workdir;
+    if (workdir_.empty() || workdir_.back() != '/')
+        workdir_ += '/';
+
+#ifdef __linux__
+    // These options require a full scan anyway, so watching the tree would be wasted
+    if (not options_.detect_renames && options_.pathspecs.empty())
+        rewatch();
+#endif
+}
+
+StatusCache::~StatusCache()
+{
+    stop_watching();
+}
+
+void StatusCache::stop_watching() noexcept
+{
+#ifdef __linux__
+    if (inotify_fd_ >= 0)
+        ::close(inotify_fd_);
+#endif
+    inotify_fd_ = -1;
+    watches_.clear();
+}
+
+void StatusCache::rewatch()
+{
+#ifdef __linux__
+    // A fresh inotify instance guarantees that no stale events of old watches remain
+    stop_watching();
+    unwatched_ignored_dirs_.clear();
+    inotify_fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd_ >= 0)
+        watch_tree("");
+#endif
+}
+
+void StatusCache::watch_tree(const std::string& dir)
+{
+#ifdef __linux__
+    if (inotify_fd_ < 0)
+        return;
+
+    const std::string abs_dir = cat(workdir_, dir);
+    const int wd = ::inotify_add_watch(inotify_fd_, abs_dir.c_str(), watch_mask);
+    if (wd < 0)
+    {
+        // The directory may already be gone again; its parent has reported the deletion
+        if (errno == ENOENT || errno == ENOTDIR)
+            return;
+
+        // Usually ENOSPC: The user's watch limit is exhausted. Fall back to full scans
+        // rather than silently missing changes.
+        stop_watching();
+        return;
+    }
+    watches_[wd] = dir;
+
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator{ abs_dir, ec })
+    {
+        if (entry.is_symlink(ec) || not entry.is_directory(ec))
+            continue;
+
+        const std::string name = entry.path().filename().string();
+        if (dir.empty() && name == ".git")
+            continue;
+
+        const std::string subdir = join_path(dir, name);
+        if (not options_.include_ignored)
+        {
+            // An ignored directory can only change the status if it contains tracked
+            // files (e.g. added with "git add -f")
+            int ignored = 0;
+            const std::string path = cat(subdir, '/');
+            if (git_ignore_path_is_ignored(&ignored, repo_.get_repo(), path.c_str()) == 0
+                && ignored && not has_index_entries_below(repo_.get_repo(), path))
+            {
+                unwatched_ignored_dirs_.insert(subdir);
+                continue;
+            }
+        }
+
+        watch_tree(subdir);
+        if (inotify_fd_ < 0)
+            return;
+    }
+#else
+    (void)dir;
+#endif
+}
+
+void StatusCache::watch_tracked_ignored_dirs()
+{
+    for (auto it = unwatched_ignored_dirs_.begin(); it != unwatched_ignored_dirs_.end(); )
+    {
+        if (has_index_entries_below(repo_.get_repo(), cat(*it, '/')))
+        {
+            const std::string dir = *it;
+            it = unwatched_ignored_dirs_.erase(it);
+            watch_tree(dir);
+            if (inotify_fd_ < 0)
+                return;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void StatusCache::read_events()
+{
+#ifdef __linux__
+    if (inotify_fd_ < 0)
+        return;
+
+    bool rewatch_needed = false;
+    alignas(struct inotify_event) char buf[16384];
+
+    for (;;)
+    {
+        const ssize_t len = ::read(inotify_fd_, buf, sizeof(buf));
+        if (len <= 0) // EAGAIN: No more pending events
+            break;
+
+        for (const char* ptr = buf; ptr < buf + len; )
+        {
+            const auto* event = reinterpret_cast<const struct inotify_event*>(ptr);
+            ptr += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW)
+            {
+                // Events have been lost, including possibly the creation of directories
+                full_scan_needed_ = true;
+                rewatch_needed = true;
+                continue;
+            }
+
+            auto it = watches_.find(event->wd);
+            if (it == watches_.end())
+                continue;
+
+            if (event->mask & IN_IGNORED)
+            {
+                watches_.erase(it);
+                continue;
+            }
+
+            if (event->len == 0)
+                continue;
+
+            const std::string dir = it->second; // watch_tree() may invalidate it
+            const std::string name = event->name;
+            if (dir.empty() && name == ".git")
+                continue;
+
+            const std::string path = join_path(dir, name);
+
+            if (event->mask & IN_ISDIR)
+            {
+                if (event->mask & (IN_MOVED_FROM | IN_MOVED_TO))
+                {
+                    // The paths of all watches below the directory are now stale
+                    full_scan_needed_ = true;
+                    rewatch_needed = true;
+                    continue;
+                }
+                if (event->mask & IN_CREATE)
+                {
+                    // Files may have been created before the watch is in place, so the
+                    // whole directory is marked as dirty
+                    watch_tree(path);
+                    if (inotify_fd_ < 0)
+                        return;
+                }
+            }
+            else if (name == ".gitignore")
+            {
+                // Directories that were ignored so far are not watched
+                full_scan_needed_ = true;
+                rewatch_needed = rewatch_needed || not options_.include_ignored;
+            }
+
+            dirty_paths_.insert(path);
+        }
+    }
+
+    if (rewatch_needed)
+        rewatch();
+#endif
+}
+
+StatusCache::GitState StatusCache::get_git_state() const
+{
+    GitState state;
+
+    const std::string index_path = cat(git_repository_path(repo_.get_repo()), "index");
+    struct stat st;
+    if (::stat(index_path.c_str(), &st) == 0)
+    {
+        state.index_inode = static_cast<std::uint64_t>(st.st_ino);
+        state.index_mtime_ns = static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1'000'000'000
+            + st.st_mtim.tv_nsec;
+        state.index_size = static_cast<std::int64_t>(st.st_size);
+    }
+
+    // An unborn HEAD leaves the ID zero
+    if (git_reference_name_to_id(&state.head_id, repo_.get_repo(), "HEAD") != 0)
+        state.head_id = git_oid{ };
+
+    return state;
+}
+
+StatusList StatusCache::status()
+{
+    ScopedTimer timer{ "StatusCache::status" };
+
+    read_events();
+
+    const bool git_state_changed = not (get_git_state() == git_state_);
+
+    // Files in ignored directories may have been added to the index (before the scan, so
+    // that later changes are noticed)
+    if (git_state_changed && is_watching())
+        watch_tracked_ignored_dirs();
+
+    if (full_scan_needed_ || not is_watching() || git_state_changed)
+        full_scan();
+    else if (not dirty_paths_.empty())
+        incremental_update();
+
+    StatusList result;
+    result.reserve(entries_.size());
+    for (const auto& [path, entry] : entries_)
+    {
+        result.push_back(
+            FileStatusView{ path, entry.old_path, entry.handling, entry.changes });
+    }
+    return result;
+}
+
+void StatusCache::full_scan()
+{
+    // Take the state before scanning: A change during the scan triggers another one
+    const GitState state = get_git_state();
+
+    StatusList list = repo_.status_list(options_);
+    entries_.clear();
+    store(list);
+
+    git_state_ = state;
+    full_scan_needed_ = false;
+    dirty_paths_.clear();
+    ++nr_full_scans_;
+}
+
+void StatusCache::incremental_update()
+{
+    // An untracked directory may be reported as a whole ("dir/"), so a change inside it
+    // has to be examined as a change of the directory
+    std::set<std::string> paths;
+    for (const std::string& path : dirty_paths_)
+    {
+        std::string examined = path;
+        for (auto pos = path.find('/'); pos != std::string::npos;
+             pos = path.find('/', pos + 1))
+        {
+            if (entries_.count(path.substr(0, pos + 1)))
+            {
+                examined = path.substr(0, pos);
+                break;
+            }
+        }
+        paths.insert(std::move(examined));
+    }
+
+    // Literal pathspecs match everything below a directory, so paths inside another dirty
+    // path are redundant
+    StatusOptions opts = options_;
+    opts.disable_pathspec_match = true;
+    for (const std::string& path : paths)
+    {
+        bool covered = false;
+        for (auto pos = path.find('/'); pos != std::string::npos && not covered;
+             pos = path.find('/', pos + 1))
+        {
+            covered = paths.count(path.substr(0, pos)) > 0;
+        }
+        if (not covered)
+            opts.pathspecs.push_back(path);
+    }
+
+    StatusList list = repo_.status_list(opts);
+
+    for (const std::string& path : opts.pathspecs)
+    {
+        entries_.erase(path);
+        // All keys starting with "path/" ('0' directly follows '/' in ASCII)
+        entries_.erase(entries_.lower_bound(cat(path, '/')),
+                       entries_.lower_bound(cat(path, '0')));
+    }
+
+    store(list);
+    dirty_paths_.clear();
+    ++nr_incremental_;
+}
+
+void StatusCache::store(const StatusList& list)
+{
+    for (const FileStatusView& view : list)
+    {
+        entries_[std::string(view.path)] =
+            Entry{ std::string(view.old_path), view.handling, view.changes };
+    }
+}
+
+} // namespace git
@@ -0,0 +1,303 @@
+/**
+ * \file   StatusList.cc
+ * \date   Created on October 14, 2026
+ * \brief  Implementation of the StatusList class.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <cstring>
+#include <limits>
+
+#include <gul14/cat.h>
+
+#include "libgit4cpp/Error.h"
+#include "libgit4cpp/StatusList.h"
+#include "status_entry.h"
+
+using gul14::cat;
+
+namespace git {
+
+namespace {
+
+// Fill the paths of a view from a diff delta; old_path is only set for real renames.
+void set_paths(FileStatusView& out, const git_diff_delta* delta) noexcept
+{
+    if (delta == nullptr)
+        return;
+
+    const char* old_path = delta->old_file.path;
+    const char* new_path = delta->new_file.path;
+
+    if (old_path && new_path && std::strcmp(old_path, new_path))
+    {
+        out.old_path = old_path;
+        out.path = new_path;
+    }
+    else
+    {
+        out.old_path = gul14::string_view{ };
+        out.path = old_path ? old_path : (new_path ? new_path : "");
+    }
+}
+
+// Determine the unstaged change; later flags in the list of git_status_t take precedence.
+bool get_unstaged_change(unsigned int status, FileChange& change) noexcept
+{
+    if (status & GIT_STATUS_WT_TYPECHANGE)
+        change = FileChange::typechange;
+    else if (status & GIT_STATUS_WT_RENAMED)
+        change = FileChange::renamed;
+    else if (status & GIT_STATUS_WT_DELETED)
+        change = FileChange::deleted;
+    else if (status & GIT_STATUS_WT_MODIFIED)
+        change = FileChange::modified;
+    else
+        return false;
+
+    return true;
+}
+
+// Determine the staged change; later flags in the list of git_status_t take precedence.
+bool get_staged_change(unsigned int status, FileChange& change) noexcept
+{
+    if (status & GIT_STATUS_INDEX_TYPECHANGE)
+        change = FileChange::typechange;
+    else if (status & GIT_STATUS_INDEX_RENAMED)
+        change = FileChange::renamed;
+    else if (status & GIT_STATUS_INDEX_DELETED)
+        change = FileChange::deleted;
+    else if (status & GIT_STATUS_INDEX_MODIFIED)
+        change = FileChange::modified;
+    else if (status & GIT_STATUS_INDEX_NEW)
+        change = FileChange::new_file;
+    else
+        return false;
+
+    return true;
+}
+
+} // anonymous namespace
+
+bool make_status_view(const git_status_entry* s, FileStatusView& out) noexcept
+{
+    // list files which exists but are untouched since last commit
+    if (s->status == GIT_STATUS_CURRENT)
+    {
+        out.handling = FileHandling::unchanged;
+        out.changes = FileChange::unchanged;
+        set_paths(out, s->head_to_index ? s->head_to_index : s->index_to_workdir);
+        out.old_path = gul14::string_view{ };
+        return true;
+    }
+
+    // list files which were touched but are not yet staged
+    if (get_unstaged_change(s->status, out.changes))
+    {
+        out.handling = FileHandling::unstaged;
+        set_paths(out, s->index_to_workdir);
+        return true;
+    }
+
+    // list files which are staged for next commit
+    if (get_staged_change(s->status, out.changes))
+    {
+        out.handling = FileHandling::staged;
+        set_paths(out, s->head_to_index);
+        return true;
+    }
+
+    // list untracked files
+    if (s->status == GIT_STATUS_WT_NEW)
+    {
+        out.handling = FileHandling::untracked;
+        out.changes = FileChange::untracked;
+        set_paths(out, s->index_to_workdir);
+        out.old_path = gul14::string_view{ };
+        return true;
+    }
+
+    // list ignored files
+    if (s->status == GIT_STATUS_IGNORED)
+    {
+        out.handling = FileHandling::ignored;
+        out.changes = FileChange::ignored;
+        set_paths(out, s->index_to_workdir);
+        out.old_path = gul14::string_view{ };
+        return true;
+    }
+
+    return false;
+}
+
+git_status_options make_status_options(const StatusOptions& options,
+    std::vector<const char*>& pathspec_storage)
+{
+    git_status_options status_opt = GIT_STATUS_OPTIONS_INIT;
+    status_opt.flags = 0;
+
+    if (options.include_untracked)
+        status_opt.flags |= GIT_STATUS_OPT_INCLUDE_UNTRACKED;
+    if (options.include_untracked && options.recurse_untracked_dirs)
+        status_opt.flags |= GIT_STATUS_OPT_RECURSE_UNTRACKED_DIRS;
+    if (options.include_unmodified)
+        status_opt.flags |= GIT_STATUS_OPT_INCLUDE_UNMODIFIED;
+    if (options.include_ignored)
+        status_opt.flags |= GIT_STATUS_OPT_INCLUDE_IGNORED;
+    if (options.detect_renames)
+    {
+        status_opt.flags |= GIT_STATUS_OPT_RENAMES_HEAD_TO_INDEX
+            | GIT_STATUS_OPT_RENAMES_INDEX_TO_WORKDIR;
+    }
+    if (options.disable_pathspec_match)
+        status_opt.flags |= GIT_STATUS_OPT_DISABLE_PATHSPEC_MATCH;
+
+    pathspec_storage.clear();
+    pathspec_storage.reserve(options.pathspecs.size());
+    for (const auto& pathspec : options.pathspecs)
+        pathspec_storage.push_back(pathspec.c_str());
+
+    status_opt.pathspec.strings = const_cast<char**>(pathspec_storage.data());
+    status_opt.pathspec.count = pathspec_storage.size();
+
+    return status_opt;
+}
+
+const char* to_string(FileHandling handling) noexcept
+{
+    switch (handling)
+    {
+        case FileHandling::unchanged: return "unchanged";
+        case FileHandling::unstaged: return "unstaged";
+        case FileHandling::staged: return "staged";
+        case FileHandling::untracked: return "untracked";
+        case FileHandling::ignored: return "ignored";
+    }
+    return "unknown";
+}
+
+const char* to_string(FileChange change) noexcept
+{
+    switch (change)
+    {
+        case FileChange::unchanged: return "unchanged";
+        case FileChange::new_file: return "new file";
+        case FileChange::modified: return "modified";
+        case FileChange::deleted: return "deleted";
+        case FileChange::renamed: return "renamed";
+        case FileChange::typechange: return "typechange";
+        case FileChange::untracked: return "untracked";
+        case FileChange::ignored: return "ignored";
+    }
+    return "unknown";
+}
+
+std::ostream& operator<<(std::ostream& stream, const FileStatusView& status)
+{
+    stream << "FileStatus{ \"";
+    if (status.is_renamed())
+        stream << gul14::escape(std::string(status.old_path)) << " -> ";
+    stream << gul14::escape(std::string(status.path)) << "\": "
+        << to_string(status.handling) << "; " << to_string(status.changes) << " }";
+    return stream;
+}
+
+StatusList::StatusList(git_status_list* status)
+{
+    const std::size_t nr_entries = git_status_list_entrycount(status);
+    entries_.reserve(nr_entries);
+
+    FileStatusView view;
+    for (std::size_t i = 0; i < nr_entries; ++i)
+    {
+        if (make_status_view(git_status_byindex(status, i), view))
+            push_back(view);
+    }
+}
+
+FileStatusView StatusList::operator[](size_type idx) const noexcept
+{
+    const Entry& e = entries_[idx];
+    const char* data = pool_.data();
+
+    FileStatusView view;
+    view.path = gul14::string_view{ data + e.path_offset, e.path_size };
+    if (e.old_path_size)
+        view.old_path = gul14::string_view{ data + e.old_path_offset, e.old_path_size };
+    view.handling = e.handling;
+    view.changes = e.changes;
+    return view;
+}
+
+void StatusList::push_back(const FileStatusView& entry)
+{
+    Entry e;
+    e.old_path_offset = store(entry.old_path);
+    e.old_path_size = static_cast<std::uint32_t>(entry.old_path.size());
+    e.path_offset = store(entry.path);
+    e.path_size = static_cast<std::uint32_t>(entry.path.size());
+    e.handling = entry.handling;
+    e.changes = entry.changes;
+    entries_.push_back(e);
+}
+
+void StatusList::reserve(size_type nr_entries, size_type nr_chars)
+{
+    entries_.reserve(nr_entries);
+    pool_.reserve(nr_chars);
+}
+
+std::uint32_t StatusList::store(gul14::string_view str)
+{
+    const std::size_t offset = pool_.size();
+
+    if (str.size() > std::numeric_limits<std::uint32_t>::max() - offset)
+        throw Error{ cat("Status list exceeds maximum size of ",
+            std::numeric_limits<std::uint32_t>::max(), " bytes") };
+
+    pool_.append(str.data(), str.size());
+    return static_cast<std::uint32_t>(offset);
+}
+
+FileStatus to_file_status(const FileStatusView& view)
+{
+    FileStatus status;
+
+    if (view.is_renamed())
+        status.path_name = cat(view.old_path, " -> ", view.path);
+    else
+        status.path_name = std::string(view.path);
+
+    status.handling = to_string(view.handling);
+    status.changes = to_string(view.changes);
+    return status;
+}
+
+RepoState to_repo_state(const StatusList& list)
+{
+    RepoState state;
+    state.reserve(list.size());
+
+    for (const FileStatusView& view : list)
+        state.push_back(to_file_status(view));
+
+    return state;
+}
+
+} // namespace git
@@ -0,0 +1,110 @@
+/**
+ * \file   blob_staging.cc
+ * \date   Created on October 14, 2026
+ * \brief  Implementation of helpers for creating the blobs of many files in parallel.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <atomic>
+#include <thread>
+
+#include <sys/stat.h>
+
+#include "libgit4cpp/wrapper_functions.h"
+#include "blob_staging.h"
+
+namespace git {
+
+namespace {
+
+// Fill the stat data of an index entry like libgit2 does for git_index_add_bypath().
+void fill_stat_data(git_index_entry& entry, const struct stat& st)
+{
+    entry.ctime.seconds = static_cast<std::int32_t>(st.st_ctim.tv_sec);
+    entry.ctime.nanoseconds = static_cast<std::uint32_t>(st.st_ctim.tv_nsec);
+    entry.mtime.seconds = static_cast<std::int32_t>(st.st_mtim.tv_sec);
+    entry.mtime.nanoseconds = static_cast<std::uint32_t>(st.st_mtim.tv_nsec);
+    entry.dev = static_cast<std::uint32_t>(st.st_dev);
+    entry.ino = static_cast<std::uint32_t>(st.st_ino);
+    entry.uid = static_cast<std::uint32_t>(st.st_uid);
+    entry.gid = static_cast<std::uint32_t>(st.st_gid);
+    entry.file_size = static_cast<std::uint32_t>(st.st_size);
+
+    if (S_ISLNK(st.st_mode))
+        entry.mode = GIT_FILEMODE_LINK;
+    else if (st.st_mode & S_IXUSR)
+        entry.mode = GIT_FILEMODE_BLOB_EXECUTABLE;
+    else
+        entry.mode = GIT_FILEMODE_BLOB;
+}
+
+void write_blob(git_repository* repo, const std::filesystem::path& workdir,
+    const std::filesystem::path& filepath, StagedBlob& blob)
+{
+    auto relative = filepath.is_absolute() ? filepath.lexically_relative(workdir)
+                                           : filepath.lexically_normal();
+    if (relative.empty() || *relative.begin() == "..")
+        return;
+
+    blob.path = relative.generic_string();
+
+    struct stat st;
+    if (::lstat((workdir / relative).c_str(), &st) != 0)
+        return;
+    if (not S_ISREG(st.st_mode) && not S_ISLNK(st.st_mode))
+        return;
+
+    if (git_blob_create_from_workdir(&blob.entry.id, repo, blob.path.c_str()))
+        return;
+
+    fill_stat_data(blob.entry, st);
+    blob.entry.path = blob.path.c_str();
+    blob.ok = true;
+}
+
+} // anonymous namespace
+
+std::vector<StagedBlob> write_blobs_in_parallel(const std::filesystem::path& repo_path,
+    const std::filesystem::path& workdir,
+    const std::vector<std::filesystem::path>& filepaths, unsigned int nr_threads)
+{
+    std::vector<StagedBlob> blobs(filepaths.size());
+    std::atomic<std::size_t> next_idx{ 0 };
+
+    auto work = [&]() {
+        // libgit2 objects must not be shared between threads: open a private handle
+        auto repo = repository_open(repo_path);
+        if (not repo)
+            return;
+
+        for (std::size_t i = next_idx++; i < filepaths.size(); i = next_idx++)
+            write_blob(repo.get(), workdir, filepaths[i], blobs[i]);
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(nr_threads);
+    for (unsigned int i = 0; i != nr_threads; ++i)
+        workers.emplace_back(work);
+    for (auto& worker : workers)
+        worker.join();
+
+    return blobs;
+}
+
+} // namespace git
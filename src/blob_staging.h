@@ -0,0 +1,71 @@
+/**
+ * \file   blob_staging.h
+ * \date   Created on October 14, 2026
+ * \brief  Declaration of helpers for creating the blobs of many files in parallel.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef LIBGIT4CPP_BLOB_STAGING_H_
+#define LIBGIT4CPP_BLOB_STAGING_H_
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <git2.h>
+
+namespace git {
+
+/// A file from the work tree whose blob has been written to the object database.
+struct StagedBlob
+{
+    /// Path relative to the work tree root with forward slashes (owned storage).
+    std::string path;
+    /// Index entry with object ID and stat data; entry.path points to \c path.
+    git_index_entry entry{ };
+    /// True if the blob was written and \c entry is valid.
+    bool ok = false;
+};
+
+/**
+ * Write the blobs for a list of work tree files to the object database in parallel.
+ *
+ * Each worker thread opens its own repository handle on \c repo_path, so no libgit2
+ * object is shared between threads. Files are filtered like by \c git add (e.g. line
+ * ending conversion) via git_blob_create_from_workdir().
+ *
+ * Directories, submodules, missing files, and paths outside the work tree are not
+ * processed; their StagedBlob has \c ok == false so that the caller can fall back to
+ * git_index_add_bypath() for them.
+ *
+ * \param repo_path  Path used to open the repository in each worker
+ * \param workdir    Root directory of the work tree
+ * \param filepaths  Files relative to the work tree root or absolute
+ * \param nr_threads Number of worker threads (at least 1)
+ * \return one StagedBlob per input file, in the same order. The entry.path members
+ *         point into the returned vector, which must therefore not be copied or
+ *         resized before the entries are used.
+ */
+std::vector<StagedBlob> write_blobs_in_parallel(const std::filesystem::path& repo_path,
+    const std::filesystem::path& workdir,
+    const std::vector<std::filesystem::path>& filepaths, unsigned int nr_threads);
+
+} // namespace git
+
+#endif
@@ -0,0 +1,60 @@
+/**
+ * \file   diff_result.h
+ * \date   Created on October 14, 2026
+ * \brief  Internal helpers for translating libgit2 diffs.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef LIBGIT4CPP_DIFF_RESULT_H_
+#define LIBGIT4CPP_DIFF_RESULT_H_
+
+#include <vector>
+
+#include <git2.h>
+
+#include "libgit4cpp/Diff.h"
+
+namespace git {
+
+/**
+ * Translate DiffOptions into libgit2 diff options.
+ *
+ * \param options  The options to translate
+ * \param pathspec_storage  Storage for the C string pointers of the pathspec array. The
+ *                 returned git_diff_options must not outlive this vector or
+ *                 \c options.
+ */
+git_diff_options make_diff_options(const DiffOptions& options,
+    std::vector<const char*>& pathspec_storage);
+
+/**
+ * Collect the deltas of a libgit2 diff according to the given options.
+ *
+ * Renames are detected first if requested. In DiffMode::patch, the diff is walked with
+ * git_diff_foreach() and the callbacks of the options are invoked for each hunk and
+ * line; otherwise only the deltas are read.
+ *
+ * \exception Error is thrown if the diff cannot be processed. Exceptions thrown by the
+ *            callbacks are propagated.
+ */
+DiffResult make_diff_result(git_diff* diff, const DiffOptions& options);
+
+} // namespace git
+
+#endif
@@ -0,0 +1,273 @@
+/**
+ * \file   remote_callbacks.cc
+ * \date   Created on October 14, 2026
+ * \brief  Implementation of libgit2 remote callbacks used by fetch and clone.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <gul14/cat.h>
+#include <gul14/finalizer.h>
+
+#include "libgit4cpp/Error.h"
+#include "credentials_callback.h"
+#include "remote_callbacks.h"
+
+using gul14::cat;
+
+namespace {
+
+#if LIBGIT2_FULLVERSION >= 99000
+using LibGitTransferProgress = git_indexer_progress;
+#else
+using LibGitTransferProgress = git_transfer_progress;
+#endif
+
+git::TransferProgress to_transfer_progress(const LibGitTransferProgress& stats) noexcept
+{
+    git::TransferProgress p;
+    p.total_objects = stats.total_objects;
+    p.indexed_objects = stats.indexed_objects;
+    p.received_objects = stats.received_objects;
+    p.local_objects = stats.local_objects;
+    p.total_deltas = stats.total_deltas;
+    p.indexed_deltas = stats.indexed_deltas;
+    p.received_bytes = stats.received_bytes;
+    return p;
+}
+
+} // anonymous namespace
+
+extern "C" {
+
+// Return true (and remember it) if the operation has been cancelled via the token.
+static bool check_cancelled(git::RemoteCallbackState* state) noexcept
+{
+    if (state != nullptr && state->token != nullptr && state->token->is_cancelled())
+        state->cancelled = true;
+    return state != nullptr && state->cancelled;
+}
+
+static int remote_credentials(git_cred** out_credentials, const char* url,
+    const char* username_from_url, unsigned int allowed_types, void* payload)
+{
+    if (check_cancelled(static_cast<git::RemoteCallbackState*>(payload)))
+        return GIT_EUSER;
+
+    return git::get_dummy_credentials_callback()(out_credentials, url, username_from_url,
+        allowed_types, nullptr);
+}
+
+static int remote_sideband_progress(const char* /*str*/, int /*len*/, void* payload)
+{
+    return check_cancelled(static_cast<git::RemoteCallbackState*>(payload)) ? GIT_EUSER : 0;
+}
+
+static int remote_pack_progress(int /*stage*/, uint32_t /*current*/, uint32_t /*total*/,
+    void* payload)
+{
+    return check_cancelled(static_cast<git::RemoteCallbackState*>(payload)) ? GIT_EUSER : 0;
+}
+
+static int remote_push_transfer_progress(unsigned int /*current*/, unsigned int /*total*/,
+    size_t bytes, void* payload)
+{
+    auto* state = static_cast<git::RemoteCallbackState*>(payload);
+    if (state)
+        state->sent_bytes = bytes;
+    return check_cancelled(state) ? GIT_EUSER : 0;
+}
+
+static int remote_transfer_progress(const LibGitTransferProgress* stats, void* payload)
+{
+    auto* state = static_cast<git::RemoteCallbackState*>(payload);
+    if (check_cancelled(state))
+        return GIT_EUSER;
+
+    if (state)
+        state->received_bytes = stats->received_bytes;
+
+    if (state == nullptr || state->on_progress == nullptr || not *state->on_progress)
+        return 0;
+
+    try
+    {
+        if ((*state->on_progress)(to_transfer_progress(*stats)))
+            return 0;
+    }
+    catch (...)
+    {
+        // Exceptions must not propagate through libgit2; treat them as cancellation
+    }
+
+    state->cancelled = true;
+    return GIT_EUSER;
+}
+
+static int remote_update_tips(const char* refname, const git_oid* old_id,
+    const git_oid* new_id, void* payload)
+{
+    auto* state = static_cast<git::RemoteCallbackState*>(payload);
+    if (state == nullptr || state->updates == nullptr)
+        return 0;
+
+    try
+    {
+        state->updates->push_back(git::RefUpdate{ refname, *old_id, *new_id });
+    }
+    catch (...)
+    {
+        return GIT_EUSER;
+    }
+    return 0;
+}
+
+} // extern "C"
+
+
+namespace git {
+
+git_remote_callbacks make_remote_callbacks(RemoteCallbackState& state)
+{
+    git_remote_callbacks callbacks;
+    int error = git_remote_init_callbacks(&callbacks, GIT_REMOTE_CALLBACKS_VERSION);
+    if (error)
+    {
+        throw Error{ error, cat("Cannot initialize remote callbacks: ",
+            git_error_last()->message) };
+    }
+
+    callbacks.credentials = remote_credentials;
+    callbacks.sideband_progress = remote_sideband_progress;
+    callbacks.pack_progress = remote_pack_progress;
+    callbacks.push_transfer_progress = remote_push_transfer_progress;
+    callbacks.transfer_progress = remote_transfer_progress;
+    callbacks.update_tips = remote_update_tips;
+    callbacks.payload = &state;
+    return callbacks;
+}
+
+void throw_if_cancelled(const CancellationToken* token, const char* what)
+{
+    if (token != nullptr && token->is_cancelled())
+        throw Error{ GIT_EUSER, cat(what, " cancelled") };
+}
+
+TransferProgress get_transfer_stats(git_remote* remote)
+{
+    const LibGitTransferProgress* stats = git_remote_stats(remote);
+    return stats ? to_transfer_progress(*stats) : TransferProgress{ };
+}
+
+std::vector<std::string> changed_refspecs(const git_remote* remote,
+    const std::vector<std::string>& refspecs, const RemoteReferenceList& before,
+    const RemoteReferenceList& now)
+{
+    std::vector<git_refspec*> parsed;
+    auto free_parsed = gul14::finally([&parsed]() {
+        for (auto* spec : parsed)
+            git_refspec_free(spec);
+    });
+
+    std::vector<const git_refspec*> specs;
+    if (refspecs.empty())
+    {
+        const auto nr_specs = git_remote_refspec_count(remote);
+        for (std::size_t i = 0; i != nr_specs; ++i)
+        {
+            const git_refspec* spec = git_remote_get_refspec(remote, i);
+            if (git_refspec_direction(spec) == GIT_DIRECTION_FETCH)
+                specs.push_back(spec);
+        }
+    }
+    else
+    {
+        parsed.reserve(refspecs.size());
+        for (const auto& str : refspecs)
+        {
+            git_refspec* spec = nullptr;
+            int error = git_refspec_parse(&spec, str.c_str(), 1);
+            if (error)
+            {
+                throw Error{ error, cat("Invalid refspec \"", str, "\": ",
+                    git_error_last()->message) };
+            }
+            parsed.push_back(spec);
+            specs.push_back(spec);
+        }
+    }
+
+    // Index the old advertisement once: RemoteReferenceList::find() is a linear scan, so
+    // looking up every current ref in it would be quadratic in the number of refs
+    using OldRef = std::pair<gul14::string_view, git_oid>;
+    std::vector<OldRef> old_refs;
+    old_refs.reserve(before.size());
+    for (const RemoteReference ref : before)
+        old_refs.emplace_back(ref.name, ref.id);
+    std::sort(old_refs.begin(), old_refs.end(),
+        [](const OldRef& a, const OldRef& b) { return a.first < b.first; });
+
+    std::vector<std::string> result;
+
+    for (const RemoteReference ref : now)
+    {
+        const auto old_ref = std::lower_bound(old_refs.begin(), old_refs.end(), ref.name,
+            [](const OldRef& a, gul14::string_view name) { return a.first < name; });
+        if (old_ref != old_refs.end() && old_ref->first == ref.name
+            && git_oid_equal(&old_ref->second, &ref.id))
+        {
+            continue;
+        }
+
+        const std::string name{ ref.name };
+
+        for (const git_refspec* spec : specs)
+        {
+            if (not git_refspec_src_matches(spec, name.c_str()))
+                continue;
+
+            const char* dst = git_refspec_dst(spec);
+            if (dst == nullptr || *dst == '\0')
+            {
+                result.push_back(name);
+                break;
+            }
+
+            git_buf buf{ };
+            auto dispose = gul14::finally([&buf]() { git_buf_dispose(&buf); });
+            int error = git_refspec_transform(&buf, spec, name.c_str());
+            if (error)
+            {
+                throw Error{ error, cat("Cannot apply refspec to \"", name, "\": ",
+                    git_error_last()->message) };
+            }
+
+            result.push_back(cat(git_refspec_force(spec) ? "+" : "", name, ':', buf.ptr));
+            break;
+        }
+    }
+
+    return result;
+}
+
+} // namespace git
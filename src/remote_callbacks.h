@@ -0,0 +1,92 @@
+/**
+ * \file   remote_callbacks.h
+ * \date   Created on October 14, 2026
+ * \brief  Declaration of libgit2 remote callbacks used by fetch and clone.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef LIBGIT4CPP_REMOTE_CALLBACKS_H_
+#define LIBGIT4CPP_REMOTE_CALLBACKS_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <git2.h>
+
+#include "libgit4cpp/CancellationToken.h"
+#include "libgit4cpp/FetchOptions.h"
+#include "libgit4cpp/RemoteReferenceList.h"
+
+namespace git {
+
+/**
+ * State shared between a network operation and the libgit2 callbacks installed by
+ * make_remote_callbacks(). All pointers may be null.
+ */
+struct RemoteCallbackState
+{
+    /// Receives transfer progress; returning false cancels the operation.
+    const TransferProgressCallback* on_progress{ nullptr };
+    /// Receives the references updated by git_remote_update_tips().
+    std::vector<RefUpdate>* updates{ nullptr };
+    /// Checked in every callback; if cancelled, the operation is aborted.
+    const CancellationToken* token{ nullptr };
+    /// Set if the operation was aborted by one of the callbacks.
+    bool cancelled{ false };
+    /// Number of bytes received so far (for metrics, see Metrics).
+    std::size_t received_bytes{ 0 };
+    /// Number of bytes sent so far by a push (for metrics, see Metrics).
+    std::size_t sent_bytes{ 0 };
+};
+
+/**
+ * Return remote callbacks that report transfer progress and reference updates to the
+ * given state and abort the operation if its cancellation token is set. Credentials
+ * are provided by the dummy credentials callback.
+ */
+git_remote_callbacks make_remote_callbacks(RemoteCallbackState& state);
+
+/**
+ * Throw an Error with code GIT_EUSER if the token is set.
+ * \param token  Cancellation token (may be null)
+ * \param what   Description of the operation for the error message
+ */
+void throw_if_cancelled(const CancellationToken* token, const char* what);
+
+/// Return the transfer statistics of the last download from a remote.
+TransferProgress get_transfer_stats(git_remote* remote);
+
+/**
+ * Determine the refspecs needed to fetch only the references that differ between two
+ * listings of a remote.
+ *
+ * Each changed reference is matched against the given fetch refspecs (or, if empty,
+ * against the fetch refspecs configured for the remote) and turned into an explicit
+ * refspec like "+refs/heads/main:refs/remotes/origin/main".
+ *
+ * \exception Error is thrown if one of the refspecs cannot be parsed.
+ */
+std::vector<std::string> changed_refspecs(const git_remote* remote,
+    const std::vector<std::string>& refspecs, const RemoteReferenceList& before,
+    const RemoteReferenceList& now);
+
+} // namespace git
+
+#endif
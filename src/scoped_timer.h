@@ -0,0 +1,73 @@
+/**
+ * \file   scoped_timer.h
+ * \date   Created on October 14, 2026
+ * \brief  Helpers for reporting to the installed Metrics sink.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef LIBGIT4CPP_SCOPED_TIMER_H_
+#define LIBGIT4CPP_SCOPED_TIMER_H_
+
+#include <chrono>
+#include <cstdint>
+
+#include "libgit4cpp/Metrics.h"
+
+namespace git {
+
+/**
+ * Measure the time from construction to destruction and report it to the Metrics sink
+ * that was installed at construction. Without a sink, the clock is not read.
+ */
+class ScopedTimer
+{
+public:
+    /// Start timing an operation (the name must outlive the timer, e.g. a literal).
+    explicit ScopedTimer(const char* operation) noexcept
+        : sink_{ get_metrics() }, operation_{ operation }
+    {
+        if (sink_)
+            start_ = std::chrono::steady_clock::now();
+    }
+
+    ~ScopedTimer()
+    {
+        if (sink_)
+            sink_->record_latency(operation_, std::chrono::steady_clock::now() - start_);
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Metrics* sink_;
+    const char* operation_;
+    std::chrono::steady_clock::time_point start_{ };
+};
+
+/// Add a value to a counter of the installed Metrics sink (if any).
+inline void count_metric(const char* counter, std::uint64_t value) noexcept
+{
+    if (auto* sink = get_metrics())
+        sink->add_to_counter(counter, value);
+}
+
+} // namespace git
+
+#endif
@@ -0,0 +1,63 @@
+/**
+ * \file   status_entry.h
+ * \date   Created on October 14, 2026
+ * \brief  Declaration of helpers for translating between libgit2 and libgit4cpp status types.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef LIBGIT4CPP_STATUS_ENTRY_H_
+#define LIBGIT4CPP_STATUS_ENTRY_H_
+
+#include <string>
+#include <vector>
+
+#include <git2.h>
+
+#include "libgit4cpp/StatusList.h"
+
+namespace git {
+
+/**
+ * Translate a libgit2 status entry into a FileStatusView.
+ *
+ * The paths in the resulting view point directly into the memory of the status entry,
+ * so they are only valid as long as the underlying git_status_list is alive.
+ *
+ * \param s    The status entry to examine
+ * \param out  View to be filled with the status of the file
+ * \return true if the entry was translated, false if it does not map onto one of the
+ *         handling states (e.g. for conflicted files). In the latter case, \c out is
+ *         left in an unspecified state.
+ */
+bool make_status_view(const git_status_entry* s, FileStatusView& out) noexcept;
+
+/**
+ * Translate StatusOptions into libgit2 status options.
+ *
+ * \param options  The options to translate
+ * \param pathspec_storage  Storage for the C string pointers of the pathspec array. The
+ *                 returned git_status_options must not outlive this vector or
+ *                 \c options.
+ */
+git_status_options make_status_options(const StatusOptions& options,
+    std::vector<const char*>& pathspec_storage);
+
+} // namespace git
+
+#endif
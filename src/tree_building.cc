@@ -0,0 +1,178 @@
+/**
+ * \file   tree_building.cc
+ * \date   Created on October 14, 2026
+ * \brief  Implementation of helpers for building trees directly in the object database.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <string>
+
+#include <gul14/cat.h>
+
+#include "libgit4cpp/Error.h"
+#include "libgit4cpp/wrapper_functions.h"
+#include "tree_building.h"
+
+using gul14::cat;
+
+namespace git {
+
+namespace {
+
+using ChangeIterator = TreeChanges::const_iterator;
+
+void check_path(const std::string& path)
+{
+    if (path.empty() || path.front() == '/' || path.back() == '/')
+        throw Error{ cat("Invalid path for commit: \"", path, "\"") };
+
+    std::size_t start = 0;
+    while (start <= path.size())
+    {
+        auto end = path.find('/', start);
+        if (end == std::string::npos)
+            end = path.size();
+
+        const auto component = path.substr(start, end - start);
+        if (component.empty() || component == "." || component == ".." || component == ".git")
+            throw Error{ cat("Invalid path for commit: \"", path, "\"") };
+
+        start = end + 1;
+    }
+}
+
+/**
+ * Apply the changes in [begin, end) to the tree \c base. All paths in the range share
+ * the first \c prefix_len characters, which name the directory represented by \c base.
+ * Return the number of entries of the written tree.
+ */
+std::size_t write_subtree(git_repository* repo, const git_tree* base,
+    ChangeIterator begin, ChangeIterator end, std::size_t prefix_len, git_oid& tree_id)
+{
+    auto builder = treebuilder_new(repo, base);
+    if (not builder)
+        throw Error{ cat("Cannot create tree builder: ", git_error_last()->message) };
+
+    auto it = begin;
+    while (it != end)
+    {
+        const std::string& path = it->first;
+        const auto slash = path.find('/', prefix_len);
+
+        if (slash == std::string::npos)
+        {
+            // A file in this directory
+            const std::string name = path.substr(prefix_len);
+
+            if (not it->second)
+            {
+                const int error = git_treebuilder_remove(builder.get(), name.c_str());
+                if (error && error != GIT_ENOTFOUND)
+                    throw Error{ error, cat("Cannot remove \"", path, "\" from tree: ",
+                        git_error_last()->message) };
+                ++it;
+                continue;
+            }
+
+            git_oid blob_id;
+            const std::string& content = *it->second;
+            int error = git_blob_create_from_buffer(&blob_id, repo, content.data(),
+                content.size());
+            if (error)
+                throw Error{ error, cat("Cannot create blob for \"", path, "\": ",
+                    git_error_last()->message) };
+
+            git_filemode_t mode = GIT_FILEMODE_BLOB;
+            const git_tree_entry* existing = git_treebuilder_get(builder.get(), name.c_str());
+            if (existing && git_tree_entry_filemode(existing) == GIT_FILEMODE_BLOB_EXECUTABLE)
+                mode = GIT_FILEMODE_BLOB_EXECUTABLE;
+
+            error = git_treebuilder_insert(nullptr, builder.get(), name.c_str(), &blob_id,
+                mode);
+            if (error)
+                throw Error{ error, cat("Cannot insert \"", path, "\" into tree: ",
+                    git_error_last()->message) };
+            ++it;
+            continue;
+        }
+
+        // A subdirectory: changes with the same directory prefix are contiguous in the map
+        const std::string name = path.substr(prefix_len, slash - prefix_len);
+        const std::size_t sub_prefix_len = slash + 1;
+        auto sub_end = it;
+        while (sub_end != end && sub_end->first.size() > sub_prefix_len
+            && sub_end->first.compare(0, sub_prefix_len, path, 0, sub_prefix_len) == 0)
+        {
+            ++sub_end;
+        }
+
+        LibGitTree subtree;
+        const git_tree_entry* existing = git_treebuilder_get(builder.get(), name.c_str());
+        if (existing && git_tree_entry_type(existing) == GIT_OBJECT_TREE)
+        {
+            subtree = tree_lookup(repo, *git_tree_entry_id(existing));
+            if (not subtree)
+                throw Error{ cat("Cannot look up tree \"", name, "\": ",
+                    git_error_last()->message) };
+        }
+
+        git_oid subtree_id;
+        const auto nr_entries = write_subtree(repo, subtree.get(), it, sub_end,
+            sub_prefix_len, subtree_id);
+
+        int error;
+        if (nr_entries == 0)
+        {
+            error = git_treebuilder_remove(builder.get(), name.c_str());
+            if (error == GIT_ENOTFOUND)
+                error = 0;
+        }
+        else
+        {
+            error = git_treebuilder_insert(nullptr, builder.get(), name.c_str(),
+                &subtree_id, GIT_FILEMODE_TREE);
+        }
+        if (error)
+            throw Error{ error, cat("Cannot update directory \"", path.substr(0, slash),
+                "\" in tree: ", git_error_last()->message) };
+
+        it = sub_end;
+    }
+
+    const int error = git_treebuilder_write(&tree_id, builder.get());
+    if (error)
+        throw Error{ error, cat("Cannot write tree: ", git_error_last()->message) };
+
+    return git_treebuilder_entrycount(builder.get());
+}
+
+} // anonymous namespace
+
+git_oid write_tree_with_changes(git_repository* repo, const git_tree* base,
+    const TreeChanges& changes)
+{
+    for (const auto& change : changes)
+        check_path(change.first);
+
+    git_oid tree_id;
+    write_subtree(repo, base, changes.begin(), changes.end(), 0, tree_id);
+    return tree_id;
+}
+
+} // namespace git
@@ -0,0 +1,53 @@
+/**
+ * \file   tree_building.h
+ * \date   Created on October 14, 2026
+ * \brief  Declaration of helpers for building trees directly in the object database.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#ifndef LIBGIT4CPP_TREE_BUILDING_H_
+#define LIBGIT4CPP_TREE_BUILDING_H_
+
+#include <git2.h>
+
+#include "libgit4cpp/Repository.h"
+
+namespace git {
+
+/**
+ * Write a new tree to the object database that results from applying a set of changes
+ * to an existing tree.
+ *
+ * Blobs are created directly from the in-memory contents; neither the index nor the
+ * work tree are involved. Only the subtrees touched by the changes are rewritten, and
+ * directories that become empty are dropped. The executable bit of overwritten files is
+ * preserved.
+ *
+ * \param repo     Repository whose object database is used
+ * \param base     Tree to start from (null for an empty tree)
+ * \param changes  Files to add, overwrite, or remove
+ * \return the ID of the new tree.
+ * \exception Error is thrown if a path is invalid or if an object cannot be written.
+ */
+git_oid write_tree_with_changes(git_repository* repo, const git_tree* base,
+    const TreeChanges& changes);
+
+} // namespace git
+
+#endif
@@ -28,11 +28,13 @@
 
 #include "libgit4cpp/wrapper_functions.h"
 #include "libgit4cpp/Error.h"
+#include "scoped_timer.h"
 
 namespace git {
 
 LibGitRepository repository_open(const std::string& repo_path)
 {
+    ScopedTimer timer{ "git_repository_open" };
     git_repository* repo;
     if (git_repository_open(&repo, repo_path.c_str()))
     {
@@ -40,11 +42,12 @@ LibGitRepository repository_open(const std::string& repo_path)
         repo = nullptr;
     }
 
-    return { repo, git_repository_free };
+    return LibGitRepository{ repo };
 }
 
 LibGitRepository repository_init(const std::string& repo_path, bool is_bare)
 {
+    ScopedTimer timer{ "git_repository_init_ext" };
     git_repository_init_options opts;
     git_repository_init_init_options(&opts, GIT_REPOSITORY_INIT_OPTIONS_VERSION);
     if (is_bare)
@@ -58,29 +61,31 @@ LibGitRepository repository_init(const std::string& repo_path, bool is_bare)
         // gul14::cat("repository_init: ", git_error_last()->message);
         repo = nullptr;
     }
-    return { repo, git_repository_free };
+    return LibGitRepository{ repo };
 }
 
 LibGitIndex repository_index(git_repository* repo)
 {
+    ScopedTimer timer{ "git_repository_index" };
     git_index* index;
     if (git_repository_index(&index, repo))
     {
         // gul14::cat("repository_index: ", git_error_last()->message);
         index = nullptr;
     }
-    return { index, git_index_free };
+    return LibGitIndex{ index };
 }
 
 LibGitSignature signature_default(git_repository* repo)
 {
+    ScopedTimer timer{ "git_signature_default" };
     git_signature* signature;
     if (git_signature_default(&signature, repo))
     {
         // gul14::cat("signature_default: ", git_error_last()->message);
         signature = nullptr;
     }
-    return { signature, git_signature_free };
+    return LibGitSignature{ signature };
 }
 
 LibGitSignature signature_new(const std::string& name, const std::string& email, time_t time, int offset)
@@ -91,105 +96,143 @@ LibGitSignature signature_new(const std::string& name, const std::string& email,
         // gul14::cat("signature_new: ", git_error_last()->message);
         signature = nullptr;
     }
-    return { signature, git_signature_free };
+    return LibGitSignature{ signature };
 }
 
 LibGitTree tree_lookup(git_repository* repo, git_oid tree_id)
 {
+    ScopedTimer timer{ "git_tree_lookup" };
     git_tree* tree;
     if (git_tree_lookup(&tree, repo, &tree_id))
     {
         // gul14::cat("tree_lookup: ", git_error_last()->message);
         tree = nullptr;
     }
-    return { tree, git_tree_free };
+    return LibGitTree{ tree };
+}
+
+LibGitTreeBuilder treebuilder_new(git_repository* repo, const git_tree* source)
+{
+    ScopedTimer timer{ "git_treebuilder_new" };
+    git_treebuilder* builder;
+    if (git_treebuilder_new(&builder, repo, source))
+        builder = nullptr;
+    return LibGitTreeBuilder{ builder };
+}
+
+LibGitCommit commit_lookup(git_repository* repo, const git_oid& commit_id)
+{
+    ScopedTimer timer{ "git_commit_lookup" };
+    git_commit* commit;
+    if (git_commit_lookup(&commit, repo, &commit_id))
+        commit = nullptr;
+    return LibGitCommit{ commit };
+}
+
+LibGitRevwalk revwalk_new(git_repository* repo)
+{
+    ScopedTimer timer{ "git_revwalk_new" };
+    git_revwalk* walk;
+    if (git_revwalk_new(&walk, repo))
+        walk = nullptr;
+    return LibGitRevwalk{ walk };
 }
 
 LibGitRemote remote_create(git_repository* repo, const std::string& remote_name,
               const std::string& url)
 {
+    ScopedTimer timer{ "git_remote_create" };
     git_remote* remote;
     if (git_remote_create(&remote, repo, remote_name.c_str(), url.c_str()))
     {
         // gul14::cat("remote_create: ", git_error_last()->message);
         remote = nullptr;
     }
-    return { remote, git_remote_free };
+    return LibGitRemote{ remote };
 }
 
 LibGitRemote remote_lookup(git_repository* repo, const std::string& remote_name)
 {
+    ScopedTimer timer{ "git_remote_lookup" };
     git_remote* remote = nullptr;
     if (repo)
         git_remote_lookup(&remote, repo, remote_name.c_str());
-    return { remote, git_remote_free };
+    return LibGitRemote{ remote };
 }
 
 LibGitStatusList status_list_new(git_repository* repo, const git_status_options& status_opt)
 {
+    ScopedTimer timer{ "git_status_list_new" };
     git_status_list* status;
     if (git_status_list_new(&status, repo, &status_opt))
     {
         // gul14::cat("status_list_new: ", git_error_last()->message);
         status = nullptr;
     }
-    return { status, git_status_list_free };
+    return LibGitStatusList{ status };
 }
 
 LibGitReference repository_head(git_repository* repo)
 {
+    ScopedTimer timer{ "git_repository_head" };
     git_reference* reference;
     if (git_repository_head(&reference, repo))
     {
         // gul14::cat("reposiotry_head: ", git_error_last()->message);
         reference = nullptr;
     }
-    return { reference, git_reference_free };
+    return LibGitReference{ reference };
 }
 
-LibGitRepository clone(const std::string& url, const std::string& repo_path)
+LibGitRepository clone(const std::string& url, const std::string& repo_path,
+    const git_clone_options* options)
 {
+    ScopedTimer timer{ "git_clone" };
     git_repository* repo;
-    if (git_clone(&repo, url.c_str(), repo_path.c_str(), nullptr))
+    if (git_clone(&repo, url.c_str(), repo_path.c_str(), options))
     {
         // gul14::cat("branch_remote_name: ", git_error_last()->message);
         repo = nullptr;
     }
-    return { repo, git_repository_free };
+    return LibGitRepository{ repo };
 
 }
 
 LibGitReference branch_lookup(git_repository* repo, const std::string& branch_name, git_branch_t branch_type)
 {
+    ScopedTimer timer{ "git_branch_lookup" };
     git_reference* ref;
     if (git_branch_lookup(&ref, repo, branch_name.c_str(), branch_type))
     {
         // gul14::cat("branch_lookup: ", git_error_last()->message);
         ref = nullptr;
     }
-    return { ref, git_reference_free };
+    return LibGitReference{ ref };
 }
 
 LibGitTree commit_tree(git_commit* commit)
 {
+    ScopedTimer timer{ "git_commit_tree" };
     git_tree* tree;
     if (git_commit_tree(&tree, commit))
     {
         tree = nullptr;
     }
-    return { tree, git_tree_free };
+    return LibGitTree{ tree };
 }
 
 LibGitReference branch_create(git_repository* repo, const std::string& new_branch_name, const git_commit* starting_commit, int force)
 {
+    ScopedTimer timer{ "git_branch_create" };
     git_reference* ref;
     if(git_branch_create(&ref, repo, new_branch_name.c_str(), starting_commit, force))
         ref = nullptr;
-    return {ref, git_reference_free};
+    return LibGitReference{ ref };
 }
 
 std::string branch_remote_name(git_repository* repo, const std::string& branch_name)
 {
+    ScopedTimer timer{ "git_branch_remote_name" };
     git_buf buf{ };
     auto _ = gul14::finally([buf_addr = &buf]() { git_buf_dispose(buf_addr); });
     auto error = git_branch_remote_name(&buf, repo, branch_name.c_str());
@@ -218,29 +261,32 @@ std::string reference_name(git_reference* ref)
 
 LibGitReference parse_reference_from_name(git_repository* repo, const std::string& name)
 {
+    ScopedTimer timer{ "git_reference_dwim" };
     git_reference* ref;
     auto error = git_reference_dwim(&ref, repo, name.c_str());
     if (error)
         throw Error{gul14::cat("parse_reference_from_name: ", git_error_last()->message) };
-    return {ref, git_reference_free};
+    return LibGitReference{ ref };
 }
 
 LibGitBranchIterator branch_iterator(git_repository* repo, git_branch_t flag)
 {
+    ScopedTimer timer{ "git_branch_iterator_new" };
     git_branch_iterator* iter;
     auto error = git_branch_iterator_new(&iter, repo, flag);
     if (error)
         throw Error{gul14::cat("get_branch_iterator: ", git_error_last()->message) };
-    return {iter, git_branch_iterator_free};
+    return LibGitBranchIterator{ iter };
 }
 
 LibGitReference branch_next(git_branch_t* branch_type, git_branch_iterator* iter)
 {
+    ScopedTimer timer{ "git_branch_next" };
     git_reference* ref;
     int error = git_branch_next(&ref, branch_type, iter);
     if (error == GIT_ITEROVER)
         ref = nullptr;
-    return {ref, git_reference_free};
+    return LibGitReference{ ref };
 }
 
 } // namespace git
@@ -0,0 +1,175 @@
+/**
+ * \file   test_BlobContent.cc
+ * \date   Created on October 14, 2026
+ * \brief  Test suite for the BlobContent class and Repository::read_blob().
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <gul14/catch.h>
+
+#include "libgit4cpp/BlobContent.h"
+#include "libgit4cpp/Error.h"
+#include "libgit4cpp/Repository.h"
+#include "test_main.h"
+
+using namespace git;
+using namespace std::literals;
+
+TEST_CASE("BlobContent: Default constructor", "[BlobContent]")
+{
+    BlobContent content;
+    REQUIRE(content.empty());
+    REQUIRE(content.size() == 0);
+    REQUIRE(content.data().empty());
+    REQUIRE(content.get() == nullptr);
+    REQUIRE(content.is_filtered() == false);
+}
+
+TEST_CASE("BlobContent: Repository::read_blob()", "[BlobContent]")
+{
+    const auto path = unit_test_folder() / "BlobContent_read_blob";
+    std::filesystem::remove_all(path);
+
+    Repository repo{ path };
+    repo.commit_files({ { "file.txt", "first"s }, { "dir/sub.txt", "sub"s } },
+        "Add files");
+    repo.commit_files({ { "file.txt", "second version"s } }, "Modify file.txt");
+
+    SECTION("Content at different revisions")
+    {
+        auto content = repo.read_blob("HEAD", "file.txt");
+        REQUIRE(content.data() == "second version");
+        REQUIRE(content.size() == 14);
+        REQUIRE(content.is_binary() == false);
+        REQUIRE(content.is_filtered() == false);
+
+        // Without filters, the view points directly into the libgit2 blob
+        REQUIRE(content.data().data() == git_blob_rawcontent(content.get()));
+
+        REQUIRE(repo.read_blob("HEAD~1", "file.txt").data() == "first");
+        REQUIRE(repo.read_blob("HEAD", "dir/sub.txt").data() == "sub");
+    }
+
+    SECTION("Move construction and assignment")
+    {
+        auto content = repo.read_blob("HEAD", "file.txt");
+        const auto ptr = content.data().data();
+
+        BlobContent moved{ std::move(content) };
+        REQUIRE(content.empty());
+        REQUIRE(moved.data().data() == ptr);
+
+        content = std::move(moved);
+        REQUIRE(moved.empty());
+        REQUIRE(content.data() == "second version");
+    }
+
+    SECTION("Missing paths and directories throw")
+    {
+        try
+        {
+            repo.read_blob("HEAD", "does_not_exist.txt");
+            FAIL("No exception thrown");
+        }
+        catch (const Error& e)
+        {
+            REQUIRE(e.code().value() == GIT_ENOTFOUND);
+        }
+
+        REQUIRE_THROWS_AS(repo.read_blob("HEAD", "dir"), Error);
+        REQUIRE_THROWS_AS(repo.read_blob("HEAD~5", "file.txt"), Error);
+    }
+}
+
+TEST_CASE("BlobContent: Repository::read_blob() with filters", "[BlobContent]")
+{
+    const auto path = unit_test_folder() / "BlobContent_filters";
+    std::filesystem::remove_all(path);
+
+    Repository repo{ path };
+    repo.commit_files({ { "file.txt", "a\nb\n"s } }, "Add file.txt");
+
+    // Attributes are looked up in the work tree
+    std::ofstream{ path / ".gitattributes" } << "*.txt text eol=crlf\n";
+
+    auto raw = repo.read_blob("HEAD", "file.txt");
+    REQUIRE(raw.data() == "a\nb\n");
+
+    BlobReadOptions opt;
+    opt.apply_filters = true;
+    auto filtered = repo.read_blob("HEAD", "file.txt", opt);
+    REQUIRE(filtered.is_filtered());
+    REQUIRE(filtered.data() == "a\r\nb\r\n");
+}
+
+TEST_CASE("BlobContent: Repository::stream_blob()", "[BlobContent]")
+{
+    const auto path = unit_test_folder() / "BlobContent_stream_blob";
+    std::filesystem::remove_all(path);
+
+    Repository repo{ path };
+    repo.commit_files({ { "file.txt", "0123456789"s } }, "Add file.txt");
+
+    BlobReadOptions opt;
+    opt.chunk_size = 4;
+
+    SECTION("All chunks")
+    {
+        std::string result;
+        int num_chunks = 0;
+        auto size = repo.stream_blob("HEAD", "file.txt",
+            [&](gul14::string_view chunk)
+            {
+                REQUIRE(chunk.size() <= 4);
+                result.append(chunk.data(), chunk.size());
+                ++num_chunks;
+                return true;
+            },
+            opt);
+
+        REQUIRE(size == 10);
+        REQUIRE(num_chunks == 3);
+        REQUIRE(result == "0123456789");
+    }
+
+    SECTION("Stop early")
+    {
+        std::string result;
+        auto size = repo.stream_blob("HEAD", "file.txt",
+            [&](gul14::string_view chunk)
+            {
+                result.append(chunk.data(), chunk.size());
+                return false;
+            },
+            opt);
+
+        REQUIRE(size == 4);
+        REQUIRE(result == "0123");
+    }
+
+    SECTION("Missing path throws")
+    {
+        REQUIRE_THROWS_AS(repo.stream_blob("HEAD", "nope.txt",
+            [](gul14::string_view) { return true; }), Error);
+    }
+}
@@ -0,0 +1,290 @@
+/**
+ * \file   test_CommitLog.cc
+ * \date   Created on October 14, 2026
+ * \brief  Test suite for the CommitLog class and Repository::log().
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gul14/catch.h>
+#include <gul14/cat.h>
+
+#include "libgit4cpp/CommitLog.h"
+#include "libgit4cpp/Error.h"
+#include "libgit4cpp/Repository.h"
+#include "test_main.h"
+
+using namespace git;
+using namespace std::literals;
+
+namespace {
+
+// Create a repository with the initial commit and five further commits "Commit 0" to
+// "Commit 4". Commits 1 and 3
+// change "sub/tracked.txt", all others change "other.txt".
+std::filesystem::path make_history()
+{
+    const auto root = unit_test_folder() / "CommitLog";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "sub");
+
+    Repository repo{ root };
+    for (int i = 0; i != 5; ++i)
+    {
+        if (i % 2)
+            std::ofstream(root / "sub" / "tracked.txt") << "Version " << i;
+        else
+            std::ofstream(root / "other.txt") << "Version " << i;
+
+        repo.add();
+        repo.commit(gul14::cat("Commit ", i, "\n\nBody of commit ", i));
+    }
+
+    return root;
+}
+
+// Create a repository in which "sub/tracked.txt" is changed on a side branch that is
+// merged into main by the commit "Merge side":
+//
+//   Initial commit - Base - Main change - Merge side
+//                       \                 /
+//                        Side change ----
+std::filesystem::path make_merge_history()
+{
+    const auto root = unit_test_folder() / "CommitLog_merge";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "sub");
+
+    Repository repo{ root };
+    std::ofstream(root / "other.txt") << "Version 0";
+    std::ofstream(root / "sub" / "tracked.txt") << "Version 0";
+    repo.add();
+    repo.commit("Base");
+
+    repo.new_branch("side");
+    repo.switch_branch("side");
+    std::ofstream(root / "sub" / "tracked.txt") << "Version 1";
+    repo.add();
+    repo.commit("Side change");
+
+    repo.switch_branch("main");
+    std::ofstream(root / "other.txt") << "Version 1";
+    repo.add();
+    repo.commit("Main change");
+
+    // Record the merge with the combined tree of both branches
+    std::ofstream(root / "sub" / "tracked.txt") << "Version 1";
+    repo.add();
+
+    git_index* index_ptr = nullptr;
+    REQUIRE(git_repository_index(&index_ptr, repo.get_repo()) == 0);
+    LibGitIndex index{ index_ptr };
+    git_oid tree_id;
+    REQUIRE(git_index_write_tree(&tree_id, index.get()) == 0);
+    git_tree* tree_ptr = nullptr;
+    REQUIRE(git_tree_lookup(&tree_ptr, repo.get_repo(), &tree_id) == 0);
+    LibGitTree tree{ tree_ptr };
+
+    git_oid main_id, side_id;
+    REQUIRE(git_reference_name_to_id(&main_id, repo.get_repo(), "refs/heads/main") == 0);
+    REQUIRE(git_reference_name_to_id(&side_id, repo.get_repo(), "refs/heads/side") == 0);
+    git_commit* main_ptr = nullptr;
+    git_commit* side_ptr = nullptr;
+    REQUIRE(git_commit_lookup(&main_ptr, repo.get_repo(), &main_id) == 0);
+    LibGitCommit main_commit{ main_ptr };
+    REQUIRE(git_commit_lookup(&side_ptr, repo.get_repo(), &side_id) == 0);
+    LibGitCommit side_commit{ side_ptr };
+
+    git_signature* sig_ptr = nullptr;
+    REQUIRE(git_signature_now(&sig_ptr, "Test", "test@example.com") == 0);
+    LibGitSignature sig{ sig_ptr };
+
+    const git_commit* parents[] = { main_commit.get(), side_commit.get() };
+    git_oid merge_id;
+    REQUIRE(git_commit_create(&merge_id, repo.get_repo(), "HEAD", sig.get(), sig.get(),
+        nullptr, "Merge side", tree.get(), 2, parents) == 0);
+
+    return root;
+}
+
+std::vector<std::string> summaries(CommitLog&& log)
+{
+    std::vector<std::string> result;
+    for (const auto& commit : log)
+        result.emplace_back(commit.summary());
+    return result;
+}
+
+} // anonymous namespace
+
+TEST_CASE("CommitLog: Walk the full history", "[CommitLog]")
+{
+    Repository repo{ make_history() };
+
+    LogOptions opt;
+    opt.sort = LogSort::topological_time;
+
+    REQUIRE(summaries(repo.log(opt)) == std::vector<std::string>{
+        "Commit 4", "Commit 3", "Commit 2", "Commit 1", "Commit 0", "Initial commit" });
+
+    opt.reverse = true;
+    REQUIRE(summaries(repo.log(opt)) == std::vector<std::string>{
+        "Initial commit", "Commit 0", "Commit 1", "Commit 2", "Commit 3", "Commit 4" });
+}
+
+TEST_CASE("CommitLog: CommitRecord accessors", "[CommitLog]")
+{
+    Repository repo{ make_history() };
+
+    auto log = repo.log();
+    auto commit = log.next();
+    REQUIRE(commit.has_value());
+
+    REQUIRE(commit->summary() == "Commit 4");
+    REQUIRE(commit->message() == "Commit 4\n\nBody of commit 4");
+    REQUIRE(commit->id_string().size() == 40);
+    REQUIRE(commit->parent_count() == 1);
+    REQUIRE(commit->time() > 0);
+    REQUIRE(not commit->author_name().empty());
+
+    git_oid head_id;
+    REQUIRE(git_reference_name_to_id(&head_id, repo.get_repo(), "HEAD") == 0);
+    REQUIRE(git_oid_equal(&commit->id(), &head_id));
+
+    // Copies share the underlying commit object
+    const CommitRecord copy = *commit;
+    REQUIRE(git_oid_equal(&copy.id(), &commit->id()));
+    REQUIRE(copy.summary() == "Commit 4");
+}
+
+TEST_CASE("CommitLog: next_page()", "[CommitLog]")
+{
+    Repository repo{ make_history() };
+
+    LogOptions opt;
+    opt.sort = LogSort::topological_time;
+    opt.page_size = 2;
+    auto log = repo.log(opt);
+
+    auto page = log.next_page();
+    REQUIRE(page.size() == 2);
+    REQUIRE(page[0].summary() == "Commit 4");
+    REQUIRE(page[1].summary() == "Commit 3");
+
+    page = log.next_page();
+    REQUIRE(page.size() == 2);
+    REQUIRE(page[0].summary() == "Commit 2");
+    REQUIRE(page[1].summary() == "Commit 1");
+
+    page = log.next_page();
+    REQUIRE(page.size() == 2);
+    REQUIRE(page[0].summary() == "Commit 0");
+    REQUIRE(page[1].summary() == "Initial commit");
+
+    REQUIRE(log.next_page().empty());
+    REQUIRE(not log.next().has_value());
+}
+
+TEST_CASE("CommitLog: Path filter", "[CommitLog]")
+{
+    Repository repo{ make_history() };
+
+    LogOptions opt;
+    opt.sort = LogSort::topological_time;
+
+    SECTION("File")
+    {
+        opt.paths = { "sub/tracked.txt" };
+        REQUIRE(summaries(repo.log(opt)) == std::vector<std::string>{
+            "Commit 3", "Commit 1" });
+    }
+
+    SECTION("Directory")
+    {
+        opt.paths = { "sub" };
+        REQUIRE(summaries(repo.log(opt)) == std::vector<std::string>{
+            "Commit 3", "Commit 1" });
+    }
+
+    SECTION("Several paths")
+    {
+        opt.paths = { "sub", "other.txt" };
+        REQUIRE(summaries(repo.log(opt)).size() == 5);
+    }
+
+    SECTION("Nonexistent path")
+    {
+        opt.paths = { "does/not/exist" };
+        REQUIRE(summaries(repo.log(opt)).empty());
+    }
+}
+
+TEST_CASE("CommitLog: Start revision and ranges", "[CommitLog]")
+{
+    Repository repo{ make_history() };
+
+    LogOptions opt;
+    opt.sort = LogSort::topological_time;
+
+    opt.revision = "HEAD~3";
+    REQUIRE(summaries(repo.log(opt)) == std::vector<std::string>{
+        "Commit 1", "Commit 0", "Initial commit" });
+
+    opt.revision = "HEAD~3..HEAD~1";
+    REQUIRE(summaries(repo.log(opt)) == std::vector<std::string>{
+        "Commit 3", "Commit 2" });
+
+    opt.revision = "no-such-branch";
+    REQUIRE_THROWS_AS(repo.log(opt), Error);
+}
+
+TEST_CASE("CommitLog: first_parent_only", "[CommitLog]")
+{
+    Repository repo{ make_history() };
+
+    LogOptions opt;
+    opt.first_parent_only = true;
+    REQUIRE(summaries(repo.log(opt)).size() == 6);
+}
+
+TEST_CASE("CommitLog: Path filter with merges", "[CommitLog]")
+{
+    Repository repo{ make_merge_history() };
+
+    LogOptions opt;
+    opt.sort = LogSort::topological_time;
+    opt.paths = { "sub" };
+
+    SECTION("All parents: The merge is identical to the side branch in sub")
+    {
+        REQUIRE(summaries(repo.log(opt)) == std::vector<std::string>{
+            "Side change", "Base" });
+    }
+
+    SECTION("first_parent_only: The merge brings the change onto the first-parent line")
+    {
+        opt.first_parent_only = true;
+        REQUIRE(summaries(repo.log(opt)) == std::vector<std::string>{
+            "Merge side", "Base" });
+    }
+}
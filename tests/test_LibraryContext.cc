@@ -0,0 +1,101 @@
+/**
+ * \file   test_LibraryContext.cc
+ * \date   Created on October 14, 2026
+ * \brief  Test suite for the LibraryContext class.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <filesystem>
+
+#include <git2.h>
+#include <gul14/catch.h>
+
+#include "libgit4cpp/LibraryContext.h"
+#include "libgit4cpp/Repository.h"
+#include "test_main.h"
+
+using namespace git;
+
+namespace {
+
+// Return the number of active libgit2 initializations (must only be called while
+// libgit2 is initialized, otherwise it sets up and tears down the global state).
+int init_count()
+{
+    const int count = git_libgit2_init() - 1;
+    git_libgit2_shutdown();
+    return count;
+}
+
+} // anonymous namespace
+
+TEST_CASE("LibraryContext: Reference counting", "[LibraryContext]")
+{
+    LibraryContext outer;
+    const int base = init_count();
+    REQUIRE(base >= 1);
+
+    {
+        LibraryContext inner;
+        REQUIRE(init_count() == base + 1);
+
+        LibraryContext copy{ inner };
+        REQUIRE(init_count() == base + 2);
+
+        copy = outer;
+        REQUIRE(init_count() == base + 2);
+    }
+
+    REQUIRE(init_count() == base);
+
+    {
+        Repository repo{ unit_test_folder() / "LibraryContext" };
+        REQUIRE(init_count() == base + 1);
+    }
+
+    REQUIRE(init_count() == base);
+}
+
+TEST_CASE("LibraryContext: Tuning options", "[LibraryContext]")
+{
+    LibraryContext context;
+    const auto original = context.cache_usage();
+
+    LibraryOptions opt;
+    opt.cache_max_size = 32 * 1024 * 1024;
+    opt.strict_object_creation = false;
+    context.configure(opt);
+
+    REQUIRE(context.cache_usage().max_bytes == 32 * 1024 * 1024);
+
+    // Creating commits works without strict object creation
+    {
+        Repository repo{ unit_test_folder() / "LibraryContext" };
+        repo.commit_files({ { "file.txt", "content" } }, "Commit without strict checks");
+        REQUIRE(repo.get_last_commit_message() == "Commit without strict checks");
+    }
+
+    // Restore the defaults for the other tests
+    LibraryOptions defaults;
+    defaults.cache_max_size = original.max_bytes;
+    defaults.strict_object_creation = true;
+    LibraryContext restoring{ defaults };
+
+    REQUIRE(context.cache_usage().max_bytes == original.max_bytes);
+}
@@ -0,0 +1,108 @@
+/**
+ * \file   test_Metrics.cc
+ * \date   Created on October 14, 2026
+ * \brief  Test suite for the Metrics interface and the MetricsCollector class.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+
+#include <gul14/catch.h>
+
+#include "libgit4cpp/Metrics.h"
+#include "libgit4cpp/Repository.h"
+#include "test_main.h"
+
+using namespace git;
+using namespace std::literals;
+
+TEST_CASE("LatencyHistogram", "[Metrics]")
+{
+    LatencyHistogram hist;
+    REQUIRE(hist.count == 0);
+    REQUIRE(hist.mean() == 0ns);
+
+    hist.add(500ns);  // < 1 µs
+    hist.add(1us);    // [1 µs, 2 µs)
+    hist.add(3us);    // [2 µs, 4 µs)
+    hist.add(3us);
+    hist.add(1h);     // Last bucket
+
+    REQUIRE(hist.count == 5);
+    REQUIRE(hist.buckets[0] == 1);
+    REQUIRE(hist.buckets[1] == 1);
+    REQUIRE(hist.buckets[2] == 2);
+    REQUIRE(hist.buckets[LatencyHistogram::num_buckets - 1] == 1);
+    REQUIRE(hist.max == 1h);
+    REQUIRE(hist.total == 1h + 7500ns);
+    REQUIRE(hist.mean() == (1h + 7500ns) / 5);
+}
+
+TEST_CASE("MetricsCollector", "[Metrics]")
+{
+    MetricsCollector metrics;
+    REQUIRE(metrics.get_counter("bytes") == 0);
+    REQUIRE(metrics.get_histogram("op").count == 0);
+
+    metrics.add_to_counter("bytes", 10);
+    metrics.add_to_counter("bytes", 5);
+    metrics.record_latency("op", 2ms);
+    metrics.record_latency("op", 4ms);
+
+    REQUIRE(metrics.get_counter("bytes") == 15);
+    REQUIRE(metrics.get_counters().size() == 1);
+    REQUIRE(metrics.get_histogram("op").count == 2);
+    REQUIRE(metrics.get_histogram("op").mean() == 3ms);
+    REQUIRE(metrics.get_histograms().count("op") == 1);
+
+    metrics.reset();
+    REQUIRE(metrics.get_counters().empty());
+    REQUIRE(metrics.get_histograms().empty());
+}
+
+TEST_CASE("Metrics: set_metrics()", "[Metrics]")
+{
+    const auto path = unit_test_folder() / "Metrics_set_metrics";
+    std::filesystem::remove_all(path);
+    Repository repo{ path };
+
+    REQUIRE(get_metrics() == nullptr);
+
+    MetricsCollector metrics;
+    set_metrics(&metrics);
+    REQUIRE(get_metrics() == &metrics);
+
+    repo.status_list();
+    repo.commit_files({ { "file.txt", "content"s } }, "Add file");
+
+    set_metrics(nullptr);
+    REQUIRE(get_metrics() == nullptr);
+
+    auto status = metrics.get_histogram("Repository::status_list");
+    REQUIRE(status.count == 1);
+    REQUIRE(metrics.get_histogram("git_status_list_new").count == 1);
+    REQUIRE(metrics.get_histogram("git_status_list_new").total <= status.total);
+    REQUIRE(metrics.get_histogram("Repository::commit_files").count == 1);
+
+    // Nothing is recorded after the sink has been removed
+    repo.status_list();
+    REQUIRE(metrics.get_histogram("Repository::status_list").count == 1);
+}
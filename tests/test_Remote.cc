@@ -22,8 +22,11 @@
 
 // SPDX-License-Identifier: LGPL-2.1-or-later
 
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <thread>
 
 #include <git2.h>
 #include <gul14/catch.h>
@@ -63,6 +66,22 @@ TEST_CASE("Remote: Constructor", "[Remote]")
     REQUIRE(re_ptr != nullptr);
     REQUIRE(git_remote_name(re_ptr) == "origin"s);
     REQUIRE(git_remote_url(re_ptr) == repo_url);
+
+    SECTION("Move construction and assignment")
+    {
+        Remote moved{ std::move(remote) };
+        REQUIRE(remote.get() == nullptr);
+        REQUIRE(moved.get() == re_ptr);
+        REQUIRE(moved.get_name() == "origin");
+
+        std::vector<Remote> remotes;
+        remotes.push_back(std::move(moved));
+        remotes.push_back(repo.add_remote("upstream", repo_url));
+        REQUIRE(remotes[0].get() == re_ptr);
+
+        remotes[0] = std::move(remotes[1]);
+        REQUIRE(remotes[0].get_name() == "upstream");
+    }
 }
 
 TEST_CASE("Remote: list_references()", "[Remote]")
@@ -95,14 +114,194 @@ TEST_CASE("Remote: list_references()", "[Remote]")
     // probably contains a reference for "HEAD".
     refs = remote.list_references();
     REQUIRE(refs.size() >= 1);
-    REQUIRE(std::find(refs.begin(), refs.end(), "refs/heads/main"s) != refs.end());
+    REQUIRE(refs.find("refs/heads/main").has_value());
 
     // Remove the "parent" repository and check if the remote still works
     repo.reset();
     refs = remote.list_references();
     REQUIRE(refs.size() >= 1);
-    REQUIRE(std::find(refs.begin(), refs.end(), "refs/heads/main"s) != refs.end());
+    REQUIRE(refs.find("refs/heads/main").has_value());
+
+}
+
+TEST_CASE("Remote: list_references() details and prefix filter", "[Remote]")
+{
+    const auto local_dir = unit_test_folder() / "Remote_list_references_details";
+    const auto remote_dir = unit_test_folder() / "Remote_list_references_details.remote";
+    std::filesystem::remove_all(local_dir);
+    std::filesystem::remove_all(remote_dir);
+
+    Repository repo{ local_dir };
+    repo.commit_files({ { "file.txt", "content" } }, "Add file.txt");
+
+    git_oid head_id;
+    REQUIRE(git_reference_name_to_id(&head_id, repo.get_repo(), "HEAD") == 0);
+
+    // Create an annotated tag on HEAD
+    git_object* head_obj = nullptr;
+    REQUIRE(git_object_lookup(&head_obj, repo.get_repo(), &head_id, GIT_OBJECT_COMMIT) == 0);
+    auto free_head_obj = gul14::finally([head_obj]() { git_object_free(head_obj); });
+    auto tagger = signature_new("Tagger", "tagger@example.com", 1700000000, 0);
+    git_oid tag_id;
+    REQUIRE(git_tag_create(&tag_id, repo.get_repo(), "v1.0", head_obj, tagger.get(),
+        "Release 1.0", 0) == 0);
+
+    repository_init(remote_dir, true);
+    auto remote = repo.add_remote(
+        "origin", "file://" + std::filesystem::absolute(remote_dir).string());
+    repo.push(remote);
+    repo.push(remote, "refs/tags/v1.0:refs/tags/v1.0");
+
+    SECTION("All references")
+    {
+        auto refs = remote.list_references();
+
+        auto main = refs.find("refs/heads/main");
+        REQUIRE(main.has_value());
+        REQUIRE(git_oid_equal(&main->id, &head_id));
+        REQUIRE(not main->peeled_id.has_value());
+        REQUIRE(main->symref_target.empty());
+
+        auto tag = refs.find("refs/tags/v1.0");
+        REQUIRE(tag.has_value());
+        REQUIRE(git_oid_equal(&tag->id, &tag_id));
+        REQUIRE(tag->peeled_id.has_value());
+        REQUIRE(git_oid_equal(&*tag->peeled_id, &head_id));
+        REQUIRE(git_oid_equal(&tag->target_id(), &head_id));
+
+        // The peeled entry is folded into the tag
+        REQUIRE(not refs.find("refs/tags/v1.0^{}").has_value());
+
+        const auto names = refs.names();
+        REQUIRE(names.size() == refs.size());
+        REQUIRE(std::find(names.begin(), names.end(), "refs/tags/v1.0"s) != names.end());
+    }
+
+    SECTION("Prefix filter")
+    {
+        auto branches = remote.list_references("refs/heads/");
+        REQUIRE(branches.size() == 1);
+        REQUIRE((*branches.begin()).name == "refs/heads/main");
+
+        auto tags = remote.list_references("refs/tags/");
+        REQUIRE(tags.size() == 1);
+        REQUIRE(tags[0].name == "refs/tags/v1.0");
+
+        REQUIRE(remote.list_references("refs/notes/").empty());
+    }
+}
+
+TEST_CASE("Remote: Connection lifetime", "[Remote]")
+{
+    const auto local_dir = unit_test_folder() / "Remote_connection";
+    const auto remote_dir = unit_test_folder() / "Remote_connection.remote";
+    std::filesystem::remove_all(local_dir);
+    std::filesystem::remove_all(remote_dir);
 
+    Repository repo{ local_dir };
+    repo.commit_files({ { "file.txt", "content" } }, "Add file.txt");
+    repository_init(remote_dir, true);
+    auto remote = repo.add_remote(
+        "origin", "file://" + std::filesystem::absolute(remote_dir).string());
+
+    REQUIRE(not remote.is_connected());
+    REQUIRE(remote.get_idle_timeout() == std::chrono::milliseconds{ 0 });
+
+    SECTION("Operations without connect() do not leave a connection open")
+    {
+        REQUIRE(remote.list_references().empty());
+        REQUIRE(not remote.is_connected());
+        REQUIRE(git_remote_connected(remote.get()) == 0);
+
+        repo.push(remote);
+        REQUIRE(not remote.is_connected());
+        REQUIRE(remote.list_references().find("refs/heads/main").has_value());
+    }
+
+    SECTION("Several operations over one connection")
+    {
+        remote.connect(RemoteDirection::push);
+        REQUIRE(remote.is_connected());
+
+        repo.push(remote);
+        REQUIRE(remote.is_connected());
+
+        repo.commit_files({ { "file.txt", "new content" } }, "Modify file.txt");
+        repo.push(remote);
+        REQUIRE(remote.is_connected());
+
+        // Reconnecting refreshes the advertised references
+        remote.connect();
+        REQUIRE(remote.is_connected());
+        auto main = remote.list_references().find("refs/heads/main");
+        REQUIRE(main.has_value());
+        git_oid head_id;
+        REQUIRE(git_reference_name_to_id(&head_id, repo.get_repo(), "HEAD") == 0);
+        REQUIRE(git_oid_equal(&main->id, &head_id));
+        REQUIRE(remote.is_connected());
+
+        // A push switches the connection to push direction and keeps it open
+        repo.push(remote);
+        REQUIRE(remote.is_connected());
+
+        remote.disconnect();
+        REQUIRE(not remote.is_connected());
+        REQUIRE(git_remote_connected(remote.get()) == 0);
+    }
+
+    SECTION("Idle timeout")
+    {
+        remote.set_idle_timeout(std::chrono::milliseconds{ 200 });
+        remote.connect();
+        REQUIRE(not remote.disconnect_if_idle());
+        REQUIRE(remote.is_connected());
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{ 300 });
+        REQUIRE(remote.disconnect_if_idle());
+        REQUIRE(not remote.is_connected());
+        REQUIRE(not remote.disconnect_if_idle());
+    }
+}
+
+TEST_CASE("Remote: list_references_async()", "[Remote]")
+{
+    const auto local_dir = unit_test_folder() / "Remote_async";
+    const auto remote_dir = unit_test_folder() / "Remote_async.remote";
+    std::filesystem::remove_all(local_dir);
+    std::filesystem::remove_all(remote_dir);
+
+    Repository repo{ local_dir };
+    repository_init(remote_dir, true);
+    auto remote = repo.add_remote(
+        "origin", "file://" + std::filesystem::absolute(remote_dir).string());
+    repo.push(remote);
+
+    SECTION("Successful listing")
+    {
+        auto future = remote.list_references_async("refs/heads/");
+        auto refs = future.get();
+        REQUIRE(refs.size() == 1);
+        REQUIRE(refs.find("refs/heads/main").has_value());
+        REQUIRE(not remote.is_connected());
+    }
+
+    SECTION("Cancelled listing")
+    {
+        CancellationToken token;
+        token.cancel();
+        REQUIRE(token.is_cancelled());
+
+        auto future = remote.list_references_async("", token);
+        try
+        {
+            future.get();
+            FAIL("list_references_async() did not throw");
+        }
+        catch (const Error& e)
+        {
+            REQUIRE(e.code().value() == GIT_EUSER);
+        }
+    }
 }
 
 TEST_CASE("wrapper_functions: branch_remote_name()", "[Remote]")
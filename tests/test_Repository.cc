@@ -22,9 +22,11 @@
 
 // SPDX-License-Identifier: LGPL-2.1-or-later
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <type_traits>
 
 #include <git2.h>
 #include <gul14/catch.h>
@@ -72,6 +74,13 @@ void create_testfiles(const std::filesystem::path& name, size_t nr_files,
     }
 }
 
+git_oid get_commit_id(Repository& repo, const std::string& ref)
+{
+    git_oid id;
+    REQUIRE(git_reference_name_to_id(&id, repo.get_repo(), ref.c_str()) == 0);
+    return id;
+}
+
 } // anonymous namespace
 
 TEST_CASE("Repository Wrapper Test all", "[Repository]")
@@ -700,7 +709,7 @@ TEST_CASE("Repository: push()", "[Repository]")
     // probably contains a reference for "HEAD".
     refs = remote.list_references();
     REQUIRE(refs.size() >= 1);
-    REQUIRE(std::find(refs.begin(), refs.end(), "refs/heads/main"s) != refs.end());
+    REQUIRE(refs.find("refs/heads/main").has_value());
 }
 
 TEST_CASE("Repository: checkout new branch", "[Repository]")
@@ -839,6 +848,1438 @@ TEST_CASE("Repository: partially checkout other branch", "[Repository]")
 
 }
 
+TEST_CASE("Repository: switch_branch() with CheckoutOptions", "[Repository]")
+{
+    std::filesystem::remove_all(reporoot);
+
+    auto write_file = [](const std::string& name, const std::string& content) {
+        std::ofstream f(reporoot / name);
+        f << content;
+    };
+    auto read_file = [](const std::string& name) {
+        std::ifstream f(reporoot / name);
+        return std::string{ std::istreambuf_iterator<char>(f), { } };
+    };
+
+    Repository repo{ reporoot };
+    write_file("a.txt", "a");
+    write_file("b.txt", "b");
+    repo.add();
+    repo.commit("Base");
+
+    repo.new_branch("other");
+    repo.switch_branch("other");
+    write_file("b.txt", "b2");
+    repo.add();
+    repo.commit("Change b.txt");
+
+    std::vector<std::string> updated;
+    std::vector<std::string> conflicts;
+    CheckoutOptions opt;
+    opt.on_notify = [&](CheckoutNotification n, gul14::string_view path) {
+        if (n == CheckoutNotification::updated)
+            updated.emplace_back(path);
+        else if (n == CheckoutNotification::conflict)
+            conflicts.emplace_back(path);
+        return true;
+    };
+
+    SECTION("Only the files that differ are written")
+    {
+        repo.switch_branch("main", opt);
+        REQUIRE(repo.get_current_branch_name() == "main");
+        REQUIRE(updated == std::vector<std::string>{ "b.txt" });
+        REQUIRE(read_file("b.txt") == "b");
+    }
+
+    SECTION("Unrelated local modifications are carried over")
+    {
+        write_file("a.txt", "local");
+        repo.switch_branch("main", opt);
+        REQUIRE(repo.get_current_branch_name() == "main");
+        REQUIRE(read_file("a.txt") == "local");
+        REQUIRE(read_file("b.txt") == "b");
+    }
+
+    SECTION("Conflicting local modifications")
+    {
+        write_file("b.txt", "local");
+        try
+        {
+            repo.switch_branch("main", opt);
+            FAIL("switch_branch() did not throw");
+        }
+        catch (const Error& e)
+        {
+            REQUIRE(e.code().value() == GIT_ECONFLICT);
+        }
+        REQUIRE(conflicts == std::vector<std::string>{ "b.txt" });
+        REQUIRE(repo.get_current_branch_name() == "other");
+        REQUIRE(read_file("b.txt") == "local");
+
+        // Forced checkout discards the local modifications
+        opt.mode = CheckoutMode::force;
+        repo.switch_branch("main", opt);
+        REQUIRE(repo.get_current_branch_name() == "main");
+        REQUIRE(read_file("b.txt") == "b");
+    }
+
+    SECTION("Cancellation by the notify callback")
+    {
+        opt.on_notify = [](CheckoutNotification, gul14::string_view) { return false; };
+        try
+        {
+            repo.switch_branch("main", opt);
+            FAIL("switch_branch() did not throw");
+        }
+        catch (const Error& e)
+        {
+            REQUIRE(e.code().value() == GIT_EUSER);
+        }
+        REQUIRE(repo.get_current_branch_name() == "other");
+        REQUIRE(read_file("b.txt") == "b2");
+    }
+
+    SECTION("checkout() in safe mode does not move HEAD")
+    {
+        repo.checkout("main", opt);
+        REQUIRE(repo.get_current_branch_name() == "other");
+        REQUIRE(updated == std::vector<std::string>{ "b.txt" });
+        REQUIRE(read_file("b.txt") == "b");
+    }
+}
+
+TEST_CASE("Repository: list_tree() and lookup_path()", "[Repository]")
+{
+    std::filesystem::remove_all(reporoot);
+
+    Repository repo{ reporoot };
+    repo.commit_files({ { "a.txt", "a"s }, { "dir/b.txt", "b"s },
+        { "dir/sub/c.txt", "c"s } }, "Add files");
+    repo.commit_files({ { "dir/d.txt", "d"s } }, "Add d.txt");
+
+    SECTION("Root directory")
+    {
+        auto entries = repo.list_tree("HEAD");
+        REQUIRE(entries.size() == 2);
+        REQUIRE(entries[0].path == "a.txt");
+        REQUIRE(entries[0].type == TreeEntryType::file);
+        REQUIRE(entries[1].path == "dir");
+        REQUIRE(entries[1].is_directory());
+    }
+
+    SECTION("Subdirectory at different revisions")
+    {
+        auto entries = repo.list_tree("HEAD", "dir/");
+        REQUIRE(entries.size() == 3);
+        REQUIRE(entries[0].path == "dir/b.txt");
+        REQUIRE(entries[1].path == "dir/d.txt");
+        REQUIRE(entries[1].name() == "d.txt");
+        REQUIRE(entries[2].path == "dir/sub");
+
+        REQUIRE(repo.list_tree("HEAD~1", "dir").size() == 2);
+    }
+
+    SECTION("Recursive listing")
+    {
+        auto entries = repo.list_tree("HEAD", "", true);
+        std::vector<std::string> paths;
+        for (const auto& entry : entries)
+            paths.push_back(entry.path);
+
+        REQUIRE(paths == std::vector<std::string>{ "a.txt", "dir", "dir/b.txt",
+            "dir/d.txt", "dir/sub", "dir/sub/c.txt" });
+    }
+
+    SECTION("Invalid directories throw")
+    {
+        REQUIRE_THROWS_AS(repo.list_tree("HEAD", "does_not_exist"), Error);
+        REQUIRE_THROWS_AS(repo.list_tree("HEAD", "a.txt"), Error);
+        REQUIRE_THROWS_AS(repo.list_tree("no_such_revision"), Error);
+    }
+
+    SECTION("lookup_path()")
+    {
+        auto entry = repo.lookup_path("HEAD", "dir/sub/c.txt");
+        REQUIRE(entry.has_value());
+        REQUIRE(entry->path == "dir/sub/c.txt");
+        REQUIRE(entry->type == TreeEntryType::file);
+        REQUIRE(git_oid_equal(&entry->id, &repo.read_blob("HEAD", "dir/sub/c.txt").id()));
+
+        auto dir = repo.lookup_path("HEAD", "dir/sub");
+        REQUIRE(dir.has_value());
+        REQUIRE(dir->is_directory());
+
+        // Entries of a listed directory have the same IDs as looked-up ones
+        REQUIRE(git_oid_equal(&dir->id, &repo.list_tree("HEAD", "dir")[2].id));
+
+        REQUIRE(repo.lookup_path("HEAD", "a.txt").has_value());
+        REQUIRE(not repo.lookup_path("HEAD~1", "dir/d.txt").has_value());
+        REQUIRE(not repo.lookup_path("HEAD", "dir/nope.txt").has_value());
+        REQUIRE(not repo.lookup_path("HEAD", "a.txt/x").has_value());
+        REQUIRE(not repo.lookup_path("HEAD", "nope/x").has_value());
+    }
+
+    SECTION("reset_repo() drops cached trees")
+    {
+        REQUIRE(repo.list_tree("HEAD", "dir").size() == 3);
+
+        repo.reset_repo();
+
+        auto entries = repo.list_tree("HEAD", "dir");
+        REQUIRE(entries.size() == 3);
+        REQUIRE(entries[0].path == "dir/b.txt");
+        REQUIRE(repo.lookup_path("HEAD", "dir/sub/c.txt").has_value());
+    }
+}
+
+TEST_CASE("Repository: diff()", "[Repository]")
+{
+    std::filesystem::remove_all(reporoot);
+
+    Repository repo{ reporoot };
+    repo.commit_files({ { "a.txt", "1\n2\n3\n"s }, { "b.txt", "b\n"s } }, "Base");
+    repo.commit_files({ { "a.txt", "1\nX\n3\n4\n"s }, { "b.txt", gul14::nullopt },
+        { "c.txt", "c\n"s } }, "Change");
+
+    SECTION("Name and status only")
+    {
+        auto result = repo.diff("HEAD~1", "HEAD");
+        REQUIRE(result.deltas.size() == 3);
+        REQUIRE(result.deltas[0].new_path == "a.txt");
+        REQUIRE(result.deltas[0].change == FileChange::modified);
+        REQUIRE(result.deltas[1].old_path == "b.txt");
+        REQUIRE(result.deltas[1].change == FileChange::deleted);
+        REQUIRE(result.deltas[2].new_path == "c.txt");
+        REQUIRE(result.deltas[2].change == FileChange::new_file);
+        REQUIRE(result.stats.files_changed == 3);
+        REQUIRE(result.stats.insertions == 0);
+        REQUIRE(result.stats.deletions == 0);
+
+        REQUIRE(not git_oid_equal(&result.deltas[0].old_id, &result.deltas[0].new_id));
+
+        std::stringstream ss;
+        ss << result.deltas[0];
+        REQUIRE(ss.str() == "DiffDelta{ \"a.txt\": modified }");
+    }
+
+    SECTION("Path filter")
+    {
+        DiffOptions opt;
+        opt.paths = { "a.*" };
+        auto result = repo.diff("HEAD~1", "HEAD", opt);
+        REQUIRE(result.deltas.size() == 1);
+        REQUIRE(result.deltas[0].new_path == "a.txt");
+    }
+
+    SECTION("Streamed patch")
+    {
+        std::size_t nr_hunks = 0;
+        std::string patch;
+        DiffOptions opt;
+        opt.mode = DiffMode::patch;
+        opt.on_hunk = [&nr_hunks](const DiffDelta&, const DiffHunk& hunk) {
+            REQUIRE(gul14::starts_with(hunk.header, "@@"));
+            ++nr_hunks;
+            return true;
+        };
+        opt.on_line = [&patch](const DiffDelta& delta, const DiffHunk&, const DiffLine& line) {
+            if (delta.new_path == "a.txt")
+                patch += cat(line.origin, line.content);
+            return true;
+        };
+
+        auto result = repo.diff("HEAD~1", "HEAD", opt);
+        REQUIRE(result.deltas.size() == 3);
+        REQUIRE(nr_hunks == 3);
+        REQUIRE(patch == " 1\n-2\n+X\n 3\n+4\n");
+        REQUIRE(result.deltas[0].additions == 2);
+        REQUIRE(result.deltas[0].deletions == 1);
+        REQUIRE(result.stats.insertions == 3);
+        REQUIRE(result.stats.deletions == 2);
+    }
+
+    SECTION("Stopping the patch early")
+    {
+        DiffOptions opt;
+        opt.mode = DiffMode::patch;
+        opt.on_line = [](const DiffDelta&, const DiffHunk&, const DiffLine&) {
+            return false;
+        };
+        auto result = repo.diff("HEAD~1", "HEAD", opt);
+        REQUIRE(result.deltas.size() == 1);
+    }
+
+    SECTION("Exact renames")
+    {
+        repo.commit_files({ { "c.txt", gul14::nullopt }, { "d.txt", "c\n"s } }, "Rename");
+
+        DiffOptions opt;
+        opt.detect_renames = true;
+        auto result = repo.diff("HEAD~1", "HEAD", opt);
+        REQUIRE(result.deltas.size() == 1);
+        REQUIRE(result.deltas[0].change == FileChange::renamed);
+        REQUIRE(result.deltas[0].old_path == "c.txt");
+        REQUIRE(result.deltas[0].new_path == "d.txt");
+    }
+
+    SECTION("Unknown revision")
+    {
+        REQUIRE_THROWS_AS(repo.diff("HEAD", "no_such_branch"), Error);
+    }
+}
+
+TEST_CASE("Repository: diff_index() and diff_workdir()", "[Repository]")
+{
+    std::filesystem::remove_all(reporoot);
+    create_testfiles("diff_test", 2, "content");
+
+    Repository repo{ reporoot };
+    repo.add();
+    repo.commit("Add files");
+    REQUIRE(repo.diff_index().deltas.empty());
+    REQUIRE(repo.diff_workdir().deltas.empty());
+
+    create_testfiles("diff_test", 1, "modified");
+    {
+        std::ofstream f(reporoot / "untracked.txt");
+        f << "untracked";
+    }
+
+    auto unstaged = repo.diff_workdir();
+    REQUIRE(unstaged.deltas.size() == 1);
+    REQUIRE(unstaged.deltas[0].new_path == "diff_test/file0.txt");
+    REQUIRE(unstaged.deltas[0].change == FileChange::modified);
+    REQUIRE(repo.diff_index().deltas.empty());
+
+    DiffOptions opt;
+    opt.include_untracked = true;
+    unstaged = repo.diff_workdir(opt);
+    REQUIRE(unstaged.deltas.size() == 2);
+    REQUIRE(unstaged.deltas[1].new_path == "untracked.txt");
+    REQUIRE(unstaged.deltas[1].change == FileChange::untracked);
+
+    repo.add_files({ "diff_test/file0.txt" });
+    auto staged = repo.diff_index();
+    REQUIRE(staged.deltas.size() == 1);
+    REQUIRE(staged.deltas[0].new_path == "diff_test/file0.txt");
+    REQUIRE(repo.diff_workdir().deltas.empty());
+}
+
+TEST_CASE("Repository: ReferenceTransaction", "[Repository]")
+{
+    std::filesystem::remove_all(reporoot);
+
+    Repository repo{ reporoot };
+    repo.commit_files({ { "file.txt", "content"s } }, "Add file.txt");
+    const auto head = get_commit_id(repo, "HEAD");
+    const auto parent = get_commit_id(repo, "HEAD~1");
+
+    SECTION("Create many branches and pack them")
+    {
+        Repository::ReferenceTransaction transaction{ repo };
+        for (int i = 0; i != 50; ++i)
+            transaction.create_branch(cat("branch", i), "main");
+        REQUIRE(transaction.size() == 50);
+
+        // Nothing is written before the commit
+        REQUIRE(repo.list_branches(BranchType::local).size() == 1);
+
+        transaction.commit(true);
+        REQUIRE(repo.list_branches(BranchType::local).size() == 51);
+        REQUIRE(std::filesystem::exists(reporoot / ".git" / "packed-refs"));
+        REQUIRE(not std::filesystem::exists(reporoot / ".git" / "refs" / "heads" / "branch0"));
+
+        auto id = get_commit_id(repo, "refs/heads/branch49");
+        REQUIRE(git_oid_equal(&id, &head));
+
+        REQUIRE_THROWS_AS(transaction.create_branch("late"), Error);
+    }
+
+    SECTION("Update, remove, and symbolic references")
+    {
+        repo.new_branch("obsolete");
+        {
+            Repository::ReferenceTransaction transaction{ repo };
+            transaction.set_target("refs/heads/old", "HEAD~1");
+            transaction.set_target("refs/tags/v1", head, "Tag v1");
+            transaction.remove("refs/heads/obsolete");
+            transaction.set_symbolic_target("refs/heads/alias", "refs/heads/main");
+        } // committed here
+
+        auto old_id = get_commit_id(repo, "refs/heads/old");
+        REQUIRE(git_oid_equal(&old_id, &parent));
+        auto tag_id = get_commit_id(repo, "refs/tags/v1");
+        REQUIRE(git_oid_equal(&tag_id, &head));
+        auto alias_id = get_commit_id(repo, "refs/heads/alias");
+        REQUIRE(git_oid_equal(&alias_id, &head));
+        git_oid id;
+        REQUIRE(git_reference_name_to_id(&id, repo.get_repo(), "refs/heads/obsolete")
+            == GIT_ENOTFOUND);
+    }
+
+    SECTION("Existing branches")
+    {
+        repo.new_branch("existing");
+
+        Repository::ReferenceTransaction transaction{ repo };
+        try
+        {
+            transaction.create_branch("existing", "HEAD~1");
+            FAIL("create_branch() did not throw");
+        }
+        catch (const Error& e)
+        {
+            REQUIRE(e.code().value() == GIT_EEXISTS);
+        }
+
+        transaction.create_branch("existing", "HEAD~1", true);
+        transaction.commit();
+        auto id = get_commit_id(repo, "refs/heads/existing");
+        REQUIRE(git_oid_equal(&id, &parent));
+    }
+
+    SECTION("Rollback")
+    {
+        {
+            Repository::ReferenceTransaction transaction{ repo };
+            transaction.create_branch("discarded");
+            transaction.rollback();
+        }
+
+        try
+        {
+            Repository::ReferenceTransaction transaction{ repo };
+            transaction.create_branch("discarded");
+            throw std::runtime_error("abort");
+        }
+        catch (const std::runtime_error&)
+        { }
+
+        git_oid id;
+        REQUIRE(git_reference_name_to_id(&id, repo.get_repo(), "refs/heads/discarded")
+            == GIT_ENOTFOUND);
+
+        // The locks have been released
+        Repository::ReferenceTransaction transaction{ repo };
+        transaction.create_branch("discarded");
+        transaction.commit();
+        REQUIRE(git_reference_name_to_id(&id, repo.get_repo(), "refs/heads/discarded") == 0);
+    }
+}
+
+TEST_CASE("Repository: ahead_behind() and ahead_behind_all()", "[Repository]")
+{
+    std::filesystem::remove_all(reporoot);
+
+    Repository repo{ reporoot };
+    repo.commit_files({ { "file.txt", "1"s } }, "Commit 1");
+    repo.commit_files({ { "file.txt", "2"s } }, "Commit 2");
+    repo.add_remote("origin", "file:///nonexistent");
+
+    {
+        Repository::ReferenceTransaction transaction{ repo };
+        transaction.set_target("refs/remotes/origin/main", "HEAD~1");
+        transaction.create_branch("copy", "main");
+        transaction.create_branch("feature", "HEAD~2");
+    }
+
+    for (const char* branch : { "main", "copy" })
+    {
+        auto ref = branch_lookup(repo.get_repo(), branch, GIT_BRANCH_LOCAL);
+        REQUIRE(ref != nullptr);
+        REQUIRE(git_branch_set_upstream(ref.get(), "origin/main") == 0);
+    }
+
+    SECTION("ahead_behind()")
+    {
+        auto counts = repo.ahead_behind("main");
+        REQUIRE(counts.ahead == 1);
+        REQUIRE(counts.behind == 0);
+        REQUIRE(not counts.up_to_date());
+
+        REQUIRE(repo.ahead_behind("HEAD").ahead == 1);
+        REQUIRE(repo.ahead_behind("main", "copy").up_to_date());
+
+        counts = repo.ahead_behind("feature", "main");
+        REQUIRE(counts.ahead == 0);
+        REQUIRE(counts.behind == 2);
+
+        REQUIRE_THROWS_AS(repo.ahead_behind("feature"), Error);
+        REQUIRE_THROWS_AS(repo.ahead_behind("main", "no_such_branch"), Error);
+    }
+
+    SECTION("ahead_behind_all()")
+    {
+        auto all = repo.ahead_behind_all();
+        REQUIRE(all.size() == 3);
+
+        std::sort(all.begin(), all.end(), [](const BranchTracking& a, const BranchTracking& b)
+            { return a.branch < b.branch; });
+
+        REQUIRE(all[0].branch == "refs/heads/copy");
+        REQUIRE(all[0].upstream == "refs/remotes/origin/main");
+        REQUIRE(all[0].counts.ahead == 1);
+        REQUIRE(all[0].counts.behind == 0);
+
+        REQUIRE(all[1].branch == "refs/heads/feature");
+        REQUIRE(not all[1].has_upstream());
+        REQUIRE(all[1].counts.up_to_date());
+
+        REQUIRE(all[2].branch == "refs/heads/main");
+        REQUIRE(all[2].has_upstream());
+        REQUIRE(all[2].counts.ahead == 1);
+        auto head = get_commit_id(repo, "HEAD");
+        REQUIRE(git_oid_equal(&all[2].local_id, &head));
+    }
+}
+
+TEST_CASE("Repository: repack()", "[Repository]")
+{
+    std::filesystem::remove_all(reporoot);
+
+    Repository repo{ reporoot };
+    for (int i = 0; i != 5; ++i)
+        repo.commit_files({ { "file.txt", gul14::cat("version ", i) } }, "Modify");
+
+    const auto objects_dir = reporoot / ".git" / "objects";
+    auto count_loose = [&objects_dir]()
+        {
+            int n = 0;
+            for (const auto& dir : std::filesystem::directory_iterator{ objects_dir })
+            {
+                if (dir.path().filename().string().size() == 2)
+                {
+                    n += std::distance(std::filesystem::directory_iterator{ dir },
+                        std::filesystem::directory_iterator{ });
+                }
+            }
+            return n;
+        };
+
+    const auto nr_loose = count_loose();
+    REQUIRE(nr_loose > 0);
+
+    SECTION("Loose objects are packed and removed")
+    {
+        bool stages[3] = { false, false, false };
+        RepackOptions opt;
+        opt.on_progress = [&stages](RepackStage stage, std::size_t, std::size_t)
+            {
+                stages[static_cast<int>(stage)] = true;
+                return true;
+            };
+
+        auto result = repo.repack(opt);
+        REQUIRE(result.objects_packed == static_cast<std::size_t>(nr_loose));
+        REQUIRE(result.loose_objects_removed == static_cast<std::size_t>(nr_loose));
+        REQUIRE(std::filesystem::exists(objects_dir / "pack" / result.pack_name));
+        REQUIRE(count_loose() == 0);
+        REQUIRE(stages[static_cast<int>(RepackStage::indexing)]);
+
+        // Objects are still readable from the pack
+        REQUIRE(repo.read_blob("HEAD", "file.txt").data() == "version 4");
+        REQUIRE(repo.read_blob("HEAD~4", "file.txt").data() == "version 0");
+        REQUIRE(repo.get_last_commit_message() == "Modify");
+
+        // New commits work as usual, and there is nothing to do after repacking
+        repo.commit_files({ { "file.txt", "version 5"s } }, "Modify again");
+        REQUIRE(repo.repack().objects_packed > 0);
+        result = repo.repack();
+        REQUIRE(result.objects_packed == 0);
+        REQUIRE(result.pack_name.empty());
+    }
+
+    SECTION("Keep loose objects")
+    {
+        RepackOptions opt;
+        opt.prune_loose = false;
+        auto result = repo.repack(opt);
+        REQUIRE(result.objects_packed == static_cast<std::size_t>(nr_loose));
+        REQUIRE(result.loose_objects_removed == 0);
+        REQUIRE(count_loose() == nr_loose);
+    }
+
+    SECTION("Cancellation")
+    {
+        RepackOptions opt;
+        opt.on_progress = [](RepackStage, std::size_t, std::size_t) { return false; };
+        try
+        {
+            repo.repack(opt);
+            FAIL("No exception thrown");
+        }
+        catch (const Error& e)
+        {
+            REQUIRE(e.code().value() == GIT_EUSER);
+        }
+        REQUIRE(count_loose() == nr_loose);
+    }
+}
+
+TEST_CASE("Repository: status() with StatusOptions", "[Repository]")
+{
+    std::filesystem::remove_all(reporoot);
+    create_testfiles("status_options", 2, "committed");
+    Repository repo{ reporoot };
+    repo.add();
+    repo.commit("Add files");
+
+    create_testfiles("status_options", 1, "modified");
+    create_testfiles("status_options_new", 1, "untracked");
+    std::ofstream(reporoot / ".gitignore") << "*.ignored\n";
+    std::ofstream(reporoot / "file.ignored") << "ignored";
+
+    SECTION("Default options report everything")
+    {
+        auto all = repo.status();
+        REQUIRE(all.size() == 5);
+        REQUIRE(repo.status(StatusOptions{ }).size() == 5);
+    }
+
+    SECTION("Only changed files")
+    {
+        StatusOptions opt;
+        opt.include_unmodified = false;
+        opt.include_ignored = false;
+
+        auto changes = repo.status_list(opt);
+        REQUIRE(changes.size() == 3);
+        for (const auto& entry : changes)
+        {
+            REQUIRE(entry.handling != FileHandling::unchanged);
+            REQUIRE(entry.handling != FileHandling::ignored);
+        }
+    }
+
+    SECTION("Pathspecs")
+    {
+        StatusOptions opt;
+        opt.pathspecs = { "status_options/*" };
+
+        auto state = repo.status(opt);
+        REQUIRE(state.size() == 2);
+        REQUIRE(state[0].path_name == "status_options/file0.txt");
+        REQUIRE(state[0].handling == "unstaged");
+        REQUIRE(state[1].path_name == "status_options/file1.txt");
+        REQUIRE(state[1].handling == "unchanged");
+
+        opt.pathspecs = { "status_options/file*.txt" };
+        opt.disable_pathspec_match = true;
+        REQUIRE(repo.status(opt).empty());
+    }
+}
+
+TEST_CASE("Repository: for_each_status()", "[Repository]")
+{
+    std::filesystem::remove_all(reporoot);
+    create_testfiles("for_each_status", 3, "committed");
+    Repository repo{ reporoot };
+    repo.add();
+    repo.commit("Add files");
+    create_testfiles("for_each_status", 1, "modified");
+
+    const auto list = repo.status_list();
+
+    std::size_t idx = 0;
+    auto nr_visited = repo.for_each_status([&](const FileStatusView& entry) {
+            REQUIRE(idx < list.size());
+            REQUIRE(entry.path == list[idx].path);
+            REQUIRE(entry.handling == list[idx].handling);
+            REQUIRE(entry.changes == list[idx].changes);
+            ++idx;
+            return true;
+        });
+    REQUIRE(nr_visited == 3);
+    REQUIRE(idx == 3);
+
+    // Returning false stops the enumeration
+    nr_visited = repo.for_each_status([](const FileStatusView&) { return false; });
+    REQUIRE(nr_visited == 1);
+
+    // Options are respected
+    StatusOptions opt;
+    opt.include_unmodified = false;
+    std::vector<std::string> paths;
+    repo.for_each_status([&paths](const FileStatusView& entry) {
+            paths.emplace_back(entry.path);
+            return true;
+        }, opt);
+    REQUIRE(paths == std::vector<std::string>{ "for_each_status/file0.txt" });
+}
+
+TEST_CASE("Repository: HEAD cache follows changes", "[Repository]")
+{
+    std::filesystem::remove_all(reporoot);
+    Repository repo{ reporoot };
+    REQUIRE(repo.get_last_commit_message() == "Initial commit");
+
+    // Own commits
+    for (int i = 0; i != 3; ++i)
+    {
+        create_testfiles("head_cache", 1, cat("version ", i));
+        repo.add();
+        repo.commit(cat("Commit ", i));
+        REQUIRE(repo.get_last_commit_message() == cat("Commit ", i));
+    }
+
+    // Commits by another object (e.g. another process) are noticed immediately
+    {
+        Repository other{ reporoot };
+        other.commit_files({ { "other.txt", "other"s } }, "Commit by other");
+    }
+    REQUIRE(repo.get_last_commit_message() == "Commit by other");
+
+    // reset() and switch_branch() move HEAD
+    repo.reset(1);
+    REQUIRE(repo.get_last_commit_message() == "Commit 2");
+    repo.new_branch("side");
+    repo.commit_files({ { "main.txt", "main"s } }, "Commit on main");
+    repo.switch_branch("side");
+    REQUIRE(repo.get_last_commit_message() == "Commit 2");
+    repo.switch_branch("main");
+    REQUIRE(repo.get_last_commit_message() == "Commit on main");
+}
+
+TEST_CASE("Repository: commit_files()", "[Repository]")
+{
+    std::filesystem::remove_all(reporoot);
+    create_testfiles("commit_files", 2, "from disk");
+    Repository repo{ reporoot };
+    repo.add();
+    repo.commit("Add files from disk");
+
+    auto read_file = [](const std::filesystem::path& path) {
+        std::ifstream f(reporoot / path);
+        return std::string{ std::istreambuf_iterator<char>(f), { } };
+    };
+
+    auto id = repo.commit_files({
+            { "commit_files/file0.txt", "overwritten"s },
+            { "commit_files/file1.txt", gul14::nullopt },
+            { "new/deep/dir/file.txt", "new file"s },
+            { "top.txt", "top level"s },
+        }, "Commit from memory");
+
+    REQUIRE(repo.get_last_commit_message() == "Commit from memory");
+    auto head = get_commit_id(repo, "HEAD");
+    REQUIRE(git_oid_equal(&id, &head));
+
+    // The work tree has not been touched
+    REQUIRE(read_file("commit_files/file0.txt") == "from disk\nfile0");
+    REQUIRE(not std::filesystem::exists(reporoot / "top.txt"));
+
+    // After a hard reset, the work tree reflects the commit
+    repo.reset(0);
+    REQUIRE(read_file("commit_files/file0.txt") == "overwritten");
+    REQUIRE(not std::filesystem::exists(reporoot / "commit_files" / "file1.txt"));
+    REQUIRE(read_file("new/deep/dir/file.txt") == "new file");
+    REQUIRE(read_file("top.txt") == "top level");
+
+    // Removing the last file of a directory removes the directory
+    repo.commit_files({ { "new/deep/dir/file.txt", gul14::nullopt } }, "Remove dir");
+    git_object* obj = nullptr;
+    REQUIRE(git_revparse_single(&obj, repo.get_repo(), "HEAD:new") == GIT_ENOTFOUND);
+    REQUIRE(git_revparse_single(&obj, repo.get_repo(), "HEAD:top.txt") == 0);
+    git_object_free(obj);
+
+    // Invalid paths
+    REQUIRE_THROWS_AS(repo.commit_files({ { "/abs.txt", "x"s } }, "x"), Error);
+    REQUIRE_THROWS_AS(repo.commit_files({ { "a/../b.txt", "x"s } }, "x"), Error);
+    REQUIRE_THROWS_AS(repo.commit_files({ { "a//b.txt", "x"s } }, "x"), Error);
+    REQUIRE_THROWS_AS(repo.commit_files({ { "dir/", "x"s } }, "x"), Error);
+    REQUIRE(repo.get_last_commit_message() == "Remove dir");
+}
+
+TEST_CASE("Repository: commit_batch()", "[Repository]")
+{
+    std::filesystem::remove_all(reporoot);
+    Repository repo{ reporoot };
+    repo.commit_files({ { "keep.txt", "keep"s }, { "log.txt", "0\n"s } }, "Base");
+    const auto base = get_commit_id(repo, "HEAD");
+
+    SECTION("Linear chain")
+    {
+        std::vector<BatchCommit> batch;
+        std::string log = "0\n";
+        for (int i = 1; i <= 5; ++i)
+        {
+            log += gul14::cat(i, "\n");
+            batch.push_back({ { { "log.txt", log } }, gul14::cat("Event ", i) });
+        }
+        batch.push_back({ { { "keep.txt", gul14::nullopt }, { "dir/new.txt", "new"s } },
+            "Last event\n\nWith details" });
+
+        auto ids = repo.commit_batch(batch);
+        REQUIRE(ids.size() == 6);
+
+        auto head = get_commit_id(repo, "HEAD");
+        REQUIRE(git_oid_equal(&ids.back(), &head));
+        REQUIRE(repo.get_last_commit_message() == "Last event\n\nWith details");
+
+        // Each commit is the parent of the next one
+        for (std::size_t i = 0; i != ids.size(); ++i)
+        {
+            auto parent = get_commit_id(repo, gul14::cat("HEAD~", ids.size() - i));
+            auto expected = i == 0 ? base : ids[i - 1];
+            REQUIRE(git_oid_equal(&parent, &expected));
+        }
+
+        REQUIRE(repo.read_blob("HEAD~3", "log.txt").data() == "0\n1\n2\n3\n");
+        REQUIRE(repo.read_blob("HEAD", "log.txt").data() == "0\n1\n2\n3\n4\n5\n");
+        REQUIRE(repo.read_blob("HEAD", "dir/new.txt").data() == "new");
+        REQUIRE(not repo.lookup_path("HEAD", "keep.txt").has_value());
+
+        // The index matches the last commit for all changed paths
+        REQUIRE(repo.diff_index().deltas.empty());
+    }
+
+    SECTION("Without index update")
+    {
+        repo.commit_batch({ { { { "log.txt", "changed"s } }, "Change" } }, false);
+        REQUIRE(repo.get_last_commit_message() == "Change");
+        REQUIRE(not repo.diff_index().deltas.empty());
+    }
+
+    SECTION("Empty batch")
+    {
+        REQUIRE(repo.commit_batch({ }).empty());
+        auto head = get_commit_id(repo, "HEAD");
+        REQUIRE(git_oid_equal(&head, &base));
+    }
+
+    SECTION("A file that a later commit turns into a directory")
+    {
+        repo.commit_batch({ { { { "a", "file"s } }, "Add file a" },
+            { { { "a/b", "file below a"s } }, "Replace a by a directory" } });
+
+        REQUIRE(repo.get_last_commit_message() == "Replace a by a directory");
+        auto a = repo.lookup_path("HEAD", "a");
+        REQUIRE(a.has_value());
+        REQUIRE(a->is_directory());
+        REQUIRE(repo.read_blob("HEAD", "a/b").data() == "file below a");
+
+        // The index has an entry for a/b, but none for a
+        REQUIRE(repo.diff_index().deltas.empty());
+    }
+
+    SECTION("Invalid paths leave HEAD unchanged")
+    {
+        REQUIRE_THROWS_AS(repo.commit_batch({ { { { "ok.txt", "x"s } }, "OK" },
+            { { { "a//b.txt", "x"s } }, "Invalid" } }), Error);
+        auto head = get_commit_id(repo, "HEAD");
+        REQUIRE(git_oid_equal(&head, &base));
+    }
+}
+
+TEST_CASE("Repository: add_files() with several threads", "[Repository]")
+{
+    std::filesystem::remove_all(reporoot);
+    Repository repo{ reporoot };
+    create_testfiles("parallel", 40, "parallel staging");
+    std::filesystem::create_directories(reporoot / "parallel" / "subdir");
+
+    std::vector<std::filesystem::path> files;
+    for (int i = 0; i != 40; ++i)
+        files.push_back(std::filesystem::path{ "parallel" } / cat("file", i, ".txt"));
+    files.push_back("parallel/does_not_exist.txt");            // index 40
+    files.push_back("parallel/subdir");                        // index 41
+    files.push_back(std::filesystem::absolute(reporoot / "parallel" / "file0.txt"));
+
+    auto errors = repo.add_files(files, 4);
+    REQUIRE(errors == std::vector<int>{ 40, 41 });
+
+    std::size_t nr_staged = 0;
+    repo.for_each_status([&nr_staged](const FileStatusView& entry) {
+            if (entry.handling == FileHandling::staged)
+            {
+                REQUIRE(entry.changes == FileChange::new_file);
+                ++nr_staged;
+            }
+            return true;
+        });
+    REQUIRE(nr_staged == 40);
+
+    // The staged blobs must match the work tree
+    StatusOptions opt;
+    opt.include_untracked = false;
+    opt.include_unmodified = false;
+    repo.commit("Add files in parallel");
+    REQUIRE(repo.is_dirty(opt) == false);
+
+    // Modified files are updated
+    create_testfiles("parallel", 2, "modified");
+    errors = repo.add_files({ "parallel/file0.txt", "parallel/file1.txt" }, 0);
+    REQUIRE(errors.empty());
+    REQUIRE(repo.status(opt).size() == 2);
+}
+
+TEST_CASE("Repository: IndexTransaction", "[Repository]")
+{
+    std::filesystem::remove_all(reporoot);
+    Repository repo{ reporoot };
+    create_testfiles("index_transaction", 3, "content");
+
+    // Count the staged files as seen by a second Repository that reads the index file
+    auto count_staged_on_disk = []() {
+        Repository other{ reporoot };
+        std::size_t count = 0;
+        other.for_each_status([&count](const FileStatusView& entry) {
+                if (entry.handling == FileHandling::staged)
+                    ++count;
+                return true;
+            });
+        return count;
+    };
+
+    SECTION("Changes are written on scope exit")
+    {
+        {
+            Repository::IndexTransaction transaction{ repo };
+            repo.add_files({ "index_transaction/file0.txt" });
+            repo.add_files({ "index_transaction/file1.txt" });
+
+            // The in-memory index is visible to this repository, but not on disk
+            REQUIRE(repo.is_dirty() == true);
+            REQUIRE(count_staged_on_disk() == 0);
+        }
+        REQUIRE(count_staged_on_disk() == 2);
+    }
+
+    SECTION("Explicit commit() and commits within a transaction")
+    {
+        Repository::IndexTransaction transaction{ repo };
+        repo.add();
+        repo.commit("Add files in transaction");
+        repo.remove_files({ "index_transaction/file2.txt" });
+        transaction.commit();
+
+        REQUIRE(repo.get_last_commit_message() == "Add files in transaction");
+        REQUIRE(count_staged_on_disk() == 1); // the deletion of file2.txt
+
+        transaction.commit(); // no-op
+    }
+
+    SECTION("rollback() discards changes")
+    {
+        Repository::IndexTransaction transaction{ repo };
+        repo.add();
+        transaction.rollback();
+
+        REQUIRE(count_staged_on_disk() == 0);
+        REQUIRE(repo.status_list()[0].handling == FileHandling::untracked);
+    }
+
+    SECTION("An exception rolls back the outermost transaction")
+    {
+        try
+        {
+            Repository::IndexTransaction outer{ repo };
+            {
+                Repository::IndexTransaction inner{ repo };
+                repo.add();
+            }
+            REQUIRE(count_staged_on_disk() == 0); // only the outermost one writes
+            throw std::runtime_error("abort");
+        }
+        catch (const std::runtime_error&)
+        { }
+
+        REQUIRE(count_staged_on_disk() == 0);
+        REQUIRE(repo.is_dirty(StatusOptions{ }) == true); // untracked files are left
+    }
+}
+
+TEST_CASE("Repository: is_dirty()", "[Repository]")
+{
+    std::filesystem::remove_all(reporoot);
+    create_testfiles("is_dirty", 2, "committed");
+    Repository repo{ reporoot };
+    repo.add();
+    repo.commit("Add files");
+
+    REQUIRE(repo.is_dirty() == false);
+
+    // Ignored files never count
+    std::ofstream(reporoot / ".gitignore") << "*.ignored\n";
+    repo.add_files({ ".gitignore" });
+    repo.commit("Add .gitignore");
+    std::ofstream(reporoot / "file.ignored") << "ignored";
+    REQUIRE(repo.is_dirty() == false);
+
+    // Untracked files count unless excluded
+    create_testfiles("is_dirty_new", 1, "untracked");
+    REQUIRE(repo.is_dirty() == true);
+    StatusOptions opt;
+    opt.include_untracked = false;
+    REQUIRE(repo.is_dirty(opt) == false);
+
+    // Unstaged modifications
+    create_testfiles("is_dirty", 1, "modified");
+    REQUIRE(repo.is_dirty(opt) == true);
+
+    // Pathspecs restrict the check
+    opt.pathspecs = { "is_dirty/file1.txt" };
+    REQUIRE(repo.is_dirty(opt) == false);
+    opt.pathspecs = { "is_dirty/file0.txt" };
+    REQUIRE(repo.is_dirty(opt) == true);
+
+    // Staged modifications
+    repo.add_files({ "is_dirty/file0.txt" });
+    REQUIRE(repo.is_dirty(opt) == true);
+
+    repo.commit("Modify file0.txt");
+    REQUIRE(repo.is_dirty(opt) == false);
+}
+
+TEST_CASE("Repository: fetch()", "[Repository]")
+{
+    const auto upstream_dir = reporoot / "fetch_upstream";
+    const auto bare_dir = reporoot / "fetch_remote.git";
+    const auto downstream_dir = reporoot / "fetch_downstream";
+    std::filesystem::remove_all(upstream_dir);
+    std::filesystem::remove_all(bare_dir);
+    std::filesystem::remove_all(downstream_dir);
+
+    repository_init(bare_dir, true);
+    const auto url = "file://" + std::filesystem::absolute(bare_dir).string();
+
+    Repository upstream{ upstream_dir };
+    upstream.commit_files({ { "file.txt", "Version 1" } }, "Version 1");
+    auto upstream_remote = upstream.add_remote("origin", url);
+    upstream.push(upstream_remote);
+
+    Repository repo{ downstream_dir };
+    auto remote = repo.add_remote("origin", url);
+
+    SECTION("Full fetch with progress")
+    {
+        int nr_progress_calls = 0;
+        FetchOptions opt;
+        opt.on_progress = [&nr_progress_calls](const TransferProgress& p) {
+            ++nr_progress_calls;
+            REQUIRE(p.received_objects <= p.total_objects);
+            return true;
+        };
+
+        auto result = repo.fetch(remote, { }, opt);
+        REQUIRE(nr_progress_calls > 0);
+        REQUIRE(not result.up_to_date);
+        REQUIRE(result.remote_references.find("refs/heads/main").has_value());
+
+        auto upstream_head = get_commit_id(upstream, "HEAD");
+        auto fetched = get_commit_id(repo, "refs/remotes/origin/main");
+        REQUIRE(git_oid_equal(&fetched, &upstream_head));
+
+        REQUIRE(result.updated_refs.size() >= 1);
+        auto it = std::find_if(result.updated_refs.begin(), result.updated_refs.end(),
+            [](const RefUpdate& u) { return u.name == "refs/remotes/origin/main"; });
+        REQUIRE(it != result.updated_refs.end());
+        REQUIRE(git_oid_equal(&it->new_id, &upstream_head));
+    }
+
+    SECTION("Explicit refspec")
+    {
+        repo.fetch(remote, { "+refs/heads/main:refs/heads/mirrored" });
+        auto upstream_head = get_commit_id(upstream, "HEAD");
+        auto fetched = get_commit_id(repo, "refs/heads/mirrored");
+        REQUIRE(git_oid_equal(&fetched, &upstream_head));
+    }
+
+    SECTION("Only changed references")
+    {
+        auto first = repo.fetch(remote);
+
+        FetchOptions opt;
+        opt.only_changed_since = &first.remote_references;
+        auto second = repo.fetch(remote, { }, opt);
+        REQUIRE(second.up_to_date);
+        REQUIRE(second.updated_refs.empty());
+
+        upstream.commit_files({ { "file.txt", "Version 2" } }, "Version 2");
+        upstream.push(upstream_remote);
+
+        auto third = repo.fetch(remote, { }, opt);
+        REQUIRE(not third.up_to_date);
+        REQUIRE(third.updated_refs.size() == 1);
+        REQUIRE(third.updated_refs[0].name == "refs/remotes/origin/main");
+
+        auto upstream_head = get_commit_id(upstream, "HEAD");
+        auto fetched = get_commit_id(repo, "refs/remotes/origin/main");
+        REQUIRE(git_oid_equal(&fetched, &upstream_head));
+    }
+
+    SECTION("Prune")
+    {
+        upstream.push(upstream_remote, "HEAD:refs/heads/feature");
+        repo.fetch(remote);
+        get_commit_id(repo, "refs/remotes/origin/feature");
+
+        upstream.push(upstream_remote, ":refs/heads/feature");
+
+        repo.fetch(remote);
+        get_commit_id(repo, "refs/remotes/origin/feature"); // not pruned by default
+
+        FetchOptions opt;
+        opt.prune = true;
+        repo.fetch(remote, { }, opt);
+
+        git_oid id;
+        REQUIRE(git_reference_name_to_id(&id, repo.get_repo(), "refs/remotes/origin/feature")
+            == GIT_ENOTFOUND);
+    }
+
+    SECTION("Cancellation")
+    {
+        FetchOptions opt;
+        opt.on_progress = [](const TransferProgress&) { return false; };
+
+        try
+        {
+            repo.fetch(remote, { }, opt);
+            FAIL("Fetch was not cancelled");
+        }
+        catch (const Error& e)
+        {
+            REQUIRE(e.code().value() == GIT_EUSER);
+        }
+    }
+}
+
+TEST_CASE("Repository: push_to_remotes() and fetch_from_remotes()", "[Repository]")
+{
+    const auto local_dir = reporoot / "multi_remote";
+    std::filesystem::remove_all(local_dir);
+
+    Repository repo{ local_dir };
+    repo.commit_files({ { "file.txt", "content" } }, "Add file.txt");
+    const auto head = get_commit_id(repo, "HEAD");
+
+    std::vector<std::string> names;
+    for (int i = 0; i != 3; ++i)
+    {
+        const auto name = cat("mirror", i);
+        const auto dir = reporoot / cat("multi_remote_", name, ".git");
+        std::filesystem::remove_all(dir);
+        repository_init(dir, true);
+        repo.add_remote(name, "file://" + std::filesystem::absolute(dir).string());
+        names.push_back(name);
+    }
+
+    auto with_unknown = names;
+    with_unknown.push_back("no_such_remote");
+
+    auto results = repo.push_to_remotes(with_unknown, { "HEAD:refs/heads/main" }, 2);
+    REQUIRE(results.size() == 4);
+    for (std::size_t i = 0; i != names.size(); ++i)
+    {
+        INFO(results[i].error_message);
+        REQUIRE(results[i].remote_name == names[i]);
+        REQUIRE(results[i].ok);
+        REQUIRE(not results[i].error);
+        REQUIRE(results[i].duration.count() > 0);
+
+        auto remote = repo.get_remote(names[i]);
+        REQUIRE(remote.has_value());
+        auto main = remote->list_references().find("refs/heads/main");
+        REQUIRE(main.has_value());
+        REQUIRE(git_oid_equal(&main->id, &head));
+    }
+    REQUIRE(results[3].remote_name == "no_such_remote");
+    REQUIRE(not results[3].ok);
+    REQUIRE(results[3].error);
+    REQUIRE(not results[3].error_message.empty());
+
+    results = repo.fetch_from_remotes(names);
+    REQUIRE(results.size() == 3);
+    for (std::size_t i = 0; i != names.size(); ++i)
+    {
+        INFO(results[i].error_message);
+        REQUIRE(results[i].ok);
+        REQUIRE(results[i].fetch.remote_references.find("refs/heads/main").has_value());
+
+        auto fetched = get_commit_id(repo, cat("refs/remotes/", names[i], "/main"));
+        REQUIRE(git_oid_equal(&fetched, &head));
+    }
+}
+
+TEST_CASE("Repository: push_async() and fetch_async()", "[Repository]")
+{
+    const auto local_dir = reporoot / "async_remote";
+    const auto remote_dir = reporoot / "async_remote.git";
+    std::filesystem::remove_all(local_dir);
+    std::filesystem::remove_all(remote_dir);
+
+    Repository repo{ local_dir };
+    repository_init(remote_dir, true);
+    repo.add_remote("origin", "file://" + std::filesystem::absolute(remote_dir).string());
+    repo.commit_files({ { "file.txt", "content" } }, "Add file.txt");
+    const auto head = get_commit_id(repo, "HEAD");
+
+    SECTION("Push and fetch in the background")
+    {
+        auto pushed = repo.push_async("origin");
+        // The repository object stays usable while the push is running
+        REQUIRE(repo.get_last_commit_message() == "Add file.txt");
+        REQUIRE_NOTHROW(pushed.get());
+
+        auto fetched = repo.fetch_async("origin");
+        auto result = fetched.get();
+        REQUIRE(result.remote_references.find("refs/heads/main").has_value());
+
+        auto id = get_commit_id(repo, "refs/remotes/origin/main");
+        REQUIRE(git_oid_equal(&id, &head));
+    }
+
+    SECTION("Cancelled operations")
+    {
+        CancellationToken token;
+        token.cancel();
+
+        auto pushed = repo.push_async("origin", { "HEAD:refs/heads/main" }, token);
+        try
+        {
+            pushed.get();
+            FAIL("push_async() did not throw");
+        }
+        catch (const Error& e)
+        {
+            REQUIRE(e.code().value() == GIT_EUSER);
+        }
+
+        auto fetched = repo.fetch_async("origin", { }, FetchOptions{ }, token);
+        REQUIRE_THROWS_AS(fetched.get(), Error);
+    }
+
+    SECTION("Unknown remote")
+    {
+        auto pushed = repo.push_async("no_such_remote");
+        REQUIRE_THROWS_AS(pushed.get(), Error);
+    }
+}
+
+TEST_CASE("Repository: Move construction and assignment", "[Repository]")
+{
+    static_assert(sizeof(LibGitRepository) == sizeof(git_repository*),
+        "libgit2 handles must not store a deleter");
+    static_assert(std::is_nothrow_move_constructible<Repository>::value, "");
+    static_assert(std::is_nothrow_move_assignable<Repository>::value, "");
+
+    const auto path_a = unit_test_folder() / "Repository_move_a";
+    const auto path_b = unit_test_folder() / "Repository_move_b";
+    std::filesystem::remove_all(path_a);
+    std::filesystem::remove_all(path_b);
+
+    Repository repo{ path_a };
+    repo.commit_files({ { "a.txt", "a"s } }, "Commit in A");
+    auto* raw = repo.get_repo();
+
+    std::vector<Repository> repos;
+    {
+        // Remotes and blobs obtained before the move stay valid
+        auto remote = repo.add_remote("origin", "file:///does/not/matter");
+        auto blob = repo.read_blob("HEAD", "a.txt");
+
+        repos.push_back(std::move(repo));
+        repos.push_back(Repository{ path_b });
+        REQUIRE(repos[0].get_repo() == raw);
+        REQUIRE(repos[0].get_path() == path_a);
+        REQUIRE(repos[0].get_last_commit_message() == "Commit in A");
+        REQUIRE(repos[0].get_remote("origin").has_value());
+        REQUIRE(remote.get_name() == "origin");
+        REQUIRE(blob.data() == "a");
+    }
+
+    // The moved object keeps working
+    repos[0].commit_files({ { "b.txt", "b"s } }, "Second commit in A");
+    REQUIRE(repos[0].get_last_commit_message() == "Second commit in A");
+
+    // Move assignment releases the previous repository
+    repos[1].commit_files({ { "c.txt", "c"s } }, "Commit in B");
+    repos[0] = std::move(repos[1]);
+    REQUIRE(repos[0].get_path() == path_b);
+    REQUIRE(repos[0].get_last_commit_message() == "Commit in B");
+    REQUIRE(repos[0].read_blob("HEAD", "c.txt").data() == "c");
+}
+
+TEST_CASE("Repository: open_existing()", "[Repository]")
+{
+    std::filesystem::remove_all(reporoot);
+
+    SECTION("Missing repository")
+    {
+        try
+        {
+            Repository::open_existing(reporoot);
+            FAIL("open_existing() did not throw");
+        }
+        catch (const Error& e)
+        {
+            REQUIRE(e.code().value() == GIT_ENOTFOUND);
+        }
+        REQUIRE(not std::filesystem::exists(reporoot));
+    }
+
+    SECTION("Work tree")
+    {
+        {
+            Repository repo{ reporoot };
+            repo.commit_files({ { "file.txt", "content"s } }, "Add file.txt");
+        }
+        std::filesystem::create_directories(reporoot / "subdir");
+
+        auto repo = Repository::open_existing(reporoot);
+        REQUIRE(std::filesystem::equivalent(repo.get_path(), reporoot));
+        REQUIRE(repo.get_last_commit_message() == "Add file.txt");
+
+        // The signature is loaded on demand
+        repo.commit_files({ { "file.txt", "new content"s } }, "Modify file.txt");
+        REQUIRE(repo.get_last_commit_message() == "Modify file.txt");
+
+        REQUIRE_THROWS_AS(Repository::open_existing(reporoot / "subdir"), Error);
+
+        OpenOptions opt;
+        opt.search_parents = true;
+        auto found = Repository::open_existing(reporoot / "subdir", opt);
+        REQUIRE(std::filesystem::equivalent(found.get_path(), reporoot));
+        REQUIRE(found.get_last_commit_message() == "Modify file.txt");
+    }
+
+    SECTION("Bare repository")
+    {
+        repository_init(reporoot, true);
+
+        auto repo = Repository::open_existing(reporoot);
+        REQUIRE(git_repository_is_bare(repo.get_repo()) == 1);
+        REQUIRE(std::filesystem::equivalent(repo.get_path(), reporoot));
+        REQUIRE(git_repository_head_unborn(repo.get_repo()) == 1);
+    }
+}
+
+TEST_CASE("Repository: clone()", "[Repository]")
+{
+    const auto source_dir = reporoot / "clone_source";
+    const auto clone_dir = reporoot / "clone_target";
+    std::filesystem::remove_all(source_dir);
+    std::filesystem::remove_all(clone_dir);
+
+    Repository source{ source_dir };
+    source.commit_files({ { "file.txt", "content" } }, "Add file.txt");
+    source.new_branch("feature");
+    source.switch_branch("feature");
+    source.commit_files({ { "feature.txt", "feature" } }, "Add feature.txt");
+    source.switch_branch("main");
+
+    const auto source_url = "file://" + std::filesystem::absolute(source_dir).string();
+
+    SECTION("Full clone with progress")
+    {
+        int nr_calls = 0;
+        CloneOptions opt;
+        opt.on_progress = [&nr_calls](const TransferProgress&) { ++nr_calls; return true; };
+
+        auto repo = Repository::clone(source_url, clone_dir, opt);
+        REQUIRE(repo.get_path() == clone_dir);
+        REQUIRE(repo.get_last_commit_message() == "Add file.txt");
+        REQUIRE(std::filesystem::exists(clone_dir / "file.txt"));
+        REQUIRE(nr_calls > 0);
+
+        auto feature = get_commit_id(repo, "refs/remotes/origin/feature");
+        auto expected = get_commit_id(source, "refs/heads/feature");
+        REQUIRE(git_oid_equal(&feature, &expected));
+    }
+
+    SECTION("Single branch")
+    {
+        CloneOptions opt;
+        opt.branch = "feature";
+        opt.single_branch = true;
+
+        auto repo = Repository::clone(source_url, clone_dir, opt);
+        REQUIRE(repo.get_last_commit_message() == "Add feature.txt");
+        REQUIRE(std::filesystem::exists(clone_dir / "feature.txt"));
+
+        git_oid id;
+        REQUIRE(git_reference_name_to_id(&id, repo.get_repo(),
+            "refs/remotes/origin/feature") == 0);
+        REQUIRE(git_reference_name_to_id(&id, repo.get_repo(),
+            "refs/remotes/origin/main") != 0);
+    }
+
+    SECTION("Single branch uses the default branch of the remote")
+    {
+        CloneOptions opt;
+        opt.single_branch = true;
+
+        auto repo = Repository::clone(source_url, clone_dir, opt);
+        REQUIRE(repo.get_last_commit_message() == "Add file.txt");
+
+        git_oid id;
+        REQUIRE(git_reference_name_to_id(&id, repo.get_repo(),
+            "refs/remotes/origin/feature") != 0);
+    }
+
+    SECTION("Bare clone and clone without checkout")
+    {
+        CloneOptions opt;
+        opt.bare = true;
+        auto bare = Repository::clone(source_url, clone_dir, opt);
+        REQUIRE(git_repository_is_bare(bare.get_repo()) == 1);
+
+        const auto other_dir = reporoot / "clone_target_no_checkout";
+        std::filesystem::remove_all(other_dir);
+        opt.bare = false;
+        opt.checkout = false;
+        auto repo = Repository::clone(source_url, other_dir, opt);
+        REQUIRE(git_repository_is_bare(repo.get_repo()) == 0);
+        REQUIRE(not std::filesystem::exists(other_dir / "file.txt"));
+        REQUIRE(repo.get_last_commit_message() == "Add file.txt");
+    }
+
+    SECTION("Local clone with hardlinks")
+    {
+        CloneOptions opt;
+        opt.local = CloneLocal::hardlink;
+
+        auto repo = Repository::clone(source_url, clone_dir, opt);
+        REQUIRE(repo.get_last_commit_message() == "Add file.txt");
+
+        // At least one loose object is shared with the source repository
+        bool found_link = false;
+        for (const auto& entry :
+            std::filesystem::recursive_directory_iterator(clone_dir / ".git" / "objects"))
+        {
+            if (entry.is_regular_file() && std::filesystem::hard_link_count(entry) > 1)
+            {
+                found_link = true;
+                break;
+            }
+        }
+        REQUIRE(found_link);
+    }
+
+    SECTION("Cancelled clone")
+    {
+        CloneOptions opt;
+        opt.on_progress = [](const TransferProgress&) { return false; };
+        try
+        {
+            Repository::clone(source_url, clone_dir, opt);
+            FAIL("clone() did not throw");
+        }
+        catch (const Error& e)
+        {
+            REQUIRE(e.code().value() == GIT_EUSER);
+        }
+    }
+
+    SECTION("Invalid source")
+    {
+        REQUIRE_THROWS_AS(Repository::clone((reporoot / "no_such_repo").string(), clone_dir),
+            Error);
+    }
+}
+
 /**
  * To test a remote repository, the following steps are executed
  * 1) Create a Repository with a link to a remote repository
@@ -931,8 +2372,7 @@ TEST_CASE("Repository Wrapper Test Remote", "[GitWrapper]")
 
 
         //clone reposiotry from remote
-        Repository gl{ reporoot };
-        gl.clone_repo("https://gitlab.desy.de/jannik.woehnert/taskolib_remote_test.git", reporoot);
+        auto gl = Repository::clone("https://gitlab.desy.de/jannik.woehnert/taskolib_remote_test.git", reporoot);
 
         REQUIRE(gl.get_last_commit_message() == "Second commit");
     }
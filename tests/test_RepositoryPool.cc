@@ -0,0 +1,148 @@
+/**
+ * \file   test_RepositoryPool.cc
+ * \date   Created on October 14, 2026
+ * \brief  Test suite for the RepositoryPool class.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gul14/catch.h>
+
+#include "libgit4cpp/Error.h"
+#include "libgit4cpp/RepositoryPool.h"
+#include "test_main.h"
+
+using namespace git;
+using namespace std::literals;
+
+TEST_CASE("RepositoryPool: acquire()", "[RepositoryPool]")
+{
+    const auto path = unit_test_folder() / "RepositoryPool_acquire";
+    std::filesystem::remove_all(path);
+    {
+        Repository repo{ path };
+        repo.commit_files({ { "file.txt", "content"s } }, "Add file.txt");
+    }
+
+    RepositoryPool pool{ path, 2 };
+    REQUIRE(pool.get_path() == path);
+    REQUIRE(pool.open_count() == 0);
+
+    {
+        auto repo = pool.acquire();
+        REQUIRE(repo.get() != nullptr);
+        REQUIRE(repo->get_last_commit_message() == "Add file.txt");
+        REQUIRE(pool.open_count() == 1);
+        REQUIRE(pool.idle_count() == 0);
+    }
+    REQUIRE(pool.idle_count() == 1);
+
+    SECTION("Idle objects are reused")
+    {
+        auto repo = pool.acquire();
+        REQUIRE(pool.open_count() == 1);
+        REQUIRE(pool.idle_count() == 0);
+
+        // Moving a handle does not return the object to the pool
+        auto moved = std::move(repo);
+        REQUIRE(repo.get() == nullptr);
+        REQUIRE(pool.idle_count() == 0);
+        REQUIRE((*moved).get_last_commit_message() == "Add file.txt");
+    }
+
+    SECTION("At most max_idle objects are kept")
+    {
+        {
+            auto a = pool.acquire();
+            auto b = pool.acquire();
+            auto c = pool.acquire();
+            REQUIRE(pool.open_count() == 3);
+        }
+        REQUIRE(pool.idle_count() == 2);
+
+        pool.clear_idle();
+        REQUIRE(pool.idle_count() == 0);
+    }
+
+    SECTION("Changes are visible through all objects")
+    {
+        auto a = pool.acquire();
+        auto b = pool.acquire();
+        a->commit_files({ { "file.txt", "new content"s } }, "Modify file.txt");
+        REQUIRE(b->get_last_commit_message() == "Modify file.txt");
+    }
+}
+
+TEST_CASE("RepositoryPool: Missing repository", "[RepositoryPool]")
+{
+    const auto path = unit_test_folder() / "RepositoryPool_missing";
+    std::filesystem::remove_all(path);
+
+    RepositoryPool pool{ path };
+    REQUIRE_THROWS_AS(pool.acquire(), Error);
+    REQUIRE_THROWS_AS(pool.for_this_thread(), Error);
+    REQUIRE(not std::filesystem::exists(path));
+    REQUIRE(pool.open_count() == 0);
+}
+
+TEST_CASE("RepositoryPool: Concurrent use", "[RepositoryPool]")
+{
+    const auto path = unit_test_folder() / "RepositoryPool_threads";
+    std::filesystem::remove_all(path);
+    {
+        Repository repo{ path };
+        repo.commit_files({ { "file.txt", "content"s } }, "Add file.txt");
+    }
+
+    RepositoryPool pool{ path };
+    std::atomic<int> nr_ok{ 0 };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i != 4; ++i)
+    {
+        threads.emplace_back([&]() {
+            Repository& own = pool.for_this_thread();
+            if (&pool.for_this_thread() == &own
+                && own.get_last_commit_message() == "Add file.txt")
+            {
+                ++nr_ok;
+            }
+
+            for (int j = 0; j != 10; ++j)
+            {
+                auto repo = pool.acquire();
+                if (repo.get() != &own && repo->get_last_commit_message() == "Add file.txt")
+                    ++nr_ok;
+            }
+
+            pool.release_this_thread();
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    REQUIRE(nr_ok == 44);
+    REQUIRE(pool.open_count() >= 5);
+    REQUIRE(pool.open_count() <= 8);
+}
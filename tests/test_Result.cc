@@ -0,0 +1,117 @@
+/**
+ * \file   test_Result.cc
+ * \date   Created on October 14, 2026
+ * \brief  Test suite for the Result class template and the try_...() functions of Repository.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <filesystem>
+#include <string>
+
+#include <gul14/catch.h>
+
+#include "libgit4cpp/Error.h"
+#include "libgit4cpp/Repository.h"
+#include "libgit4cpp/Result.h"
+#include "test_main.h"
+
+using namespace git;
+using namespace std::literals;
+
+TEST_CASE("Result: Value and error", "[Result]")
+{
+    Result<std::string> ok{ "value"s };
+    REQUIRE(ok.has_value());
+    REQUIRE(static_cast<bool>(ok));
+    REQUIRE(not ok.error());
+    REQUIRE(ok.value() == "value");
+    REQUIRE(*ok == "value");
+    REQUIRE(ok->size() == 5);
+    REQUIRE(ok.value_or("default") == "value");
+
+    Result<std::string> failed{ GIT_ENOTFOUND };
+    REQUIRE(not failed.has_value());
+    REQUIRE(not failed);
+    REQUIRE(failed.error() == GIT_ENOTFOUND);
+    REQUIRE(failed.error().category() == git_category());
+    REQUIRE(failed.value_or("default") == "default");
+    REQUIRE_THROWS_AS(failed.value(), Error);
+
+    try
+    {
+        failed.value();
+        FAIL("No exception thrown");
+    }
+    catch (const Error& e)
+    {
+        REQUIRE(e.code() == GIT_ENOTFOUND);
+    }
+
+    Result<void> done;
+    REQUIRE(done.has_value());
+    REQUIRE_NOTHROW(done.value());
+
+    Result<void> not_done{ GIT_EEXISTS };
+    REQUIRE(not not_done);
+    REQUIRE(not_done.error() == GIT_EEXISTS);
+    REQUIRE_THROWS_AS(not_done.value(), Error);
+}
+
+TEST_CASE("Result: Repository::try_...()", "[Result]")
+{
+    const auto path = unit_test_folder() / "Result_try";
+    std::filesystem::remove_all(path);
+
+    Repository repo{ path };
+    repo.commit_files({ { "file.txt", "content"s } }, "Add file.txt");
+    repo.add_remote("origin", "file:///does/not/matter");
+
+    SECTION("try_resolve()")
+    {
+        auto head = repo.try_resolve("HEAD");
+        REQUIRE(head);
+        auto main = repo.try_resolve("refs/heads/main");
+        REQUIRE(main);
+        REQUIRE(git_oid_equal(&*head, &*main));
+
+        auto missing = repo.try_resolve("refs/heads/does_not_exist");
+        REQUIRE(missing.error() == GIT_ENOTFOUND);
+        REQUIRE(not repo.try_resolve("HEAD~5"));
+    }
+
+    SECTION("try_get_remote()")
+    {
+        auto origin = repo.try_get_remote("origin");
+        REQUIRE(origin);
+        REQUIRE(origin->get_name() == "origin");
+
+        REQUIRE(repo.try_get_remote("upstream").error() == GIT_ENOTFOUND);
+    }
+
+    SECTION("try_read_blob()")
+    {
+        auto content = repo.try_read_blob("HEAD", "file.txt");
+        REQUIRE(content);
+        REQUIRE(content->data() == "content");
+
+        REQUIRE(repo.try_read_blob("HEAD", "nope.txt").error() == GIT_ENOTFOUND);
+        REQUIRE(repo.try_read_blob("no_such_branch", "file.txt").error()
+            == GIT_ENOTFOUND);
+    }
+}
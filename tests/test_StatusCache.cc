@@ -0,0 +1,264 @@
+/**
+ * \file   test_StatusCache.cc
+ * \date   Created on October 14, 2026
+ * \brief  Test suite for the StatusCache class.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <gul14/catch.h>
+
+#include "libgit4cpp/Repository.h"
+#include "libgit4cpp/StatusCache.h"
+#include "test_main.h"
+
+using namespace git;
+using namespace std::literals;
+
+namespace {
+
+// Return a printable, path-sorted representation of a status list.
+std::string to_string(const StatusList& list)
+{
+    RepoState state = to_repo_state(list);
+    std::sort(state.begin(), state.end(),
+        [](const FileStatus& a, const FileStatus& b) { return a.path_name < b.path_name; });
+
+    std::ostringstream ss;
+    ss << state;
+    return ss.str();
+}
+
+// Create a repository with a few committed files in a fresh folder.
+std::filesystem::path make_repo(const std::string& name)
+{
+    const auto root = unit_test_folder() / name;
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "dir" / "sub");
+    std::ofstream(root / "top.txt") << "top";
+    std::ofstream(root / "dir" / "a.txt") << "a";
+    std::ofstream(root / "dir" / "sub" / "b.txt") << "b";
+    std::ofstream(root / ".gitignore") << "*.log\n";
+    return root;
+}
+
+} // anonymous namespace
+
+TEST_CASE("StatusCache: First call agrees with status_list()", "[StatusCache]")
+{
+    const auto root = make_repo("StatusCache_first");
+    Repository repo{ root };
+    repo.add();
+    repo.commit("Add files");
+    std::ofstream(root / "dir" / "a.txt") << "modified";
+
+    StatusCache cache{ repo };
+    REQUIRE(cache.get_full_scan_count() == 0);
+
+    const StatusList list = cache.status();
+    REQUIRE(to_string(list) == to_string(repo.status_list()));
+    REQUIRE(cache.get_full_scan_count() == 1);
+    REQUIRE(cache.get_incremental_update_count() == 0);
+
+    // Nothing has changed since
+    REQUIRE(to_string(cache.status()) == to_string(list));
+    if (cache.is_watching())
+        REQUIRE(cache.get_full_scan_count() == 1);
+}
+
+TEST_CASE("StatusCache: Incremental updates", "[StatusCache]")
+{
+    const auto root = make_repo("StatusCache_incremental");
+    Repository repo{ root };
+    repo.add();
+    repo.commit("Add files");
+
+    StatusOptions opt;
+    opt.include_unmodified = false;
+    opt.include_ignored = false;
+    StatusCache cache{ repo, opt };
+    REQUIRE(cache.status().empty());
+
+    SECTION("Modified file in a subdirectory")
+    {
+        std::ofstream(root / "dir" / "sub" / "b.txt") << "modified";
+    }
+
+    SECTION("Deleted file")
+    {
+        std::filesystem::remove(root / "dir" / "a.txt");
+    }
+
+    SECTION("New file and ignored file")
+    {
+        std::ofstream(root / "dir" / "new.txt") << "new";
+        std::ofstream(root / "dir" / "build.log") << "ignored";
+    }
+
+    SECTION("New directory with files")
+    {
+        std::filesystem::create_directories(root / "newdir" / "deeper");
+        std::ofstream(root / "newdir" / "c.txt") << "c";
+        std::ofstream(root / "newdir" / "deeper" / "d.txt") << "d";
+    }
+
+    const StatusList list = cache.status();
+    REQUIRE(not list.empty());
+    REQUIRE(to_string(list) == to_string(repo.status_list(opt)));
+
+    if (cache.is_watching())
+    {
+        REQUIRE(cache.get_full_scan_count() == 1);
+        REQUIRE(cache.get_incremental_update_count() == 1);
+
+        // Files in a directory created after the last call are watched as well
+        std::ofstream(root / "dir" / "sub" / "b.txt") << "changed again";
+        std::filesystem::create_directories(root / "newdir");
+        std::ofstream(root / "newdir" / "e.txt") << "e";
+        REQUIRE(to_string(cache.status()) == to_string(repo.status_list(opt)));
+        REQUIRE(cache.get_full_scan_count() == 1);
+    }
+}
+
+TEST_CASE("StatusCache: Tracked files in ignored directories", "[StatusCache]")
+{
+    const auto root = make_repo("StatusCache_ignored_dir");
+    std::filesystem::create_directories(root / "build" / "sub");
+    std::filesystem::create_directories(root / "out");
+    std::ofstream(root / ".gitignore") << "*.log\nbuild/\nout/\n";
+    std::ofstream(root / "build" / "sub" / "forced.txt") << "forced";
+
+    Repository repo{ root };
+    repo.add();
+    repo.add_files({ "build/sub/forced.txt" }); // like "git add -f"
+    repo.commit("Add files");
+
+    StatusOptions opt;
+    opt.include_unmodified = false;
+    opt.include_ignored = false;
+    StatusCache cache{ repo, opt };
+    REQUIRE(cache.status().empty());
+
+    SECTION("Modified file that was tracked before the cache was created")
+    {
+        std::ofstream(root / "build" / "sub" / "forced.txt") << "modified";
+        const StatusList list = cache.status();
+        REQUIRE(list.size() == 1);
+        REQUIRE(list[0].path == "build/sub/forced.txt");
+        REQUIRE(list[0].handling == FileHandling::unstaged);
+        REQUIRE(list[0].changes == FileChange::modified);
+    }
+
+    SECTION("File in a so far unwatched ignored directory that is added later")
+    {
+        std::ofstream(root / "out" / "late.txt") << "late";
+        repo.add_files({ "out/late.txt" });
+        repo.commit("Add late.txt");
+        REQUIRE(cache.status().empty());
+
+        std::ofstream(root / "out" / "late.txt") << "modified";
+        const StatusList list = cache.status();
+        REQUIRE(list.size() == 1);
+        REQUIRE(list[0].path == "out/late.txt");
+        REQUIRE(list[0].changes == FileChange::modified);
+    }
+
+    SECTION("File that is added to the index by another process")
+    {
+        std::ofstream(root / "out" / "other.txt") << "other";
+        {
+            Repository other{ root };
+            other.add_files({ "out/other.txt" });
+            other.commit("Add other.txt");
+        }
+        REQUIRE(cache.status().empty());
+
+        std::ofstream(root / "out" / "other.txt") << "modified";
+        const StatusList list = cache.status();
+        REQUIRE(list.size() == 1);
+        REQUIRE(list[0].path == "out/other.txt");
+        REQUIRE(list[0].changes == FileChange::modified);
+    }
+}
+
+TEST_CASE("StatusCache: Full scans", "[StatusCache]")
+{
+    const auto root = make_repo("StatusCache_full");
+    Repository repo{ root };
+    repo.add();
+    repo.commit("Add files");
+
+    StatusOptions opt;
+    opt.include_unmodified = false;
+    StatusCache cache{ repo, opt };
+    cache.status();
+    REQUIRE(cache.get_full_scan_count() == 1);
+
+    SECTION("Commit changes HEAD and the index")
+    {
+        std::ofstream(root / "top.txt") << "modified";
+        repo.add();
+        repo.commit("Modify top.txt");
+        REQUIRE(cache.status().empty());
+        REQUIRE(cache.get_full_scan_count() == 2);
+    }
+
+    SECTION("Changed .gitignore")
+    {
+        std::ofstream(root / "dir" / "x.txt") << "x";
+        std::ofstream(root / ".gitignore") << "*.txt\n";
+        REQUIRE(to_string(cache.status()) == to_string(repo.status_list(opt)));
+        REQUIRE(cache.get_full_scan_count() == 2);
+    }
+
+    SECTION("Renamed directory")
+    {
+        std::filesystem::rename(root / "dir", root / "renamed");
+        REQUIRE(to_string(cache.status()) == to_string(repo.status_list(opt)));
+        REQUIRE(cache.get_full_scan_count() == 2);
+
+        // The watches have been set up again for the new name
+        std::ofstream(root / "renamed" / "sub" / "b.txt") << "modified";
+        REQUIRE(to_string(cache.status()) == to_string(repo.status_list(opt)));
+    }
+
+    SECTION("invalidate()")
+    {
+        cache.invalidate();
+        cache.status();
+        REQUIRE(cache.get_full_scan_count() == 2);
+    }
+
+    SECTION("detect_renames scans on every call")
+    {
+        opt.detect_renames = true;
+        StatusCache renames{ repo, opt };
+        REQUIRE(renames.is_watching() == false);
+        renames.status();
+        renames.status();
+        REQUIRE(renames.get_full_scan_count() == 2);
+    }
+}
+
+// vi:ts=4:sw=4:sts=4:et
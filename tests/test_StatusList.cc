@@ -0,0 +1,168 @@
+/**
+ * \file   test_StatusList.cc
+ * \date   Created on October 14, 2026
+ * \brief  Test suite for the StatusList class.
+ *
+ * \copyright Copyright 2026 Deutsches Elektronen-Synchrotron (DESY), Hamburg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 2.1 of the license, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include <gul14/catch.h>
+#include <gul14/gul.h>
+
+#include "libgit4cpp/Repository.h"
+#include "libgit4cpp/StatusList.h"
+#include "test_main.h"
+
+using namespace git;
+using namespace std::literals;
+
+TEST_CASE("StatusList: Default constructor", "[StatusList]")
+{
+    StatusList list;
+    REQUIRE(list.empty());
+    REQUIRE(list.size() == 0);
+    REQUIRE(list.begin() == list.end());
+}
+
+TEST_CASE("StatusList: push_back() and element access", "[StatusList]")
+{
+    StatusList list;
+
+    {
+        // The list must copy the paths into its own pool
+        std::string a = "a.txt";
+        std::string b = "dir/b.txt";
+
+        list.push_back(FileStatusView{ a, { }, FileHandling::staged, FileChange::new_file });
+        list.push_back(FileStatusView{ b, a, FileHandling::unstaged, FileChange::renamed });
+        a = "xxxxx";
+        b = "xxxxxxxxx";
+    }
+
+    REQUIRE(list.size() == 2);
+
+    REQUIRE(list[0].path == "a.txt");
+    REQUIRE(list[0].old_path.empty());
+    REQUIRE(list[0].is_renamed() == false);
+    REQUIRE(list[0].handling == FileHandling::staged);
+    REQUIRE(list[0].changes == FileChange::new_file);
+
+    REQUIRE(list[1].path == "dir/b.txt");
+    REQUIRE(list[1].old_path == "a.txt");
+    REQUIRE(list[1].is_renamed() == true);
+    REQUIRE(list[1].handling == FileHandling::unstaged);
+    REQUIRE(list[1].changes == FileChange::renamed);
+
+    std::size_t count = 0;
+    for (const FileStatusView& view : list)
+    {
+        REQUIRE(view.path == list[count].path);
+        ++count;
+    }
+    REQUIRE(count == 2);
+
+    // Copies must carry their own pool
+    StatusList copy = list;
+    list = StatusList{ };
+    REQUIRE(copy[1].path == "dir/b.txt");
+    REQUIRE(copy[1].old_path == "a.txt");
+}
+
+TEST_CASE("StatusList: to_file_status(), to_repo_state()", "[StatusList]")
+{
+    StatusList list;
+    list.push_back(FileStatusView{ "new.txt", "old.txt", FileHandling::staged,
+        FileChange::renamed });
+    list.push_back(FileStatusView{ "f.txt", { }, FileHandling::untracked,
+        FileChange::untracked });
+
+    auto status = to_file_status(list[0]);
+    REQUIRE(status.path_name == "old.txt -> new.txt");
+    REQUIRE(status.handling == "staged");
+    REQUIRE(status.changes == "renamed");
+
+    auto state = to_repo_state(list);
+    REQUIRE(state.size() == 2);
+    REQUIRE(state[1].path_name == "f.txt");
+    REQUIRE(state[1].handling == "untracked");
+    REQUIRE(state[1].changes == "untracked");
+
+    std::stringstream ss;
+    ss << list[0];
+    REQUIRE(ss.str() == "FileStatus{ \"old.txt -> new.txt\": staged; renamed }");
+}
+
+TEST_CASE("StatusList: Repository::status_list()", "[StatusList]")
+{
+    const auto root = unit_test_folder() / "StatusList";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root / "dir");
+    std::ofstream(root / "dir" / "committed.txt") << "committed";
+    std::ofstream(root / "dir" / "deleted.txt") << "deleted";
+
+    Repository repo{ root };
+    repo.add();
+    repo.commit("Add committed.txt and deleted.txt");
+
+    std::ofstream(root / "dir" / "committed.txt") << "modified";
+    std::filesystem::remove(root / "dir" / "deleted.txt");
+    std::ofstream(root / "untracked.txt") << "untracked";
+    std::ofstream(root / "staged.txt") << "staged";
+    repo.add_files({ "staged.txt" });
+
+    const StatusList list = repo.status_list();
+    REQUIRE(list.size() == 4);
+
+    REQUIRE(list[0].path == "dir/committed.txt");
+    REQUIRE(list[0].handling == FileHandling::unstaged);
+    REQUIRE(list[0].changes == FileChange::modified);
+
+    REQUIRE(list[1].path == "dir/deleted.txt");
+    REQUIRE(list[1].handling == FileHandling::unstaged);
+    REQUIRE(list[1].changes == FileChange::deleted);
+
+    REQUIRE(list[2].path == "staged.txt");
+    REQUIRE(list[2].handling == FileHandling::staged);
+    REQUIRE(list[2].changes == FileChange::new_file);
+
+    REQUIRE(list[3].path == "untracked.txt");
+    REQUIRE(list[3].handling == FileHandling::untracked);
+    REQUIRE(list[3].changes == FileChange::untracked);
+
+    for (const FileStatusView& entry : list)
+        REQUIRE(entry.is_renamed() == false);
+
+    // Committing everything leaves only unchanged files
+    repo.remove_files({ "dir/deleted.txt" });
+    repo.add();
+    repo.commit("Commit all changes");
+
+    std::stringstream ss;
+    ss << to_repo_state(repo.status_list());
+    REQUIRE(gul14::trim(ss.str()) == "RepoState {\n"
+        "FileStatus{ \"dir/committed.txt\": unchanged; unchanged }\n"
+        "FileStatus{ \"staged.txt\": unchanged; unchanged }\n"
+        "FileStatus{ \"untracked.txt\": unchanged; unchanged }\n"
+        "}");
+}
+
+// vi:ts=4:sw=4:sts=4:et